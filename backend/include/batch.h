@@ -0,0 +1,82 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+#include "simulator.h"
+#include "run_pool.h"
+#include <stdio.h>
+
+#define BATCH_MAX_WORKERS RUN_POOL_MAX_WORKERS // Procesos que simulan en paralelo
+#define BATCH_PATH_LEN 512
+
+/**
+ * Estado de una corrida de la matriz
+ */
+typedef enum
+{
+  BATCH_OK,
+  BATCH_EMPTY,     // La carga no tiene procesos
+  BATCH_INVALID,   // La carga tiene ráfagas no positivas (no se simula)
+  BATCH_BAD_CONFIG, // La configuración no es JSON o su algoritmo no existe
+  BATCH_UNSUPPORTED // El algoritmo no admite la carga (LOTTERY o STRIDE con ráfagas de I/O)
+} BatchStatus;
+
+/**
+ * Métricas de una corrida (carga × configuración)
+ */
+typedef struct
+{
+  BatchStatus status;
+  int processes;
+  RunMetrics run;
+  double throughput;     // Procesos terminados por ciclo
+  double cpuUtilization; // Ciclos con la CPU ocupada (incluidos los cambios de contexto) / cycles
+  double shareError; // LOTTERY y STRIDE: fracción de la CPU que no fue a quien le correspondía
+} BatchMetrics;
+
+/**
+ * Configuración de la matriz: una línea JSON con el mismo formato que la configuración de una sesión
+ */
+typedef struct
+{
+  char name[64]; // Campo "name" o el número de la configuración (desde 1)
+  char *line;
+  SimulationConfig config;
+  int valid;
+} BatchConfig;
+
+/**
+ * Busca las cargas de trabajo de la matriz, ordenadas por ruta. `spec` puede ser:
+ *  - un patrón glob ("../data/test/procesos_*.txt"): cada archivo o directorio que coincide;
+ *  - un directorio: sus archivos *.txt y sus subdirectorios con procesos.txt.
+ * Un archivo se lee con el formato de procesos.txt; un directorio, como el directorio de entrada.
+ *
+ * @param paths Arreglo de rutas (liberar con free).
+ * @return Número de cargas, o -1 si `spec` no existe.
+ */
+int findBatchWorkloads(const char *spec, char (**paths)[BATCH_PATH_LEN]);
+
+/**
+ * Lee las configuraciones: un archivo con una configuración JSON por línea o un arreglo JSON, o el
+ * mismo texto directamente en `spec` si empieza con '{' o '['.
+ *
+ * @param configs Arreglo de configuraciones (liberar con freeBatchConfigs).
+ * @return Número de configuraciones, o -1 si no se pudo leer.
+ */
+int loadBatchConfigs(const char *spec, BatchConfig **configs);
+void freeBatchConfigs(BatchConfig *configs, int count);
+
+/**
+ * Simula la matriz completa (cada carga con cada configuración) sin salida ni retardo, repartiendo
+ * las corridas entre `workers` procesos hijos. `results` tiene workloadCount × configCount
+ * elementos, ordenados por carga y luego por configuración.
+ */
+void runBatch(char (*paths)[BATCH_PATH_LEN], int workloadCount,
+              const BatchConfig *configs, int configCount, int workers, BatchMetrics *results);
+
+// Escribe los resultados como CSV (con encabezado) o como arreglo JSON
+void writeBatchCsv(FILE *out, char (*paths)[BATCH_PATH_LEN], int workloadCount,
+                   const BatchConfig *configs, int configCount, const BatchMetrics *results);
+void writeBatchJson(FILE *out, char (*paths)[BATCH_PATH_LEN], int workloadCount,
+                    const BatchConfig *configs, int configCount, const BatchMetrics *results);
+
+#endif
@@ -0,0 +1,90 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include "simulator.h"
+#include <stddef.h>
+
+#define DEFAULT_CHECKPOINT_INTERVAL 1000
+#define DEFAULT_CHECKPOINT_DIR "../data/output/checkpoints"
+#define CHECKPOINT_KEY_SEED 14695981039346656037ULL
+
+/**
+ * Región de memoria que forma parte del estado de una simulación (variables del bucle principal,
+ * arreglos de control, procesos y recursos). Un snapshot es la concatenación de las regiones.
+ */
+typedef struct
+{
+  void *data;
+  size_t size;
+} CheckpointRegion;
+
+// Cantidad de regiones de un arreglo declarado con inicializador
+#define CHECKPOINT_REGION_COUNT(regions) ((int)(sizeof(regions) / sizeof((regions)[0])))
+
+// Regiones que un motor de calendarización puede agregar después de las suyas (reparto proporcional,
+// dependencias y modelo de cambios de contexto)
+#define CHECKPOINT_OPTIONAL_REGIONS 3
+
+/**
+ * Configura los snapshots de la próxima simulación.
+ *
+ * Los snapshots de una corrida se guardan en `<directory>/<key>.ckpt`, donde `key` identifica la
+ * carga de trabajo y la configuración que determinan el resultado. El archivo se escribe una sola
+ * vez: si ya existe completo, las corridas siguientes solo lo leen.
+ *
+ * @param interval  Ciclos entre snapshots (0: sin snapshots; con seek se usa el intervalo por defecto).
+ * @param seekCycle Ciclo desde el que se quiere la salida (0: desde el inicio). Con seek la salida
+ *                  queda silenciada hasta alcanzar ese ciclo.
+ * @param directory Directorio de los archivos de snapshots.
+ * @param key       Firma de la corrida (ver checkpointKey).
+ */
+void configureCheckpoints(int interval, int seekCycle, const char *directory, unsigned long long key);
+
+/**
+ * Configura la próxima simulación como variante (what-if) de la corrida `baseKey`, cuyo archivo de
+ * snapshots ya existe. La simulación parte del snapshot de esa corrida más cercano anterior (o igual)
+ * a `divergenceCycle`, con las diferencias del estado inicial aplicadas, y corre sin salida ni
+ * retardo. No escribe snapshots propios.
+ *
+ * @param divergenceCycle Primer ciclo en el que la variante puede diferir de la corrida base.
+ */
+void configureWhatIf(const char *directory, unsigned long long baseKey, int divergenceCycle);
+
+/**
+ * Lee los procesos finales (métricas) guardados al cerrar el archivo de snapshots de una corrida.
+ *
+ * @param finalCycle Ciclo final de la corrida (puede ser NULL).
+ * @return 0 si el archivo existe completo y corresponde a `processCount` procesos, -1 si no.
+ */
+int readCheckpointResult(const char *directory, unsigned long long key,
+                         Process *processes, int processCount, int *finalCycle);
+
+// Ciclo del snapshot restaurado y ciclo final de la última simulación (-1 si no corresponde)
+int checkpointRestoredCycle(void);
+int checkpointFinalCycle(void);
+
+// Agrega datos a la firma de una corrida (FNV-1a); la firma inicial es CHECKPOINT_KEY_SEED
+unsigned long long checkpointKey(unsigned long long key, const void *data, size_t size);
+
+/**
+ * Restaura el snapshot más cercano anterior (o igual) al ciclo de seek (o al ciclo de divergencia de
+ * un what-if). Se llama justo antes del bucle principal, con las regiones ya inicializadas; sin seek
+ * o sin snapshots no las modifica.
+ *
+ * @return Ciclo del snapshot restaurado, o -1 si la simulación parte desde el inicio.
+ */
+int restoreCheckpoint(const CheckpointRegion *regions, int regionCount);
+
+/**
+ * Punto de control al inicio de cada iteración del bucle principal (justo después de
+ * endSimulationCycle): guarda un snapshot cada `interval` ciclos y, al alcanzar el ciclo de seek,
+ * reactiva la salida y emite el evento SEEK con el estado de los procesos.
+ */
+void checkpointCycle(int cycle, const CheckpointRegion *regions, int regionCount,
+                     const Process *processes, int processCount);
+
+// Cierra el archivo de snapshots al terminar el bucle principal, en el ciclo final `cycle` (si el
+// seek pedía un ciclo posterior, reactiva la salida y emite SEEK con el estado final)
+void finishCheckpoints(int cycle);
+
+#endif
@@ -0,0 +1,32 @@
+#ifndef COMBINED_H
+#define COMBINED_H
+
+#include "simulator.h"
+
+/**
+ * Simula la planificación de CPU junto con la sincronización de recursos.
+ *
+ * Los procesos se planifican en la CPU con el algoritmo de `control` (FIFO, SJF, SRT, PS o RR)
+ * y solo el proceso en ejecución puede emitir sus acciones. Una acción se vuelve pendiente en su
+ * ciclo y se emite la próxima vez que el proceso obtiene la CPU. Si el recurso no está disponible,
+ * el proceso se bloquea y sale de la CPU hasta que el recurso se libere. Un proceso expropiado
+ * conserva los recursos que retiene.
+ *
+ * @param processes     Arreglo de procesos a simular.
+ * @param processCount  Número de procesos.
+ * @param resources     Arreglo de recursos.
+ * @param resourceCount Número de recursos.
+ * @param actions       Arreglo de acciones.
+ * @param actionCount   Número de acciones.
+ * @param events        Arreglo donde se registran los eventos simulados.
+ * @param eventCount    Puntero al contador de eventos registrados.
+ * @param control       Configuración de planificación (algoritmo, quantum, isPreemptive).
+ * @param config        Configuración de sincronización (mecanismo y protocolo de prioridad).
+ */
+void simulateCombined(Process *processes, int processCount,
+                      Resource *resources, int resourceCount,
+                      Action *actions, int actionCount,
+                      TimelineEvent *events, int *eventCount,
+                      SimulationControl *control, SyncConfig *config);
+
+#endif
@@ -0,0 +1,88 @@
+#ifndef DAG_H
+#define DAG_H
+
+#include "simulator.h"
+#include "checkpoint.h"
+#include <limits.h>
+
+/**
+ * Dependencias entre procesos (grafo acíclico de trabajos): un proceso con predecesores no está
+ * listo hasta que todos terminan. Se libera en el ciclo en que termina el último, o en su llegada si
+ * es posterior, y desde ese ciclo lo planifica el algoritmo como a cualquier proceso que llega.
+ *
+ * Al configurar se arma el grafo una sola vez: sucesores contiguos por proceso y la cantidad de
+ * predecesores de cada uno. Al terminar un proceso solo se recorren sus sucesores y se descuenta su
+ * contador; el que llega a cero se libera, sin volver a revisar la carga completa.
+ *
+ * Mientras un proceso está bloqueado su `arrivalTime` es DAG_BLOCKED, así que los algoritmos no lo
+ * ven llegar. Al liberarse pasa a ser el ciclo de liberación: PROCESS_METRIC informa ese ciclo y
+ * `waitingTime` cuenta desde él. El estado es global (una simulación a la vez) y se guarda en los
+ * snapshots con una región propia.
+ */
+
+#define DAG_BLOCKED INT_MAX // Llegada de un proceso cuyos predecesores no terminaron
+
+/**
+ * Parsea una línea de dependencias.txt: "PID, PRED1 PRED2 ..." (predecesores separados por espacios).
+ *
+ * @return 1 si la línea declara dependencias de un proceso de la carga, 0 si no.
+ */
+int parseDependencyLine(const char *line, const Process *processes, int processCount, PredecessorList *lists);
+
+/**
+ * Lee dependencias.txt. Sin el archivo los procesos quedan sin predecesores.
+ */
+void loadDependencies(const char *filename, const Process *processes, int processCount, PredecessorList *lists);
+
+/**
+ * Configura las dependencias de las próximas simulaciones de calendarización (NULL: ninguna). Los
+ * predecesores que no son procesos de la carga, los repetidos y los del propio proceso se descartan
+ * con un aviso por stderr.
+ *
+ * @return 0 si el grafo es acíclico, -1 si hay un ciclo (las dependencias quedan desactivadas).
+ */
+int configureDependencies(const PredecessorList *lists, const Process *processes, int processCount);
+
+// Indica si la carga configurada tiene dependencias
+int dependenciesActive(void);
+
+/**
+ * Reinicia las dependencias para una nueva simulación y bloquea los procesos con predecesores.
+ * Se llama antes de leer las llegadas.
+ *
+ * @return 1 si hay dependencias (hay que agregar su región a los snapshots), 0 si no.
+ */
+int beginDependencies(Process *processes, int processCount);
+
+// Región de snapshot con los predecesores pendientes de cada proceso
+CheckpointRegion dependencyRegion(void);
+
+/**
+ * Descuenta el proceso `processIdx`, que terminó en `cycle`, de sus sucesores y libera los que ya
+ * no tienen predecesores pendientes.
+ *
+ * @param arrivalColumn Columna de llegadas de la selección a actualizar (NULL si el algoritmo no usa).
+ */
+void releaseDependents(Process *processes, int processIdx, int cycle, int *arrivalColumn);
+
+// Agrega las dependencias configuradas a la clave de los snapshots
+unsigned long long dependencyKey(unsigned long long key);
+
+/**
+ * Camino crítico y cotas de la última simulación con dependencias
+ */
+typedef struct
+{
+  int criticalPath; // Ciclo más temprano en que puede terminar la cadena más larga (CPUs ilimitadas)
+  int cpuBound;     // Cota de una CPU: llegadas y ráfagas, sin dependencias
+  int lowerBound;   // Máximo de las dos cotas
+  int makespan;     // Ciclo en que terminó el último proceso
+} DependencyStats;
+
+/**
+ * Calcula el camino crítico con las llegadas originales y las ráfagas de CPU y emite DAG_METRIC con
+ * los pid del camino, las cotas y la distancia del makespan a la cota inferior.
+ */
+DependencyStats exportDependencyReport(const Process *processes, int processCount);
+
+#endif
@@ -0,0 +1,83 @@
+#ifndef IO_H
+#define IO_H
+
+#include "simulator.h"
+
+#define DEFAULT_IO_DEVICE "io" // Dispositivo de las ráfagas de I/O que no indican uno
+
+/**
+ * Agrega el dispositivo `name` si no existe (con cola FCFS).
+ *
+ * @return Índice del dispositivo, o -1 si ya hay MAX_DEVICES.
+ */
+int findOrAddDevice(Device *devices, int *deviceCount, const char *name);
+
+/**
+ * Agrega una ráfaga al final de la secuencia. Las ráfagas alternan CPU e I/O empezando por CPU.
+ *
+ * @param device Índice del dispositivo de una ráfaga de I/O, o -1 para una ráfaga de CPU.
+ * @return 1 si la ráfaga se agregó, 0 si rompe la alternancia, no cabe o su largo no es positivo.
+ */
+int addBurst(BurstSequence *sequence, int device, int length);
+
+/**
+ * Completa una secuencia recién armada sobre su proceso: si es válida (termina en CPU), el
+ * `burstTime` del proceso pasa a ser el total de CPU; si no, se descarta con un aviso por stderr y el
+ * proceso queda como una sola ráfaga de `burstTime`.
+ *
+ * @param valid 0 si alguna ráfaga no se pudo agregar.
+ */
+void finishBurstSequence(Process *process, BurstSequence *sequence, int valid);
+
+/**
+ * Parsea la secuencia de ráfagas del quinto campo de una línea de procesos.txt:
+ * "PID, BT, AT, PRIORIDAD, 3 disk:4 2 net:1 5" (números: CPU; DISPOSITIVO:N: I/O).
+ * Sin quinto campo la secuencia queda vacía.
+ */
+void parseBurstField(const char *line, Process *process, BurstSequence *sequence,
+                     Device *devices, int *deviceCount);
+
+/**
+ * Lee las secuencias de ráfagas de procesos.txt (las líneas válidas, en el mismo orden que
+ * loadProcesses).
+ */
+void loadBurstSequences(const char *filename, Process *processes, BurstSequence *sequences, int processCount,
+                        Device *devices, int *deviceCount);
+
+/**
+ * Configura la carga de I/O de las próximas simulaciones de calendarización. Los arreglos deben
+ * seguir vivos mientras se simula (no se copian).
+ */
+void configureIO(const BurstSequence *sequences, int processCount, const Device *devices, int deviceCount);
+
+// Indica si la carga configurada tiene ráfagas de I/O (las simulaciones usan simulateIO)
+int ioModelActive(void);
+
+/**
+ * Simula la calendarización de CPU con ráfagas de I/O: cada proceso alterna ráfagas de CPU y de I/O.
+ * Al terminar una ráfaga de CPU el proceso pasa a la cola de su dispositivo, que atiende una ráfaga
+ * a la vez (FCFS o por prioridad) en paralelo con la CPU, y al terminar la de I/O vuelve a la cola
+ * de listos. La CPU se reparte con el algoritmo de `control` (FIFO, SJF, SRT, PS o RR) sobre la
+ * ráfaga de CPU en curso; FIFO ordena por llegada a la cola de listos.
+ *
+ * Emite IO e IO_WAITING (con el dispositivo) además de los estados de la CPU, IO_METRIC por proceso
+ * y DEVICE_METRIC por dispositivo. `waitingTime` cuenta solo los ciclos en la cola de listos.
+ */
+void simulateIO(Process *processes, int processCount,
+                TimelineEvent *events, int *eventCount,
+                SimulationControl *control);
+
+/**
+ * Totales de la última simulación con I/O
+ */
+typedef struct
+{
+  int cycles;        // Ciclos simulados
+  int cpuBusyCycles; // Ciclos con la CPU ocupada (ejecución o cambio de contexto)
+  long ioWaitCycles; // Suma de ciclos en colas de dispositivos
+  int processCount;
+} IoStats;
+
+IoStats getIoStats(void);
+
+#endif
@@ -0,0 +1,20 @@
+#ifndef LOTTERY_H
+#define LOTTERY_H
+
+#include "simulator.h"
+
+/**
+ * Simula la planificación por sorteo (Lottery Scheduling): al empezar cada quantum se sortea la CPU
+ * entre los procesos listos en proporción a sus boletos.
+ *
+ * @param processes    Arreglo de procesos a simular.
+ * @param processCount Número de procesos en el arreglo.
+ * @param events       Arreglo donde se registran eventos simulados.
+ * @param eventCount   Puntero al contador de eventos registrados.
+ * @param control      Estructura con la configuración (quantum, boletos y semilla en `share`).
+ */
+void simulateLottery(Process *processes, int processCount,
+                     TimelineEvent *events, int *eventCount,
+                     SimulationControl *control);
+
+#endif
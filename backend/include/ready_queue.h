@@ -0,0 +1,23 @@
+#ifndef READY_QUEUE_H
+#define READY_QUEUE_H
+
+#include "simulator.h"
+
+/**
+ * Cola circular de procesos listos (RR). Cada proceso está a lo sumo una vez en la cola (el que
+ * ejecuta no está), así que MAX_PROCESSES posiciones alcanzan sin importar cuántas veces se reencole.
+ */
+typedef struct
+{
+  int items[MAX_PROCESSES];
+  int start;
+  int size;
+} ReadyQueue;
+
+// Agrega un proceso al final de la cola
+void enqueueReady(ReadyQueue *queue, int processIdx);
+
+// Saca el primer proceso de la cola (-1 si está vacía)
+int dequeueReady(ReadyQueue *queue);
+
+#endif
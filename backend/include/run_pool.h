@@ -0,0 +1,50 @@
+#ifndef RUN_POOL_H
+#define RUN_POOL_H
+
+#include "simulator.h"
+#include <stddef.h>
+
+#define RUN_POOL_MAX_WORKERS 64 // Procesos hijos de un reparto
+
+/**
+ * Métricas de una simulación terminada, comunes al batch-runner y a la búsqueda del quantum
+ */
+typedef struct
+{
+  int cycles; // Ciclo en que terminó el último proceso
+  double waiting;
+  double turnaround;
+  double response; // Primer despacho - llegada
+  double p99Response;
+  int switches;
+  int overheadCycles; // Ciclos de cambio de contexto
+  double switchOverhead;
+} RunMetrics;
+
+/**
+ * Calcula las métricas de los procesos de una simulación que ya terminó. Los cambios de contexto
+ * solo cuentan si `config` los cobra.
+ */
+void measureRun(const Process *processes, int processCount, const SimulationConfig *config, RunMetrics *metrics);
+
+// Comparador ascendente de enteros para qsort
+int compareInt(const void *a, const void *b);
+
+/**
+ * Corrida `index` de un reparto: simula y llena completo su resultado en `result` (`resultSize` bytes).
+ * En un hijo `result` es un registro del pipe; en este proceso, el elemento `index` de `results`.
+ */
+typedef void (*RunJob)(int index, void *result, void *context);
+
+/**
+ * Ejecuta `count` corridas repartidas entre `workers` procesos hijos, sin salida ni retardo. Cada
+ * hijo simula los índices w, w + workers, ... y devuelve cada resultado por su pipe apenas termina;
+ * los pipes se leen todos a la vez para que ningún hijo quede bloqueado con el suyo lleno. Lo que un
+ * hijo no llegó a entregar (o no se pudo lanzar) se simula en este proceso, igual que todo con un
+ * solo worker.
+ *
+ * @param results Arreglo de `count` resultados de `resultSize` bytes cada uno.
+ */
+void runWorkerPool(int count, int workers, size_t resultSize, void *results, RunJob job, void *context);
+
+#endif
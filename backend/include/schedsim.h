@@ -0,0 +1,170 @@
+#ifndef SCHEDSIM_H
+#define SCHEDSIM_H
+
+/**
+ * API en C de libschedsim: ejecuta los motores de calendarización y sincronización dentro de otro
+ * proceso (C, ctypes/cffi), sin lanzar los binarios ni pasar por stdin/stdout.
+ *
+ * La carga de trabajo y la configuración se pasan como estructuras en memoria. Los eventos de la
+ * simulación son las mismas líneas JSON que describe el protocolo de los binarios (eventos, frames
+ * por ciclo, métricas y SIMULATION_END), sin las líneas de texto informativas.
+ *
+ * Este encabezado no depende de los encabezados internos del simulador: las estructuras públicas
+ * solo crecen al final y cambian SCHEDSIM_API_VERSION si se modifican.
+ *
+ * Solo puede haber una simulación en curso a la vez por proceso (los motores comparten estado de
+ * salida); una simulación deja de estar en curso al terminar o al destruirse.
+ */
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define SCHEDSIM_API_VERSION 1
+#define SCHEDSIM_NAME_LEN 10
+
+// Funciones exportadas por libschedsim.so (el resto de los símbolos se compila oculto)
+#if defined(__GNUC__)
+#define SCHEDSIM_EXPORT __attribute__((visibility("default")))
+#else
+#define SCHEDSIM_EXPORT
+#endif
+
+  typedef struct SchedSim SchedSim;
+
+  typedef enum
+  {
+    SCHEDSIM_SCHEDULING,     // Calendarización de CPU
+    SCHEDSIM_SYNCHRONIZATION // Sincronización (combinada si se indica un algoritmo de CPU)
+  } SchedSimMode;
+
+  // Estados de un proceso en los resultados (mismos valores que los eventos JSON)
+  typedef enum
+  {
+    SCHEDSIM_STATE_NEW,
+    SCHEDSIM_STATE_WAITING,
+    SCHEDSIM_STATE_ACCESSED,
+    SCHEDSIM_STATE_TERMINATED,
+    SCHEDSIM_STATE_OMITED
+  } SchedSimState;
+
+  typedef enum
+  {
+    SCHEDSIM_READ,
+    SCHEDSIM_WRITE
+  } SchedSimActionType;
+
+  /**
+   * Configuración de una simulación (ver schedsimDefaultConfig para los valores por defecto).
+   * Los nombres son los mismos de la configuración JSON de los binarios.
+   */
+  typedef struct
+  {
+    int mode;              // SchedSimMode
+    const char *algorithm; // "FIFO", "SJF", "RR", "PS", "SRT", "LOTTERY", "STRIDE"; NULL en sincronización sin CPU
+    int quantum;
+    int isPreemptive;
+    int frames;            // 1: un frame {"type": "CYCLE", ...} por ciclo
+
+    // Solo sincronización
+    int useMutex;          // 1: mutex, 0: semáforo
+    int priorityQueue;     // 1: colas de espera por prioridad
+    const char *protocol;  // "none", "inheritance" o "ceiling"
+    int shards;            // Hilos que reparten los recursos al conceder accesos
+  } SchedSimConfig;
+
+  typedef struct
+  {
+    char pid[SCHEDSIM_NAME_LEN];
+    int burstTime;
+    int arrivalTime;
+    int priority;
+  } SchedSimProcess;
+
+  typedef struct
+  {
+    char name[SCHEDSIM_NAME_LEN];
+    int counter;
+  } SchedSimResource;
+
+  typedef struct
+  {
+    char pid[SCHEDSIM_NAME_LEN];
+    int action; // SchedSimActionType
+    char resource[SCHEDSIM_NAME_LEN];
+    int cycle;
+  } SchedSimAction;
+
+  // Métricas de un proceso (-1 en startTime/endTime si no llegó a ocurrir)
+  typedef struct
+  {
+    char pid[SCHEDSIM_NAME_LEN];
+    int state; // SchedSimState
+    int startTime;
+    int endTime;
+    int waitingTime;
+  } SchedSimResult;
+
+  /**
+   * Recibe una línea JSON de evento. `line` apunta al buffer de eventos de la simulación (no
+   * termina en salto de línea ni en '\0') y es válida hasta el siguiente paso.
+   */
+  typedef void (*SchedSimEventCallback)(const char *line, size_t length, void *userData);
+
+  // Versión de la API con la que se compiló la biblioteca (SCHEDSIM_API_VERSION)
+  SCHEDSIM_EXPORT int schedsimVersion(void);
+
+  SCHEDSIM_EXPORT void schedsimDefaultConfig(SchedSimConfig *config);
+
+  /**
+   * Crea una simulación sobre copias de los arreglos dados.
+   *
+   * @return La simulación, o NULL si la configuración no es válida, la carga excede los límites
+   *         del simulador u otra simulación sigue en curso.
+   */
+  SCHEDSIM_EXPORT SchedSim *schedsimCreate(const SchedSimConfig *config,
+                                           const SchedSimProcess *processes, int processCount,
+                                           const SchedSimResource *resources, int resourceCount,
+                                           const SchedSimAction *actions, int actionCount);
+
+  // Entrega cada línea de evento a `callback` al terminar cada paso (NULL: sin callback)
+  SCHEDSIM_EXPORT void schedsimSetEventCallback(SchedSim *sim, SchedSimEventCallback callback, void *userData);
+
+  /**
+   * Avanza un ciclo simulado. Al terminar, el paso que devuelve 0 trae las líneas finales
+   * (métricas globales y SIMULATION_END).
+   *
+   * @return 1 si quedan ciclos, 0 si la simulación terminó, -1 si falló.
+   */
+  SCHEDSIM_EXPORT int schedsimStep(SchedSim *sim);
+
+  // Avanza hasta el final (los eventos llegan al callback ciclo a ciclo); 0 si terminó, -1 si falló
+  SCHEDSIM_EXPORT int schedsimRun(SchedSim *sim);
+
+  /**
+   * Eventos del último paso, sin copiar: líneas JSON separadas por '\n' y terminadas en '\0'.
+   * El buffer es válido hasta el siguiente paso o schedsimDestroy.
+   */
+  SCHEDSIM_EXPORT const char *schedsimEvents(const SchedSim *sim, size_t *length);
+
+  // Ciclos simulados hasta el momento
+  SCHEDSIM_EXPORT int schedsimCycle(const SchedSim *sim);
+
+  /**
+   * Copia las métricas de los procesos (estado al último paso) en `results`.
+   *
+   * @return Cantidad de procesos de la simulación (puede ser mayor que `capacity`).
+   */
+  SCHEDSIM_EXPORT int schedsimResults(const SchedSim *sim, SchedSimResult *results, int capacity);
+
+  // Libera la simulación; si no había terminado se completa sin entregar eventos
+  SCHEDSIM_EXPORT void schedsimDestroy(SchedSim *sim);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,84 @@
+#ifndef SELECTION_H
+#define SELECTION_H
+
+#include "simulator.h"
+
+/**
+ * Columnas de los procesos que recorren las búsquedas de cada ciclo (estructura de arreglos).
+ * Las búsquedas solo leen llegada, ráfaga, prioridad y ráfaga pendiente; tenerlas contiguas evita
+ * recorrer los Process completos (con el pid en línea) y permite comparar varios procesos por
+ * instrucción.
+ */
+typedef struct
+{
+  int arrival[MAX_PROCESSES];
+  int burst[MAX_PROCESSES];
+  int priority[MAX_PROCESSES];
+  int remaining[MAX_PROCESSES]; // Ráfaga pendiente (-1: proceso terminado)
+} ProcessColumns;
+
+/**
+ * Implementaciones de las búsquedas. Se elige la mejor disponible en la CPU al primer uso.
+ */
+typedef enum
+{
+  KERNEL_SCALAR,
+  KERNEL_SSE2,
+  KERNEL_AVX2
+} SelectionKernel;
+
+/**
+ * Copia las columnas de los procesos. La ráfaga pendiente inicial es la ráfaga completa, o -1 si
+ * el proceso ya terminó (por ejemplo, al reanudar desde un snapshot).
+ */
+void loadProcessColumns(ProcessColumns *columns, const Process *processes, int processCount);
+
+/**
+ * SRT: proceso listo (llegó y con ráfaga pendiente > 0) con menor ráfaga pendiente. En empate se
+ * mantiene `lastIdx` si está entre los empatados; si no, el de mayor prioridad (menor valor) y luego
+ * el de menor índice.
+ *
+ * @return Índice del proceso elegido, o -1 si no hay procesos listos.
+ */
+int selectShortestRemaining(const ProcessColumns *columns, int processCount, int currentTime, int lastIdx);
+
+/**
+ * SJF: proceso que llegó y no terminó (ráfaga pendiente >= 0) con menor ráfaga; en empate el que
+ * llegó antes y luego el de menor índice.
+ */
+int selectShortestJob(const ProcessColumns *columns, int processCount, int currentTime);
+
+/**
+ * PS: proceso listo (ráfaga pendiente > 0) de mayor prioridad (menor valor); en empate el que llegó
+ * antes, luego el de menor ráfaga y luego el de menor índice.
+ */
+int selectHighestPriority(const ProcessColumns *columns, int processCount, int currentTime);
+
+/**
+ * FIFO: proceso listo (ráfaga pendiente > 0) que llegó antes; en empate el de menor índice.
+ */
+int selectFirstArrived(const ProcessColumns *columns, int processCount, int currentTime);
+
+/**
+ * Proceso que ocupa la CPU en los motores que llevan su propia cola de listos (I/O y modo en línea),
+ * con la búsqueda de `config->algorithm` (FIFO, SJF, SRT o PS; cualquier otro se trata como FIFO).
+ * El motor carga como llegada el ciclo por el que ordena la cola de listos, como ráfaga la ráfaga de
+ * CPU en curso y como ráfaga pendiente la misma, o -1 si el proceso no está listo.
+ *
+ * @param current Proceso en la CPU (-1 si ninguno); sin expropiación lo conserva hasta terminar.
+ * @return Índice del proceso elegido, o -1 si no hay procesos listos.
+ */
+int selectReadyProcess(const ProcessColumns *columns, int processCount, int currentTime,
+                       const SimulationConfig *config, int current);
+
+/**
+ * Fuerza una implementación de las búsquedas (para pruebas y mediciones).
+ *
+ * @return 0 si la CPU la soporta, -1 si no (se mantiene la actual).
+ */
+int setSelectionKernel(SelectionKernel kernel);
+
+// Implementación en uso ("scalar", "sse2" o "avx2")
+const char *getSelectionKernelName(void);
+
+#endif
@@ -0,0 +1,117 @@
+#ifndef SESSION_H
+#define SESSION_H
+
+#include "simulator.h"
+#include <stdio.h>
+
+/**
+ * Carga de trabajo de una simulación: procesos, recursos, acciones y dispositivos ya parseados.
+ * Las sesiones trabajan sobre una copia, por lo que una carga puede reutilizarse.
+ */
+typedef struct
+{
+  Process processes[MAX_PROCESSES];
+  int processCount;
+  Resource resources[MAX_PROCESSES];
+  int resourceCount;
+  Action actions[MAX_EVENTS];
+  int actionCount;
+  BurstSequence bursts[MAX_PROCESSES]; // Ráfagas de CPU e I/O de cada proceso (count 0: solo burstTime)
+  Device devices[MAX_DEVICES];
+  int deviceCount;
+  PredecessorList predecessors[MAX_PROCESSES]; // Procesos que deben terminar antes de cada proceso
+} Workload;
+
+/**
+ * Carga procesos.txt, recursos.txt, acciones.txt, dispositivos.txt y dependencias.txt desde un
+ * directorio.
+ * Los archivos que no existen se cargan vacíos.
+ *
+ * @param inputDir Directorio de entrada (por ejemplo "../data/input").
+ * @return 0 si se cargaron los procesos, -1 si no existe procesos.txt.
+ */
+int loadWorkload(Workload *workload, const char *inputDir);
+
+/**
+ * Lee la línea de configuración JSON de una sesión, sin límite de largo.
+ *
+ * @return Línea sin el salto final (liberar con free) o NULL si la entrada terminó.
+ */
+char *readSessionConfig(FILE *in);
+
+/**
+ * Carga la carga de trabajo incluida en la sesión, si la hay:
+ *  - `"workload": {"processes": [...], "resources": [...], "actions": [...], "devices": [...]}`
+ *    dentro del JSON (cada proceso puede traer `"dependsOn": ["P1", ...]`), o
+ *  - `"workloadBytes": N` y, después de la línea de configuración, un bloque de N bytes con las
+ *    líneas de los archivos de entrada bajo los encabezados #procesos, #recursos, #acciones,
+ *    #dispositivos y #dependencias.
+ *
+ * Se rechaza la carga si un proceso no trae pid (o excede COMMON_MAX_LEN - 1 caracteres), su
+ * burstTime no es positivo o su arrivalTime es negativo.
+ *
+ * @param in Entrada desde la que se lee el bloque compacto.
+ * @return 1 si la sesión trae su carga, 0 si debe usarse la de archivos, -1 si el bloque está
+ *         incompleto o la carga no es válida.
+ */
+int loadInlineWorkload(const char *configLine, FILE *in, Workload *workload);
+
+/**
+ * Ejecuta una simulación de calendarización sobre la carga de trabajo y escribe sus eventos en stdout.
+ *
+ * @param configLine JSON de configuración (algorithm, quantum, isPreemptive).
+ * @return 0 si la simulación terminó, -1 si la configuración no es válida.
+ */
+int runSchedulingSession(const char *configLine, const Workload *workload);
+
+/**
+ * Lee de una línea de configuración solo las opciones del algoritmo (algorithm, quantum,
+ * isPreemptive, priorityQuantum y costo de cambio de contexto) sobre `config`, sin imprimir nada ni
+ * activar salidas (frames, traza, telemetría).
+ *
+ * @return 0 si la línea es un objeto JSON, -1 si no.
+ */
+int parseSimulationConfig(const char *configLine, SimulationConfig *config);
+
+/**
+ * Indica si la configuración pide el modo en línea ("stream": true): los procesos llegan por la
+ * entrada de la sesión mientras corre la simulación, en lugar de venir en la carga de trabajo.
+ */
+int isStreamSession(const char *configLine);
+
+/**
+ * Ejecuta una simulación de calendarización en línea leyendo los procesos de `in` (ver
+ * simulateStream) y escribe sus eventos en stdout.
+ *
+ * @param in Entrada de la sesión, a continuación de la línea de configuración.
+ * @return 0 si la simulación terminó, -1 si la configuración no es válida.
+ */
+int runStreamSession(const char *configLine, FILE *in);
+
+/**
+ * Ejecuta el motor de calendarización configurado sobre `processes` (sin encabezados ni
+ * SIMULATION_END) y emite la línea de métricas con el promedio de espera.
+ *
+ * @return 0 si la simulación terminó, -1 si el algoritmo no es válido.
+ */
+int runSchedulingEngine(Process *processes, int processCount, SimulationControl *control);
+
+/**
+ * Ejecuta el motor de sincronización, o el combinado si `control` trae un algoritmo de CPU, sobre
+ * los arreglos dados (la simulación los modifica).
+ */
+void runSynchronizationEngine(Process *processes, int processCount,
+                              Resource *resources, int resourceCount,
+                              Action *actions, int actionCount,
+                              SyncConfig *config, SimulationControl *control);
+
+/**
+ * Ejecuta una simulación de sincronización (o combinada) sobre la carga de trabajo y escribe
+ * sus eventos en stdout.
+ *
+ * @param configLine JSON de configuración (useMutex, protocol, algorithm, ...).
+ * @return 0 si la simulación terminó, -1 si la configuración no es válida.
+ */
+int runSynchronizationSession(const char *configLine, const Workload *workload);
+
+#endif
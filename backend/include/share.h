@@ -0,0 +1,49 @@
+#ifndef SHARE_H
+#define SHARE_H
+
+#include "simulator.h"
+#include "checkpoint.h"
+
+#define SHARE_BASE_TICKETS 1000 // Boletos de la prioridad 0 (la prioridad p recibe SHARE_BASE_TICKETS / (p + 1))
+#define SHARE_DEFAULT_WINDOW 50 // Ciclos por evento SHARE si la configuración no indica "shareWindow"
+#define SHARE_DEFAULT_SEED 1
+
+/**
+ * Reporte de la parte de CPU en LOTTERY y STRIDE: lo que cada proceso recibió frente a lo que le
+ * correspondía por sus boletos.
+ *
+ * En cada ciclo en que un proceso avanza su ráfaga, ese ciclo se reparte entre los procesos listos
+ * (incluido el que ejecuta) en proporción a sus boletos: esa es la parte que les corresponde. Los
+ * ciclos de cambio de contexto y los ciclos sin procesos listos no se reparten.
+ *
+ * Cada `window` ciclos se emite un evento SHARE con la parte recibida y la que correspondía a cada
+ * proceso activo en la ventana, y al final un SHARE_METRIC por proceso con los totales. El estado es
+ * global (una simulación a la vez) y se guarda en los snapshots con una región propia.
+ */
+
+// Boletos de un proceso: los explícitos de la configuración o los derivados de su prioridad
+int getProcessTickets(const SimulationConfig *config, const Process *process);
+
+// Reinicia el reporte para una nueva simulación
+void beginShareReport(const SimulationConfig *config, const Process *processes, int processCount);
+
+// Región de snapshot con los acumulados del reporte
+CheckpointRegion shareReportRegion(void);
+
+/**
+ * Registra un ciclo: los procesos listos son los de estado WAITING (el que ejecuta también).
+ *
+ * @param running Proceso que avanzó su ráfaga en el ciclo (-1 si ninguno o si fue de cambio).
+ */
+void recordShareCycle(const Process *processes, int processCount, int running, int cycle);
+
+// Emite la última ventana (incompleta) y un SHARE_METRIC por proceso
+void finishShareReport(const Process *processes, int processCount, int cycle);
+
+/**
+ * Error del reparto de la última simulación: la fracción de la CPU entregada que no fue a quien le
+ * correspondía (la mitad de la suma de |recibido - correspondiente| sobre el total entregado).
+ */
+double getShareError(void);
+
+#endif
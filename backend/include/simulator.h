@@ -2,6 +2,7 @@
 #define SIMULATOR_H
 
 #include <stdio.h>
+#include <stddef.h>
 
 /**
  * Definiciones de tamaños estándar
@@ -9,6 +10,10 @@
 #define COMMON_MAX_LEN 10
 #define MAX_PROCESSES 100
 #define MAX_EVENTS 500
+#define MAX_PRIORITY_LEVELS 32 // Prioridades con quantum propio en RR (0 a MAX_PRIORITY_LEVELS - 1)
+#define MAX_BURSTS 32          // Ráfagas de CPU y de I/O por proceso
+#define MAX_DEVICES 8          // Dispositivos de I/O simulados
+#define MAX_PREDECESSORS 16    // Predecesores declarados por proceso
 #define SIMULATION_DELAY_US 1000000
 
 /**
@@ -21,9 +26,33 @@ typedef enum
   ALGO_RR,
   ALGO_SJF,
   ALGO_SRT,
-  ALGO_NONE // Por defecto si no se ha definido
+  ALGO_LOTTERY, // Reparto proporcional por sorteo
+  ALGO_STRIDE,  // Reparto proporcional determinista (pasos)
+  ALGO_NONE     // Por defecto si no se ha definido
 } SchedulingAlgorithm;
 
+/**
+ * Costo de los cambios de contexto en RR, SRT, PS expropiativo, LOTTERY y STRIDE (todo en ciclos; 0 y 0: sin costo)
+ */
+typedef struct
+{
+  int contextSwitch; // Ciclos fijos cada vez que la CPU pasa a otro proceso
+  int warmup;        // Ciclos extra para recalentar la caché de un proceso frío
+  int warmupWindow;  // Ciclos sin ejecutar tras los que la caché queda fría (0: fría al volver)
+} SwitchCostConfig;
+
+/**
+ * Reparto proporcional de LOTTERY y STRIDE: boletos de cada proceso y reporte de la parte de CPU
+ */
+typedef struct
+{
+  unsigned int seed; // Semilla del sorteo de LOTTERY
+  int window;        // Ciclos por evento SHARE (0: solo SHARE_METRIC al final)
+  int ticketCount;   // Procesos con boletos explícitos (el resto los deriva de su prioridad)
+  char ticketPid[MAX_PROCESSES][COMMON_MAX_LEN];
+  int tickets[MAX_PROCESSES];
+} ShareConfig;
+
 /**
  * Configuración de la simulación (parámetros generales)
  */
@@ -31,9 +60,65 @@ typedef struct
 {
   SchedulingAlgorithm algorithm;
   int quantum;
-  int isPreemptive; // 0: No preemptivo, 1: Preemptivo
+  int isPreemptive;                         // 0: No preemptivo, 1: Preemptivo
+  int priorityQuantum[MAX_PRIORITY_LEVELS]; // Quantum de RR por prioridad (0: usa quantum)
+  SwitchCostConfig switchCost;              // Costo de los cambios de contexto
+  ShareConfig share;                        // Boletos y reporte de LOTTERY y STRIDE
 } SimulationConfig;
 
+/**
+ * Protocolos de prioridad para la simulación de sincronización
+ */
+typedef enum
+{
+  PROTOCOL_NONE,        // Sin protocolo: el poseedor conserva su prioridad base
+  PROTOCOL_INHERITANCE, // Herencia de prioridad
+  PROTOCOL_CEILING      // Techo de prioridad (Priority Ceiling Protocol)
+} PriorityProtocol;
+
+/**
+ * Modelos de lock para el análisis de costo (se combinan como máscara de bits)
+ */
+typedef enum
+{
+  LOCK_BLOCKING = 1 << 0, // Mutex bloqueante: el proceso duerme y se despierta al liberar
+  LOCK_TAS = 1 << 1,      // Spinlock test-and-set
+  LOCK_TICKET = 1 << 2,   // Ticket lock (FIFO, spin sobre una línea compartida)
+  LOCK_MCS = 1 << 3       // Lock de cola MCS (FIFO, spin sobre un nodo local)
+} LockType;
+
+#define LOCK_ALL (LOCK_BLOCKING | LOCK_TAS | LOCK_TICKET | LOCK_MCS)
+
+/**
+ * Modelo de costos del análisis de locks (en ticks; un ciclo equivale a ticksPerCycle ticks)
+ */
+typedef struct
+{
+  int cores;                 // Núcleos disponibles para hilos que giran o retienen un lock
+  int ticksPerCycle;         // Duración de una sección crítica (una acción)
+  double cacheLineTransfer;  // Costo de mover la línea de caché del lock entre núcleos
+  double spinCost;           // Ticks por iteración de spin (define el tráfico de test-and-set)
+  double handoffLatency;     // Costo fijo de pasar la propiedad del lock
+  double wakeupLatency;      // Costo de despertar a un proceso dormido (lock bloqueante)
+  double preemptionPenalty;  // Retraso si el sucesor FIFO no está en CPU (sobresuscripción)
+} LockCostModel;
+
+/**
+ * Configuración de la simulación de sincronización
+ */
+typedef struct
+{
+  int useMutex;              // 1: mutex, 0: semáforo
+  int priorityQueue;         // 0: orden del arreglo (acciones en espera se descartan), 1: colas de espera por prioridad
+  PriorityProtocol protocol; // Protocolo aplicado a los poseedores de recursos
+  int realThreads;           // 1: reproducir además el escenario con hilos reales (pthreads)
+  int cycleUs;               // Duración real de un ciclo en la reproducción con hilos (microsegundos)
+  int timeoutMs;             // Tiempo máximo de espera por un recurso en la reproducción con hilos
+  int lockModels;            // Máscara de LockType a comparar con el modelo de costos (0: ninguno)
+  LockCostModel costModel;   // Parámetros del modelo de costos de locks
+  int shards;                // Hilos que reparten los recursos al conceder accesos (0 o 1: secuencial)
+} SyncConfig;
+
 /**
  * Estructura de Control de Simulación (posible implementación para controlar timeline de eventos)
  */
@@ -51,7 +136,10 @@ typedef enum
   STATE_WAITING,
   STATE_ACCESSED,
   STATE_TERMINATED,
-  STATE_OMITED
+  STATE_OMITED,
+  STATE_SWITCHING, // Cambio de contexto: el proceso ocupa la CPU sin avanzar su ráfaga
+  STATE_IO,        // Ráfaga de I/O en curso en un dispositivo
+  STATE_IO_WAITING // En la cola de un dispositivo ocupado
 } ProcessState;
 
 /**
@@ -72,6 +160,46 @@ typedef struct
   ProcessState state;
 } Process;
 
+/**
+ * Secuencia de ráfagas de un proceso con I/O: CPU, I/O, CPU, ..., CPU. Las posiciones pares son
+ * ráfagas de CPU y las impares ráfagas de I/O en `device[i]`. Sin secuencia (count 0) el proceso es
+ * una sola ráfaga de CPU de `burstTime`.
+ */
+typedef struct
+{
+  int count;
+  int length[MAX_BURSTS];
+  int device[MAX_BURSTS]; // Índice del dispositivo (solo en las ráfagas de I/O)
+} BurstSequence;
+
+/**
+ * Predecesores de un proceso: no está listo hasta que todos terminan. Se guardan por pid porque se
+ * declaran antes de resolver la carga completa.
+ */
+typedef struct
+{
+  int count;
+  char pid[MAX_PREDECESSORS][COMMON_MAX_LEN];
+} PredecessorList;
+
+/**
+ * Política de la cola de un dispositivo de I/O
+ */
+typedef enum
+{
+  DEVICE_FCFS,    // Orden de llegada a la cola
+  DEVICE_PRIORITY // Mayor prioridad (menor valor) primero; en empate, orden de llegada
+} DeviceQueuePolicy;
+
+/**
+ * Dispositivo de I/O: atiende una ráfaga a la vez, en paralelo con la CPU
+ */
+typedef struct
+{
+  char name[COMMON_MAX_LEN];
+  DeviceQueuePolicy policy;
+} Device;
+
 /**
  * Estructura para representar un Recurso
  */
@@ -133,11 +261,36 @@ void exportProcessMetric(const Process *p);
 void exportProcessMetricWithOriginalBT(const Process *p, int originalBT);
 void exportEventRealtime(TimelineEvent *event);
 void exportSyncEventRealtime(TimelineEvent *event, ActionType action);
+void exportInversionMetric(const Process *p, int inversionTime, int longestInversion);
 void exportSimulationEnd();
 
+// Salida de eventos, opcionalmente agrupada en un frame por ciclo
+void setFrameBatching(int enabled);
+void emitEventLine(const char *json, int cycle);
+void flushCycleFrame(void);
+void endSimulationCycle(void);
+
+// Silencia los eventos y el retardo por ciclo (avance rápido hasta un ciclo pedido con seek)
+void setOutputMuted(int muted);
+int isOutputMuted(void);
+
+/**
+ * Destino de la salida para usar los motores dentro de otro proceso (libschedsim): cada línea JSON
+ * (evento, frame, métricas o fin) se entrega a `sink` en lugar de imprimirse, y al cerrar cada ciclo
+ * se llama a `cycleEnd` en lugar de esperar el retardo. La línea no incluye el salto final y solo es
+ * válida durante la llamada. Con `sink` NULL se vuelve a stdout.
+ */
+typedef void (*OutputSink)(const char *line, size_t length, void *context);
+typedef void (*CycleSink)(void *context);
+void setOutputSink(OutputSink sink, CycleSink cycleEnd, void *context);
+
+// Imprime una línea de resumen (métricas globales) fuera de los frames; se omite si la salida está silenciada
+void printSummaryLine(const char *json);
+
 // Ver timelinelog de los eventos
 void printEventForProcess(Process *process, int currentTime, ProcessState state, TimelineEvent *events, int *eventCount);
 void printEventForSyncProcess(Process *process, int currentTime, ProcessState state, TimelineEvent *events, int *eventCount, ActionType action);
+void printEventForDeviceProcess(Process *process, int currentTime, ProcessState state, const char *device, TimelineEvent *events, int *eventCount);
 
 /**
  * Funciones para carga y manejo de datos
@@ -146,11 +299,23 @@ int loadProcesses(const char *filename, Process *processes, int maxProcesses);
 int loadResources(const char *filename, Resource *resources, int maxResources);
 int loadActions(const char *filename, Action *actions, int maxActions);
 
+// Parseo de una línea con el formato de los archivos de entrada (1 si es válida)
+int parseProcessLine(const char *line, Process *process);
+int parseResourceLine(const char *line, Resource *resource);
+int parseActionLine(const char *line, Action *action);
+ActionType parseActionType(const char *str);
+int parseDeviceLine(const char *line, Device *device);
+int loadDevices(const char *filename, Device *devices, int maxDevices);
+
 /**
  * Utilidades de conversión enum <-> string
  */
 const char *getProcessStateName(ProcessState state);
 const char *getActionTypeName(ActionType action);
 const char *getAlgorithmName(SchedulingAlgorithm algorithm);
+SchedulingAlgorithm parseAlgorithm(const char *str);
+int getQuantumForPriority(const SimulationConfig *config, int priority);
+const char *getProtocolName(PriorityProtocol protocol);
+const char *getLockTypeName(LockType lock);
 
 #endif
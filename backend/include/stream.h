@@ -0,0 +1,49 @@
+#ifndef STREAM_H
+#define STREAM_H
+
+#include "simulator.h"
+#include <stdio.h>
+
+#define STREAM_MAX_LIVE MAX_PROCESSES // Procesos vivos (admitidos y sin terminar) a la vez
+#define STREAM_END_MARK "#fin"        // Línea que cierra la entrada (igual que el fin de archivo)
+
+/**
+ * Totales de la última simulación en línea. Los procesos terminados no se guardan: sus métricas se
+ * acumulan aquí al emitir su PROCESS_METRIC.
+ */
+typedef struct
+{
+  int cycles;          // Ciclos simulados
+  int completed;       // Procesos terminados
+  long waitingTime;    // Suma de waitingTime de los terminados
+  long turnaroundTime; // Suma de (fin - llegada) de los terminados
+  int cpuBusyCycles;   // Ciclos con la CPU ocupada (ejecución o cambio de contexto)
+  int maxLive;         // Máximo de procesos vivos a la vez
+  int delayed;         // Procesos admitidos después de su arrivalTime (llegaron tarde o la tabla estaba llena)
+  int rejected;        // Líneas descartadas
+} StreamStats;
+
+/**
+ * Simula la calendarización de CPU con los procesos leídos de `in` mientras corre la simulación.
+ *
+ * Cada línea es un proceso con el formato de procesos.txt ("PID, BT, AT, PRIORIDAD"), en orden de
+ * llegada. "@N" avisa que no llegan más procesos antes del ciclo N (deja avanzar el reloj sin
+ * llegadas), y STREAM_END_MARK o el fin de archivo cierra la entrada. Para simular el ciclo t el
+ * motor lee hasta ver una llegada posterior a t, una marca mayor a t o el cierre, así que la lectura
+ * bloquea solo cuando hace falta saber qué llega.
+ *
+ * Los procesos viven en `slots` (STREAM_MAX_LIVE) desde que se admiten hasta que terminan; al
+ * terminar se emiten TERMINATED y PROCESS_METRIC y el lugar queda libre, así que la memoria depende
+ * de los procesos vivos y no del largo de la entrada. Un proceso que llega tarde (arrivalTime ya
+ * pasado) o con la tabla llena se admite en el ciclo en curso, que pasa a ser su arrivalTime.
+ *
+ * @param slots Tabla de procesos vivos (STREAM_MAX_LIVE elementos), p. ej. para la telemetría.
+ * @return 0 al terminar, -1 si el algoritmo no está soportado.
+ */
+int simulateStream(FILE *in, Process *slots,
+                   TimelineEvent *events, int *eventCount,
+                   SimulationControl *control);
+
+StreamStats getStreamStats(void);
+
+#endif
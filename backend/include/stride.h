@@ -0,0 +1,23 @@
+#ifndef STRIDE_H
+#define STRIDE_H
+
+#include "simulator.h"
+
+#define STRIDE_ONE (1LL << 30) // Paso de un proceso con un boleto (stride = STRIDE_ONE / boletos)
+
+/**
+ * Simula la planificación por pasos (Stride Scheduling): versión determinista del sorteo. Cada
+ * quantum ejecuta el proceso listo con menor `pass`, que avanza en `STRIDE_ONE / boletos` por ciclo
+ * ejecutado.
+ *
+ * @param processes    Arreglo de procesos a simular.
+ * @param processCount Número de procesos en el arreglo.
+ * @param events       Arreglo donde se registran eventos simulados.
+ * @param eventCount   Puntero al contador de eventos registrados.
+ * @param control      Estructura con la configuración (quantum y boletos en `share`).
+ */
+void simulateStride(Process *processes, int processCount,
+                    TimelineEvent *events, int *eventCount,
+                    SimulationControl *control);
+
+#endif
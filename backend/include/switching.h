@@ -0,0 +1,60 @@
+#ifndef SWITCHING_H
+#define SWITCHING_H
+
+#include "simulator.h"
+#include "checkpoint.h"
+
+/**
+ * Modelo de costo de los cambios de contexto para RR, SRT, PS expropiativo, LOTTERY y STRIDE.
+ *
+ * Cuando la CPU pasa a un proceso distinto del último que ejecutó, el proceso entrante ocupa la CPU
+ * (estado SWITCHING, sin avanzar su ráfaga) durante:
+ *   contextSwitch + warmup * min(ciclos sin ejecutar, warmupWindow) / warmupWindow
+ * redondeado hacia arriba. Un proceso que nunca ejecutó paga el recalentamiento completo, y con
+ * `warmupWindow` 0 lo paga siempre que vuelve. Reanudar el mismo proceso no cuesta nada.
+ *
+ * El estado del modelo es global (una simulación a la vez, igual que la salida) y se guarda en los
+ * snapshots con una región propia.
+ */
+
+// Indica si el algoritmo de la configuración usa el modelo y tiene algún costo de cambio
+int switchCostEnabled(const SimulationConfig *config);
+
+/**
+ * Reinicia el modelo para una nueva simulación.
+ *
+ * @return 1 si el modelo está activo (hay que agregar su región a los snapshots), 0 si no.
+ */
+int beginSwitchModel(const SimulationConfig *config);
+
+// Región de snapshot con el estado del modelo
+CheckpointRegion switchModelRegion(void);
+
+/**
+ * Decide si el ciclo `cycle` del proceso `processIdx` se pierde en el cambio de contexto. Se llama
+ * una vez por ciclo con el proceso que tiene la CPU; si el proceso cambió respecto del anterior,
+ * empieza un cambio nuevo (uno a medio pagar se descarta).
+ *
+ * @return 1 si el ciclo es de cambio (el proceso no avanza), 0 si el proceso ejecuta.
+ */
+int switchingCycle(int processIdx, int cycle);
+
+/**
+ * Olvida la historia del índice `processIdx`, que pasa a ser de otro proceso (modo en línea): el
+ * próximo despacho paga el cambio y la caché fría aunque el índice haya sido el último en ejecutar.
+ */
+void forgetSwitchProcess(int processIdx);
+
+/**
+ * Totales de la última simulación con el modelo activo
+ */
+typedef struct
+{
+  int switches;       // Cambios de contexto (la CPU pasó a otro proceso)
+  int overheadCycles; // Ciclos en estado SWITCHING
+  int executedCycles; // Ciclos en que un proceso avanzó su ráfaga
+} SwitchStats;
+
+SwitchStats getSwitchStats(void);
+
+#endif
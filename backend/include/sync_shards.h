@@ -0,0 +1,47 @@
+#ifndef SYNC_SHARDS_H
+#define SYNC_SHARDS_H
+
+#include "synchronization.h"
+#include <stdbool.h>
+
+/**
+ * Procesos mínimos para repartir la concesión. Conceder una acción cuesta unos 9 ns y despachar un
+ * ciclo a los hilos unos 5 us por shard, así que con pocas acciones por ciclo los hilos solo agregan
+ * costo. El umbral queda por debajo de MAX_PROCESSES para que las cargas grandes del simulador (y
+ * tests/test_shards.c) usen el reparto; se puede ajustar con -DSYNC_SHARD_MIN_PROCESSES=N.
+ */
+#ifndef SYNC_SHARD_MIN_PROCESSES
+#define SYNC_SHARD_MIN_PROCESSES 64
+#endif
+
+/**
+ * Inicia los hilos que reparten los recursos de la simulación de sincronización.
+ *
+ * El recurso r pertenece al shard r % shards. En un ciclo cada proceso emite a lo sumo una acción
+ * sobre un único recurso, así que el resultado de una acción solo depende de las acciones previas
+ * sobre el mismo recurso: cada shard concede las suyas en el orden de atención y el resultado es
+ * idéntico al secuencial. El protocolo de techo consulta recursos de todos los shards, por lo que
+ * en ese caso no se reparte.
+ *
+ * @param s      Estado de la simulación (ya inicializado).
+ * @param shards Cantidad de shards pedida (se limita a la cantidad de recursos; se ignora con menos
+ *               de SYNC_SHARD_MIN_PROCESSES procesos).
+ * @return Shards en uso; 1 o menos indica que la concesión sigue siendo secuencial.
+ */
+int startSyncShards(SyncState *s, int shards);
+
+/**
+ * Concede en paralelo las acciones del ciclo. Cada acción se envía al shard dueño de su recurso
+ * y los shards las procesan en el orden de `order`.
+ *
+ * @param order      Procesos en orden de atención.
+ * @param ready      Acción lista de cada proceso (indexado por proceso).
+ * @param orderCount Número de procesos en `order`.
+ * @param granted    Salida: granted[k] indica si se concedió la acción de order[k].
+ */
+void grantActionsSharded(SyncState *s, const int *order, const int *ready, int orderCount, bool *granted);
+
+// Detiene los hilos de los shards
+void stopSyncShards(void);
+
+#endif
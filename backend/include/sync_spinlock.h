@@ -0,0 +1,36 @@
+#ifndef SYNC_SPINLOCK_H
+#define SYNC_SPINLOCK_H
+
+#include "simulator.h"
+
+/**
+ * Compara modelos de lock (bloqueante, test-and-set, ticket y MCS) sobre la misma traza de acciones.
+ *
+ * Cada recurso se trata como un lock exclusivo y cada acción como una sección crítica de un ciclo.
+ * El tiempo avanza en ticks; los procesos que giran esperando un lock consumen CPU y, si hay más
+ * hilos activos (girando o reteniendo) que `model->cores`, todos avanzan a la fracción
+ * cores / activos. El traspaso del lock cuesta según el tipo:
+ *  - blocking: handoffLatency + wakeupLatency (el proceso en espera duerme, no consume CPU)
+ *  - tas:      handoffLatency + cacheLineTransfer * esperando (ganador arbitrario, tráfico al girar)
+ *  - ticket:   handoffLatency + cacheLineTransfer * esperando (FIFO)
+ *  - mcs:      handoffLatency + cacheLineTransfer (FIFO, cada proceso gira sobre su nodo)
+ * Los locks FIFO suman preemptionPenalty proporcional a la sobresuscripción, porque el sucesor
+ * puede no estar en CPU.
+ *
+ * Emite con emitEventLine un `LOCK_MODEL_METRIC` por cada tipo incluido en `lockModels`.
+ *
+ * @param processes     Procesos cargados.
+ * @param processCount  Número de procesos.
+ * @param resources     Recursos cargados.
+ * @param resourceCount Número de recursos.
+ * @param actions       Acciones del escenario.
+ * @param actionCount   Número de acciones.
+ * @param lockModels    Máscara de LockType a evaluar.
+ * @param model         Parámetros del modelo de costos.
+ */
+void simulateLockModels(const Process *processes, int processCount,
+                        const Resource *resources, int resourceCount,
+                        const Action *actions, int actionCount,
+                        int lockModels, const LockCostModel *model);
+
+#endif
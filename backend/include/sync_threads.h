@@ -0,0 +1,34 @@
+#ifndef SYNC_THREADS_H
+#define SYNC_THREADS_H
+
+#include "simulator.h"
+
+/**
+ * Reproduce el escenario de sincronización con hilos reales (un hilo POSIX por proceso),
+ * usando `pthread_mutex_t` o `sem_t` por recurso según `config->useMutex`.
+ *
+ * Cada ciclo dura `config->cycleUs` microsegundos reales. Un hilo emite cada acción al llegar su
+ * ciclo (o en cuanto pueda si va atrasado), retiene el recurso durante un ciclo y lo conserva
+ * mientras encadene acciones en ciclos consecutivos, igual que la simulación. Las esperas usan
+ * `config->timeoutMs` como límite para no bloquear indefinidamente ante un deadlock real.
+ *
+ * Emite con emitEventLine un `THREAD_METRIC` por proceso (latencia de adquisición, cambios de contexto y
+ * tiempo de espera simulado) y con printSummaryLine un resumen `threads_metrics` con el throughput del
+ * host, así que respeta los frames, el silencio y el destino de salida de la biblioteca.
+ *
+ * @param processes     Procesos tal como se cargaron (antes de simular).
+ * @param processCount  Número de procesos.
+ * @param resources     Recursos tal como se cargaron.
+ * @param resourceCount Número de recursos.
+ * @param actions       Acciones del escenario.
+ * @param actionCount   Número de acciones.
+ * @param config        Configuración de sincronización.
+ * @param simulated     Procesos con las métricas de la simulación (puede ser NULL).
+ * @return 0 si la reproducción se completó, -1 si no se pudieron crear los hilos o primitivas.
+ */
+int runThreadedSynchronization(const Process *processes, int processCount,
+                               const Resource *resources, int resourceCount,
+                               const Action *actions, int actionCount,
+                               const SyncConfig *config, const Process *simulated);
+
+#endif
@@ -2,17 +2,81 @@
 #define SYNCHRONIZATION_H
 
 #include "simulator.h"
+#include "checkpoint.h"
+#include <stdbool.h>
+
+/**
+ * Estado interno de la simulación de sincronización.
+ * Agrupa los arreglos de control para poder compartirlos con las funciones auxiliares.
+ */
+typedef struct
+{
+  Process *processes;
+  int processCount;
+  Resource *resources;
+  int resourceCount;
+  Action *actions;
+  int actionCount;
+  SyncConfig *config;
+
+  int actionOwner[MAX_EVENTS];    // Índice del proceso dueño de cada acción
+  int actionResource[MAX_EVENTS]; // Índice del recurso de cada acción
+  bool actionProcessed[MAX_EVENTS];
+
+  bool holds[MAX_PROCESSES][MAX_PROCESSES]; // holds[p][r]: el proceso p retiene el recurso r
+  int blockedOn[MAX_PROCESSES];             // Recurso por el que espera el proceso (-1 si no espera)
+  int effectivePriority[MAX_PROCESSES];     // Prioridad efectiva (heredada o base)
+  int resourceCeiling[MAX_PROCESSES];       // Techo de prioridad de cada recurso
+
+  int inversionTime[MAX_PROCESSES];
+  int inversionStreak[MAX_PROCESSES];
+  int longestInversion[MAX_PROCESSES];
+} SyncState;
 
 void initializeResources(Resource *resources, int resourceCount);
 
+/**
+ * Funciones auxiliares compartidas por las simulaciones que usan recursos
+ */
+void initializeSyncState(SyncState *s, Process *processes, int processCount,
+                         Resource *resources, int resourceCount,
+                         Action *actions, int actionCount,
+                         SyncConfig *config);
+int findNextAction(const SyncState *s, int processIdx, int cycle);
+bool hasPendingActions(const SyncState *s, int processIdx);
+int grantResource(SyncState *s, int processIdx, int resIdx, int *blockingRes);
+int releaseHeldResources(SyncState *s, int processIdx);
+void updateEffectivePriorities(SyncState *s);
+bool isPriorityInverted(const SyncState *s, int waiterIdx, int resIdx);
+
+// Acciones del proceso `pid` con recurso válido, ordenadas por ciclo (orden estable del archivo):
+// llena `cycles` y `resourceIdx` (hasta MAX_EVENTS) y devuelve cuántas son
+int collectProcessActions(const char *pid, const Resource *resources, int resourceCount,
+                          const Action *actions, int actionCount, int *cycles, int *resourceIdx);
+
+// Registra la ocupación de cada recurso en el ciclo, antes de liberar lo retenido (telemetría por ventana).
+// `waitingOn` indica el recurso por el que esperó cada proceso en el ciclo (-1: ninguno).
+void sampleResourceTelemetry(const SyncState *s, const int *waitingOn, int cycle);
+
+// Agrega a `regions` los arreglos del estado que cambian durante la simulación (para los
+// snapshots); devuelve la cantidad agregada, SYNC_STATE_REGIONS
+#define SYNC_STATE_REGIONS 9
+int addSyncStateRegions(SyncState *s, CheckpointRegion *regions);
+
 /**
  * Ejecuta la simulación sincronizada, usando mutex o semáforo.
- * @param useMutex 1 si es con mutex, 0 si es con semáforo
+ *
+ * Un proceso retiene los recursos adquiridos mientras encadene acciones en ciclos consecutivos
+ * (sección crítica). Con `priorityQueue` activo, las acciones que no obtienen el recurso quedan
+ * en espera y se atienden por prioridad efectiva; `protocol` define si los poseedores heredan
+ * prioridad (herencia) o si se aplica el techo de prioridad de cada recurso.
+ *
+ * @param config Configuración de la sincronización (mecanismo, colas y protocolo).
  */
 void simulateSynchronization(Process *processes, int processCount,
                              Resource *resources, int resourceCount,
                              Action *actions, int actionCount,
                              TimelineEvent *events, int *eventCount,
-                             int useMutex);
+                             SyncConfig *config);
 
 #endif
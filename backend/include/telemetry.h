@@ -0,0 +1,32 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include "simulator.h"
+
+/**
+ * Series de tiempo por ventana: cada `window` ciclos se emite un evento TELEMETRY con el largo de
+ * la cola de listos, los procesos en ejecución y en espera, la fracción de ciclos con CPU ocupada,
+ * las llegadas y terminaciones y, en sincronización, la ocupación de cada recurso.
+ *
+ * Los valores se acumulan a partir de los mismos eventos de la línea de tiempo, con memoria
+ * proporcional a la cantidad de procesos y recursos (no a la duración de la simulación).
+ *
+ * @param window    Ciclos por ventana (0: sin telemetría).
+ * @param processes Arreglo de procesos que recibirá la simulación.
+ * @param resources Recursos de la simulación de sincronización (NULL y 0 en calendarización).
+ */
+void configureTelemetry(int window, const Process *processes, int processCount,
+                        const Resource *resources, int resourceCount);
+
+int telemetryActive(void);
+
+// Registra el estado de un proceso en un ciclo (se llama junto con cada evento de la línea de tiempo)
+void telemetryProcessEvent(const Process *process, int cycle, ProcessState state, ActionType action);
+
+// Registra la ocupación de un recurso en un ciclo: procesos que lo retienen y que esperan por él
+void telemetryResourceSample(int cycle, int resource, int holders, int waiters);
+
+// Emite la última ventana (incompleta) y desactiva la telemetría
+void finishTelemetry(void);
+
+#endif
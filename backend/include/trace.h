@@ -0,0 +1,38 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include "simulator.h"
+
+#define TRACE_OUTPUT_DIR "../data/output"
+#define DEFAULT_TRACE_PATH TRACE_OUTPUT_DIR "/trace.json"
+#define TRACE_CYCLE_US 1000 // Un ciclo simulado equivale a 1 ms en la traza
+
+/**
+ * Abre la traza de la próxima simulación en formato Chrome Trace Event (arreglo JSON que Perfetto
+ * y chrome://tracing abren directamente). Cada proceso es un track; los rangos WAITING y ACCESSED
+ * consecutivos se agrupan en slices, NEW/TERMINATED/OMITED son eventos instantáneos, cada acción de
+ * sincronización que espera se une a su acceso con un flow y las métricas son counters.
+ *
+ * La traza se escribe a medida que avanza la simulación con memoria constante (un slice abierto y
+ * un flow pendiente por proceso), sin importar la cantidad de eventos.
+ *
+ * @param path      Archivo de salida (NULL o vacío: DEFAULT_TRACE_PATH).
+ * @param title     Nombre de la simulación en la traza.
+ * @param processes Arreglo de procesos que recibirá la simulación (identifica los tracks).
+ * @return 0 si se abrió el archivo, -1 si no.
+ */
+int openTrace(const char *path, const char *title, const Process *processes, int processCount);
+
+// Registra el estado de un proceso en un ciclo (se llama junto con cada evento de la línea de tiempo)
+void traceProcessEvent(const Process *process, int cycle, ProcessState state, ActionType action);
+
+// Registra las métricas de un proceso que terminó
+void traceProcessMetric(const Process *process);
+
+// Registra el tiempo total en inversión de prioridad de un proceso
+void traceInversionMetric(const Process *process, int inversionTime);
+
+// Cierra los slices abiertos y el archivo de la traza
+void closeTrace(void);
+
+#endif
@@ -0,0 +1,57 @@
+#ifndef TRACE_IMPORT_H
+#define TRACE_IMPORT_H
+
+#include <stdio.h>
+
+#define IMPORT_MAX_TASKS 16384   // Tareas listas o en ejecución a la vez (las bloqueadas no se guardan)
+#define IMPORT_MAX_PENDING 65536 // Trabajos guardados hasta poder escribirlos en orden de llegada
+#define IMPORT_MAX_TID 4194304   // PID_MAX_LIMIT del kernel: tids con contador de activaciones
+
+/**
+ * Totales de la última importación. Los tiempos del kernel están en microsegundos; los promedios del
+ * resumen se expresan en ciclos para compararlos con la simulación.
+ */
+typedef struct
+{
+  long lines;          // Líneas leídas
+  long events;         // Eventos sched_switch, sched_wakeup(_new) y sched_process_exit usados
+  long ignored;        // Líneas de esos eventos que no se pudieron parsear
+  long jobs;           // Trabajos escritos
+  long cut;            // Trabajos cortados porque la cola de trabajos pendientes se llenó
+  long unfinished;     // Trabajos sin terminar al final de la traza (no se escriben)
+  long skippedTasks;   // Activaciones descartadas con la tabla de tareas llena
+  int maxTasks;        // Máximo de tareas listas o en ejecución a la vez
+  int cpus;            // CPUs distintas vistas en la traza
+  long cycles;         // Duración de la traza en ciclos
+  long cpuCycles;      // Suma de las ráfagas escritas (redondeadas a ciclos)
+  double spanUs;       // Duración de la traza
+  double cpuUs;        // Tiempo en CPU de los trabajos escritos
+  double waitingUs;    // Suma de (fin - llegada - CPU) de los trabajos escritos
+  double turnaroundUs; // Suma de (fin - llegada) de los trabajos escritos
+} ImportStats;
+
+/**
+ * Convierte una traza de texto del planificador de Linux en procesos con el formato de procesos.txt.
+ * Acepta la salida de `perf sched script` (campos clave=valor o formato compacto "comm:pid [prio]")
+ * y las líneas sched_switch / sched_wakeup / sched_wakeup_new / sched_process_exit de ftrace.
+ *
+ * Cada trabajo es una activación de una tarea: llega cuando la tarea despierta (o cuando se la ve
+ * lista por primera vez), acumula el tiempo en CPU entre sched_switch y termina cuando la tarea deja
+ * la CPU bloqueada o sale. La prioridad sale de `prio`: 0 para tiempo real y prio - 99 (de 1 a 40,
+ * nice -20 a 19) para las demás. El pid de cada trabajo es "tid.n", la n-ésima activación de la
+ * tarea; si no entra en COMMON_MAX_LEN - 1 caracteres es "x" seguido del número de trabajo en
+ * hexadecimal, que tampoco se repite.
+ *
+ * La traza se lee en una sola pasada. Solo se guardan las tareas listas o en ejecución y los
+ * trabajos que todavía no se pueden escribir en orden de llegada, así que la memoria no depende del
+ * largo de la traza. Si la cola de pendientes se llena, el trabajo más antiguo se corta: se escribe
+ * con lo que lleva y la tarea sigue en un trabajo nuevo.
+ *
+ * @param cycleUs Microsegundos por ciclo simulado.
+ * @return Trabajos escritos.
+ */
+long importSchedTrace(FILE *in, FILE *out, int cycleUs);
+
+ImportStats getImportStats(void);
+
+#endif
@@ -0,0 +1,57 @@
+#ifndef TUNER_H
+#define TUNER_H
+
+#include "simulator.h"
+
+#define TUNE_DEFAULT_POINTS 16 // Quantums evaluados por pasada de la búsqueda
+#define TUNE_MIN_POINTS 3      // Con menos puntos los vecinos del mejor cubren todo el rango
+#define TUNE_MAX_WORKERS 16    // Procesos que simulan en paralelo
+
+/**
+ * Métrica que minimiza la búsqueda del quantum
+ */
+typedef enum
+{
+  TUNE_WAITING,         // Espera promedio
+  TUNE_TURNAROUND,      // Retorno promedio (fin - llegada)
+  TUNE_RESPONSE,        // Respuesta promedio (primer despacho - llegada)
+  TUNE_P99_RESPONSE,    // Percentil 99 de la respuesta
+  TUNE_SWITCH_OVERHEAD  // Fracción de la CPU perdida en cambios de contexto (requiere costo de cambio)
+} TuneObjective;
+
+/**
+ * Búsqueda del quantum de RR pedida con "tune" en la configuración de la sesión.
+ */
+typedef struct
+{
+  int active;
+  TuneObjective objective;
+  int minQuantum;  // Límite inferior (por defecto 1)
+  int maxQuantum;  // Límite superior (0: la ráfaga más larga de la carga)
+  int points;      // Quantums por pasada (0: TUNE_DEFAULT_POINTS, al menos TUNE_MIN_POINTS)
+  int perPriority; // 1: ajustar además el quantum de cada prioridad de la carga
+  int workers;     // Procesos en paralelo (0: uno por CPU, hasta TUNE_MAX_WORKERS)
+} TuneSettings;
+
+// Traduce el nombre del objetivo ("waiting", "turnaround", "response", "p99Response", "switchOverhead"); -1 si no existe
+int parseTuneObjective(const char *name);
+
+/**
+ * Busca el quantum de RR que minimiza el objetivo sobre la carga, simulando sin salida ni retardo.
+ *
+ * La búsqueda va de lo grueso a lo fino: evalúa `points` quantums repartidos en el rango, se queda
+ * con el mejor y repite entre sus vecinos hasta que el paso es 1. Cada pasada reparte las
+ * simulaciones entre procesos hijos. Con `perPriority` ajusta después, una por una, las prioridades
+ * presentes en la carga con el resto fijo.
+ *
+ * Emite un evento TUNE_POINT por quantum evaluado (la curva del objetivo, ordenada) y al final
+ * TUNE_RESULT con la recomendación.
+ *
+ * @param processes Procesos de la carga (no se modifican).
+ * @param config    Configuración de RR de la sesión (costo de cambio y quantums por prioridad fijos).
+ * @return 0 si la búsqueda terminó, -1 si los parámetros no son válidos.
+ */
+int runQuantumTuning(const TuneSettings *settings, const Process *processes, int processCount,
+                     const SimulationConfig *config);
+
+#endif
@@ -0,0 +1,410 @@
+#include "batch.h"
+#include "session.h"
+#include "share.h"
+#include "io.h"
+#include "dag.h"
+#include <stdlib.h>
+#include <string.h>
+#include <glob.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <cjson/cJSON.h>
+
+static const char *statusNames[] = {"ok", "empty", "invalid", "badConfig", "unsupported"};
+
+/**
+ * Matriz que reparte runBatch: la corrida `job` es la carga job / configCount con la configuración
+ * job % configCount
+ */
+typedef struct
+{
+  char (*paths)[BATCH_PATH_LEN];
+  const BatchConfig *configs;
+  int configCount;
+} BatchMatrix;
+
+// ======================== CARGAS Y CONFIGURACIONES ========================
+
+static int comparePaths(const void *a, const void *b)
+{
+  return strcmp((const char *)a, (const char *)b);
+}
+
+static int isDirectory(const char *path)
+{
+  struct stat st;
+  return stat(path, &st) == 0 && S_ISDIR(st.st_mode);
+}
+
+static int isRegularFile(const char *path)
+{
+  struct stat st;
+  return stat(path, &st) == 0 && S_ISREG(st.st_mode);
+}
+
+// Agrega una ruta al arreglo dinámico de cargas
+static int appendPath(char (**paths)[BATCH_PATH_LEN], int *count, int *capacity, const char *path)
+{
+  if (*count == *capacity)
+  {
+    int next = *capacity ? *capacity * 2 : 16;
+    char(*grown)[BATCH_PATH_LEN] = realloc(*paths, sizeof(**paths) * next);
+    if (!grown)
+      return -1;
+    *paths = grown;
+    *capacity = next;
+  }
+  snprintf((*paths)[(*count)++], BATCH_PATH_LEN, "%s", path);
+  return 0;
+}
+
+int findBatchWorkloads(const char *spec, char (**paths)[BATCH_PATH_LEN])
+{
+  int count = 0, capacity = 0;
+  *paths = NULL;
+
+  if (strpbrk(spec, "*?["))
+  {
+    glob_t matches;
+    if (glob(spec, 0, NULL, &matches) != 0)
+      return 0;
+    for (size_t i = 0; i < matches.gl_pathc; i++)
+      appendPath(paths, &count, &capacity, matches.gl_pathv[i]);
+    globfree(&matches);
+    return count; // glob ya ordena las rutas
+  }
+
+  if (isRegularFile(spec))
+    return appendPath(paths, &count, &capacity, spec) == 0 ? 1 : -1;
+
+  DIR *dir = opendir(spec);
+  if (!dir)
+    return -1;
+
+  struct dirent *entry;
+  char path[BATCH_PATH_LEN];
+  while ((entry = readdir(dir)) != NULL)
+  {
+    if (entry->d_name[0] == '.')
+      continue;
+    snprintf(path, sizeof(path), "%s/%s", spec, entry->d_name);
+
+    size_t length = strlen(entry->d_name);
+    int isText = length > 4 && strcmp(entry->d_name + length - 4, ".txt") == 0;
+    if (isText && isRegularFile(path))
+    {
+      appendPath(paths, &count, &capacity, path);
+    }
+    else if (isDirectory(path))
+    {
+      // Un subdirectorio cuenta si tiene la estructura del directorio de entrada
+      char processesPath[BATCH_PATH_LEN + 16];
+      snprintf(processesPath, sizeof(processesPath), "%s/procesos.txt", path);
+      if (isRegularFile(processesPath))
+        appendPath(paths, &count, &capacity, path);
+    }
+  }
+  closedir(dir);
+
+  if (count > 1)
+    qsort(*paths, count, BATCH_PATH_LEN, comparePaths);
+  return count;
+}
+
+// Lee un archivo completo (liberar con free); NULL si no se puede abrir
+static char *readWholeFile(const char *path)
+{
+  FILE *file = fopen(path, "r");
+  if (!file)
+    return NULL;
+
+  size_t capacity = 4096, length = 0, n;
+  char *text = malloc(capacity);
+  while (text && (n = fread(text + length, 1, capacity - length - 1, file)) > 0)
+  {
+    length += n;
+    if (length + 1 == capacity)
+    {
+      char *grown = realloc(text, capacity * 2);
+      if (!grown)
+      {
+        free(text);
+        text = NULL;
+        break;
+      }
+      text = grown;
+      capacity *= 2;
+    }
+  }
+  fclose(file);
+  if (text)
+    text[length] = '\0';
+  return text;
+}
+
+static int appendConfig(BatchConfig **configs, int *count, int *capacity, char *line)
+{
+  if (*count == *capacity)
+  {
+    int next = *capacity ? *capacity * 2 : 8;
+    BatchConfig *grown = realloc(*configs, sizeof(BatchConfig) * next);
+    if (!grown)
+    {
+      free(line);
+      return -1;
+    }
+    *configs = grown;
+    *capacity = next;
+  }
+
+  BatchConfig *config = &(*configs)[*count];
+  memset(config, 0, sizeof(*config));
+  config->line = line;
+  config->config.algorithm = ALGO_NONE;
+  config->config.quantum = 1;
+  config->valid = parseSimulationConfig(line, &config->config) == 0 && config->config.algorithm != ALGO_NONE;
+
+  // Nombre de la configuración en los resultados
+  cJSON *json = cJSON_Parse(line);
+  const cJSON *name = json ? cJSON_GetObjectItemCaseSensitive(json, "name") : NULL;
+  if (cJSON_IsString(name) && name->valuestring)
+    snprintf(config->name, sizeof(config->name), "%s", name->valuestring);
+  else
+    snprintf(config->name, sizeof(config->name), "%d", *count + 1);
+  cJSON_Delete(json);
+
+  (*count)++;
+  return 0;
+}
+
+int loadBatchConfigs(const char *spec, BatchConfig **configs)
+{
+  int count = 0, capacity = 0;
+  *configs = NULL;
+
+  const char *start = spec + strspn(spec, " \t\r\n");
+  char *text = (*start == '{' || *start == '[') ? strdup(start) : readWholeFile(spec);
+  if (!text)
+    return -1;
+
+  char *body = text + strspn(text, " \t\r\n");
+  if (*body == '[')
+  {
+    // Arreglo JSON de configuraciones
+    cJSON *array = cJSON_Parse(body);
+    const cJSON *item = NULL;
+    if (!cJSON_IsArray(array))
+    {
+      cJSON_Delete(array);
+      free(text);
+      return -1;
+    }
+    cJSON_ArrayForEach(item, array)
+    {
+      char *line = cJSON_PrintUnformatted(item);
+      if (line)
+        appendConfig(configs, &count, &capacity, line);
+    }
+    cJSON_Delete(array);
+  }
+  else
+  {
+    // Una configuración por línea; las vacías y las que empiezan con '#' se saltan
+    for (char *line = strtok(body, "\n"); line; line = strtok(NULL, "\n"))
+    {
+      line[strcspn(line, "\r")] = '\0';
+      line += strspn(line, " \t");
+      if (*line == '\0' || *line == '#')
+        continue;
+      char *copy = strdup(line);
+      if (copy)
+        appendConfig(configs, &count, &capacity, copy);
+    }
+  }
+
+  free(text);
+  return count;
+}
+
+void freeBatchConfigs(BatchConfig *configs, int count)
+{
+  for (int i = 0; i < count; i++)
+    free(configs[i].line);
+  free(configs);
+}
+
+// ======================== SIMULACIÓN ========================
+
+// Carga un directorio de entrada o un archivo con el formato de procesos.txt
+static void loadBatchWorkload(const char *path, Workload *workload)
+{
+  if (isDirectory(path))
+  {
+    loadWorkload(workload, path);
+    return;
+  }
+
+  memset(workload, 0, sizeof(*workload));
+  workload->processCount = loadProcesses(path, workload->processes, MAX_PROCESSES);
+  if (workload->processCount < 0)
+    workload->processCount = 0;
+  loadBurstSequences(path, workload->processes, workload->bursts, workload->processCount,
+                     workload->devices, &workload->deviceCount);
+}
+
+// Simula la corrida `job` de la matriz, con la salida silenciada
+static void simulateJob(int job, void *result, void *context)
+{
+  static Workload workload;
+  static Process processes[MAX_PROCESSES];
+  const BatchMatrix *matrix = context;
+  const char *path = matrix->paths[job / matrix->configCount];
+  const BatchConfig *config = &matrix->configs[job % matrix->configCount];
+  BatchMetrics *metrics = result;
+
+  memset(metrics, 0, sizeof(*metrics));
+  if (!config->valid)
+  {
+    metrics->status = BATCH_BAD_CONFIG;
+    return;
+  }
+
+  loadBatchWorkload(path, &workload);
+  int processCount = workload.processCount;
+  metrics->processes = processCount;
+  if (processCount == 0)
+  {
+    metrics->status = BATCH_EMPTY;
+    return;
+  }
+
+  // Una ráfaga de 0 ciclos nunca termina en algunos algoritmos: la carga se informa sin simular
+  long cpuCycles = 0;
+  for (int i = 0; i < processCount; i++)
+  {
+    if (workload.processes[i].burstTime <= 0)
+    {
+      metrics->status = BATCH_INVALID;
+      return;
+    }
+    cpuCycles += workload.processes[i].burstTime;
+  }
+
+  memcpy(processes, workload.processes, sizeof(Process) * processCount);
+  configureIO(workload.bursts, processCount, workload.devices, workload.deviceCount);
+  if (configureDependencies(workload.predecessors, processes, processCount) != 0)
+  {
+    metrics->status = BATCH_INVALID;
+    return;
+  }
+  SimulationControl control = {config->config};
+  setOutputMuted(1);
+  if (runSchedulingEngine(processes, processCount, &control) != 0)
+  {
+    metrics->status = BATCH_UNSUPPORTED;
+    return;
+  }
+
+  measureRun(processes, processCount, &control.config, &metrics->run);
+  if (control.config.algorithm == ALGO_LOTTERY || control.config.algorithm == ALGO_STRIDE)
+    metrics->shareError = getShareError();
+
+  int cycles = metrics->run.cycles;
+  long cpuBusy = ioModelActive() ? getIoStats().cpuBusyCycles : cpuCycles + metrics->run.overheadCycles;
+  if (cycles > 0)
+  {
+    metrics->throughput = (double)processCount / cycles;
+    metrics->cpuUtilization = (double)cpuBusy / cycles;
+  }
+}
+
+void runBatch(char (*paths)[BATCH_PATH_LEN], int workloadCount,
+              const BatchConfig *configs, int configCount, int workers, BatchMetrics *results)
+{
+  BatchMatrix matrix = {paths, configs, configCount};
+  runWorkerPool(workloadCount * configCount, workers, sizeof(BatchMetrics), results, simulateJob, &matrix);
+}
+
+// ======================== RESULTADOS ========================
+
+// Escribe un campo CSV entre comillas si tiene separadores o comillas
+static void writeCsvField(FILE *out, const char *text)
+{
+  if (!strpbrk(text, ",\"\n"))
+  {
+    fputs(text, out);
+    return;
+  }
+  fputc('"', out);
+  for (const char *c = text; *c; c++)
+  {
+    if (*c == '"')
+      fputc('"', out);
+    fputc(*c, out);
+  }
+  fputc('"', out);
+}
+
+void writeBatchCsv(FILE *out, char (*paths)[BATCH_PATH_LEN], int workloadCount,
+                   const BatchConfig *configs, int configCount, const BatchMetrics *results)
+{
+  fprintf(out, "workload,config,algorithm,quantum,isPreemptive,status,processes,cycles,"
+               "averageWaitingTime,averageTurnaround,averageResponse,p99Response,throughput,"
+               "cpuUtilization,contextSwitches,switchOverhead,shareError\n");
+  for (int job = 0; job < workloadCount * configCount; job++)
+  {
+    const BatchConfig *config = &configs[job % configCount];
+    const BatchMetrics *m = &results[job];
+    writeCsvField(out, paths[job / configCount]);
+    fputc(',', out);
+    writeCsvField(out, config->name);
+    fprintf(out, ",%s,%d,%d,%s,%d,%d,%.2f,%.2f,%.2f,%.2f,%.4f,%.4f,%d,%.4f,%.4f\n",
+            getAlgorithmName(config->config.algorithm), config->config.quantum, config->config.isPreemptive,
+            statusNames[m->status], m->processes, m->run.cycles, m->run.waiting, m->run.turnaround,
+            m->run.response, m->run.p99Response, m->throughput, m->cpuUtilization, m->run.switches,
+            m->run.switchOverhead, m->shareError);
+  }
+}
+
+// Escribe una cadena JSON entre comillas, escapando comillas, barras y caracteres de control
+static void writeJsonString(FILE *out, const char *text)
+{
+  fputc('"', out);
+  for (const unsigned char *c = (const unsigned char *)text; *c; c++)
+  {
+    if (*c == '"' || *c == '\\')
+      fprintf(out, "\\%c", *c);
+    else if (*c < 0x20)
+      fprintf(out, "\\u%04x", *c);
+    else
+      fputc(*c, out);
+  }
+  fputc('"', out);
+}
+
+void writeBatchJson(FILE *out, char (*paths)[BATCH_PATH_LEN], int workloadCount,
+                    const BatchConfig *configs, int configCount, const BatchMetrics *results)
+{
+  fputs("[\n", out);
+  for (int job = 0; job < workloadCount * configCount; job++)
+  {
+    const BatchConfig *config = &configs[job % configCount];
+    const BatchMetrics *m = &results[job];
+
+    fputs("  {\"workload\": ", out);
+    writeJsonString(out, paths[job / configCount]);
+    fputs(", \"config\": ", out);
+    writeJsonString(out, config->name);
+    fprintf(out,
+            ", \"algorithm\": \"%s\", \"quantum\": %d, \"isPreemptive\": %d, "
+            "\"status\": \"%s\", \"processes\": %d, \"cycles\": %d, \"averageWaitingTime\": %.2f, "
+            "\"averageTurnaround\": %.2f, \"averageResponse\": %.2f, \"p99Response\": %.2f, "
+            "\"throughput\": %.4f, \"cpuUtilization\": %.4f, \"contextSwitches\": %d, \"switchOverhead\": %.4f, "
+            "\"shareError\": %.4f}%s\n",
+            getAlgorithmName(config->config.algorithm), config->config.quantum,
+            config->config.isPreemptive, statusNames[m->status], m->processes, m->run.cycles, m->run.waiting,
+            m->run.turnaround, m->run.response, m->run.p99Response, m->throughput, m->cpuUtilization,
+            m->run.switches, m->run.switchOverhead, m->shareError, job + 1 < workloadCount * configCount ? "," : "");
+  }
+  fputs("]\n", out);
+}
@@ -0,0 +1,477 @@
+#include "checkpoint.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#define CHECKPOINT_MAGIC "SCKP"
+#define CHECKPOINT_VERSION 2
+
+/**
+ * Encabezado del archivo de snapshots. Le siguen `recordCount` registros de tamaño fijo: el ciclo
+ * (int) y el estado serializado (`stateSize` bytes). El registro k corresponde al ciclo k * interval,
+ * así que el snapshot más cercano a un ciclo se ubica directamente con fseek. Al final van los
+ * `processCount` procesos con sus métricas finales (resultado de la corrida).
+ */
+typedef struct
+{
+  char magic[4];
+  int version;
+  int interval;
+  int recordCount;
+  int finalCycle;
+  int processCount;
+  unsigned long long key;
+  unsigned long long stateSize;
+} CheckpointHeader;
+
+/**
+ * Estado de los snapshots de la simulación en curso.
+ */
+static struct
+{
+  int configured;
+  int interval;
+  int seekCycle;
+  unsigned long long key;
+  char path[512];
+  char tempPath[560];
+
+  FILE *writer;            // Archivo en escritura (NULL si ya existe completo o no hay snapshots)
+  CheckpointHeader header; // Encabezado del archivo en escritura
+  int nextCycle;           // Ciclo del próximo snapshot
+  unsigned char *buffer;   // Estado serializado
+  size_t bufferSize;
+
+  int whatIf;          // Variante de otra corrida (path es el archivo de la corrida base)
+  int divergenceCycle; // Primer ciclo en el que la variante puede diferir
+
+  int muted;         // Salida silenciada hasta alcanzar seekCycle (o hasta el final en un what-if)
+  int snapshotCycle; // Ciclo del snapshot restaurado (-1: desde el inicio)
+  int finalCycle;    // Ciclo final de la simulación (-1 mientras corre)
+  const Process *processes;
+  int processCount;
+} ckpt = {.snapshotCycle = -1, .finalCycle = -1};
+
+unsigned long long checkpointKey(unsigned long long key, const void *data, size_t size)
+{
+  const unsigned char *bytes = data;
+  for (size_t i = 0; i < size; i++)
+  {
+    key ^= bytes[i];
+    key *= 1099511628211ULL;
+  }
+  return key;
+}
+
+// Crea el directorio y sus padres si no existen
+static int makeDirectories(const char *directory)
+{
+  char path[512];
+  snprintf(path, sizeof(path), "%s", directory);
+
+  for (char *p = path + 1; *p; p++)
+  {
+    if (*p != '/')
+      continue;
+    *p = '\0';
+    if (mkdir(path, 0755) != 0 && errno != EEXIST)
+      return -1;
+    *p = '/';
+  }
+  return mkdir(path, 0755) != 0 && errno != EEXIST ? -1 : 0;
+}
+
+static const char *checkpointDirectory(const char *directory)
+{
+  return directory && directory[0] ? directory : DEFAULT_CHECKPOINT_DIR;
+}
+
+static void checkpointPath(char *path, size_t size, const char *directory, unsigned long long key)
+{
+  snprintf(path, size, "%s/%016llx.ckpt", checkpointDirectory(directory), key);
+}
+
+static size_t stateSize(const CheckpointRegion *regions, int regionCount)
+{
+  size_t size = 0;
+  for (int i = 0; i < regionCount; i++)
+    size += regions[i].size;
+  return size;
+}
+
+static int ensureBuffer(size_t size)
+{
+  if (size <= ckpt.bufferSize)
+    return 0;
+  unsigned char *grown = realloc(ckpt.buffer, size);
+  if (!grown)
+    return -1;
+  ckpt.buffer = grown;
+  ckpt.bufferSize = size;
+  return 0;
+}
+
+static void serializeRegions(const CheckpointRegion *regions, int regionCount, unsigned char *buffer)
+{
+  size_t at = 0;
+  for (int i = 0; i < regionCount; i++)
+  {
+    memcpy(buffer + at, regions[i].data, regions[i].size);
+    at += regions[i].size;
+  }
+}
+
+static void restoreRegions(const CheckpointRegion *regions, int regionCount, const unsigned char *buffer)
+{
+  size_t at = 0;
+  for (int i = 0; i < regionCount; i++)
+  {
+    memcpy(regions[i].data, buffer + at, regions[i].size);
+    at += regions[i].size;
+  }
+}
+
+// Reinicia el estado común a configureCheckpoints y configureWhatIf
+static void resetCheckpoints(unsigned long long key)
+{
+  ckpt.configured = 1;
+  ckpt.key = key;
+  ckpt.writer = NULL;
+  ckpt.whatIf = 0;
+  ckpt.divergenceCycle = 0;
+  ckpt.snapshotCycle = -1;
+  ckpt.finalCycle = -1;
+  ckpt.processes = NULL;
+  ckpt.processCount = 0;
+}
+
+void configureCheckpoints(int interval, int seekCycle, const char *directory, unsigned long long key)
+{
+  resetCheckpoints(key);
+  ckpt.seekCycle = seekCycle > 0 ? seekCycle : 0;
+  ckpt.interval = interval > 0 ? interval : (ckpt.seekCycle > 0 ? DEFAULT_CHECKPOINT_INTERVAL : 0);
+
+  checkpointPath(ckpt.path, sizeof(ckpt.path), directory, key);
+  snprintf(ckpt.tempPath, sizeof(ckpt.tempPath), "%s.tmp.%d", ckpt.path, (int)getpid());
+  if (ckpt.interval > 0 && makeDirectories(checkpointDirectory(directory)) != 0)
+    fprintf(stderr, "No se pudo crear el directorio de snapshots %s.\n", checkpointDirectory(directory));
+
+  // Con seek la salida se silencia hasta llegar al ciclo pedido
+  ckpt.muted = ckpt.seekCycle > 0;
+  setOutputMuted(ckpt.muted);
+}
+
+void configureWhatIf(const char *directory, unsigned long long baseKey, int divergenceCycle)
+{
+  resetCheckpoints(baseKey);
+  ckpt.whatIf = 1;
+  ckpt.divergenceCycle = divergenceCycle > 0 ? divergenceCycle : 0;
+  ckpt.interval = 0;
+  ckpt.seekCycle = 0;
+  checkpointPath(ckpt.path, sizeof(ckpt.path), directory, baseKey);
+
+  // La variante solo se informa como diferencia de métricas
+  ckpt.muted = 1;
+  setOutputMuted(1);
+}
+
+// Abre el archivo completo de una corrida; con stateSize 0 no se valida el tamaño del estado
+static FILE *openCheckpointFile(const char *path, unsigned long long key, size_t size, CheckpointHeader *h)
+{
+  FILE *f = fopen(path, "rb");
+  if (!f)
+    return NULL;
+
+  int valid = fread(h, sizeof(*h), 1, f) == 1 &&
+              memcmp(h->magic, CHECKPOINT_MAGIC, 4) == 0 &&
+              h->version == CHECKPOINT_VERSION &&
+              h->key == key &&
+              (size == 0 || h->stateSize == size) &&
+              h->interval > 0 && h->recordCount > 0 && h->finalCycle >= 0;
+  if (!valid)
+  {
+    fclose(f);
+    return NULL;
+  }
+  return f;
+}
+
+// Lee el registro `slot` en `buffer`; devuelve su ciclo o -1 si falla la lectura
+static int readRecord(FILE *f, const CheckpointHeader *h, int slot, unsigned char *buffer)
+{
+  int cycle = -1;
+  long offset = (long)sizeof(*h) + (long)slot * (long)(sizeof(int) + h->stateSize);
+  if (fseek(f, offset, SEEK_SET) != 0 ||
+      fread(&cycle, sizeof(int), 1, f) != 1 ||
+      fread(buffer, h->stateSize, 1, f) != 1)
+    return -1;
+  return cycle;
+}
+
+int readCheckpointResult(const char *directory, unsigned long long key,
+                         Process *processes, int processCount, int *finalCycle)
+{
+  char path[512];
+  checkpointPath(path, sizeof(path), directory, key);
+
+  CheckpointHeader h;
+  FILE *f = openCheckpointFile(path, key, 0, &h);
+  if (!f)
+    return -1;
+
+  long offset = (long)sizeof(h) + (long)h.recordCount * (long)(sizeof(int) + h.stateSize);
+  int ok = h.processCount == processCount &&
+           fseek(f, offset, SEEK_SET) == 0 &&
+           fread(processes, sizeof(Process), processCount, f) == (size_t)processCount;
+  fclose(f);
+
+  if (!ok)
+    return -1;
+  if (finalCycle)
+    *finalCycle = h.finalCycle;
+  return 0;
+}
+
+// Lee el snapshot más cercano del archivo completo de la corrida; -1 si no existe o no corresponde
+static int readSnapshot(const CheckpointRegion *regions, int regionCount, size_t size)
+{
+  CheckpointHeader h;
+  FILE *f = openCheckpointFile(ckpt.path, ckpt.key, size, &h);
+  if (!f)
+    return -1;
+
+  // El archivo existe completo: no se vuelve a escribir
+  ckpt.interval = 0;
+  if (ckpt.seekCycle == 0 || ensureBuffer(size) != 0)
+  {
+    fclose(f);
+    return -2;
+  }
+
+  int slot = ckpt.seekCycle / h.interval;
+  if (slot >= h.recordCount)
+    slot = h.recordCount - 1;
+
+  int cycle = readRecord(f, &h, slot, ckpt.buffer);
+  fclose(f);
+  if (cycle < 0)
+    return -2;
+
+  restoreRegions(regions, regionCount, ckpt.buffer);
+  return cycle;
+}
+
+/**
+ * Restaura el estado de la variante desde la corrida base. Los bytes en que difieren los estados
+ * iniciales (registro 0 de la base y estado actual) corresponden a los procesos modificados; se
+ * toman de la variante, y el resto del snapshot de la base. Es válido mientras la base no haya
+ * tocado esos bytes, lo que se verifica retrocediendo de snapshot si hace falta.
+ */
+static int readWhatIfSnapshot(const CheckpointRegion *regions, int regionCount, size_t size)
+{
+  CheckpointHeader h;
+  FILE *f = openCheckpointFile(ckpt.path, ckpt.key, size, &h);
+  if (!f)
+    return -1;
+
+  unsigned char *initial = malloc(size * 3);
+  if (!initial)
+  {
+    fclose(f);
+    return -1;
+  }
+  unsigned char *current = initial + size;
+  unsigned char *record = current + size;
+  serializeRegions(regions, regionCount, current);
+
+  int cycle = -1;
+  if (readRecord(f, &h, 0, initial) == 0)
+  {
+    int slot = ckpt.divergenceCycle / h.interval;
+    if (slot >= h.recordCount)
+      slot = h.recordCount - 1;
+
+    for (; slot >= 0 && cycle < 0; slot--)
+    {
+      int recordCycle = readRecord(f, &h, slot, record);
+      if (recordCycle < 0 || recordCycle > ckpt.divergenceCycle)
+        continue;
+
+      size_t b = 0;
+      while (b < size && (current[b] == initial[b] || record[b] == initial[b]))
+        b++;
+      if (b == size)
+        cycle = recordCycle;
+    }
+  }
+  fclose(f);
+
+  if (cycle >= 0)
+  {
+    for (size_t b = 0; b < size; b++)
+    {
+      if (current[b] != initial[b])
+        record[b] = current[b];
+    }
+    restoreRegions(regions, regionCount, record);
+  }
+  free(initial);
+  return cycle;
+}
+
+int restoreCheckpoint(const CheckpointRegion *regions, int regionCount)
+{
+  if (!ckpt.configured || (ckpt.interval == 0 && ckpt.seekCycle == 0 && !ckpt.whatIf))
+    return -1;
+
+  size_t size = stateSize(regions, regionCount);
+  int cycle = ckpt.whatIf ? readWhatIfSnapshot(regions, regionCount, size)
+                          : readSnapshot(regions, regionCount, size);
+  if (cycle >= 0)
+  {
+    ckpt.snapshotCycle = cycle;
+    return cycle;
+  }
+  if (cycle == -2 || ckpt.interval == 0)
+    return -1;
+
+  // Sin archivo completo: esta corrida lo escribe (en un archivo temporal hasta terminar)
+  ckpt.writer = fopen(ckpt.tempPath, "w+b");
+  if (!ckpt.writer || ensureBuffer(size) != 0)
+  {
+    fprintf(stderr, "No se pudo escribir el archivo de snapshots %s.\n", ckpt.tempPath);
+    if (ckpt.writer)
+      fclose(ckpt.writer);
+    ckpt.writer = NULL;
+    return -1;
+  }
+
+  memset(&ckpt.header, 0, sizeof(ckpt.header));
+  memcpy(ckpt.header.magic, CHECKPOINT_MAGIC, 4);
+  ckpt.header.version = CHECKPOINT_VERSION;
+  ckpt.header.interval = ckpt.interval;
+  ckpt.header.finalCycle = -1;
+  ckpt.header.key = ckpt.key;
+  ckpt.header.stateSize = size;
+  fwrite(&ckpt.header, sizeof(ckpt.header), 1, ckpt.writer);
+  ckpt.nextCycle = 0;
+  return -1;
+}
+
+// Abandona el archivo en escritura (error de disco)
+static void discardWriter(void)
+{
+  fclose(ckpt.writer);
+  unlink(ckpt.tempPath);
+  ckpt.writer = NULL;
+}
+
+// Emite el evento SEEK con el estado (y las métricas parciales) de cada proceso
+static void emitSeekEvent(int cycle)
+{
+  size_t capacity = 256 + (size_t)ckpt.processCount * 192;
+  char *json = malloc(capacity);
+  if (!json)
+    return;
+
+  int replayFrom = ckpt.snapshotCycle > 0 ? ckpt.snapshotCycle : 0;
+  size_t length = snprintf(json, capacity,
+                           "{\"event\": \"SEEK\", \"cycle\": %d, \"snapshotCycle\": %d, \"replayedCycles\": %d, \"processes\": [",
+                           cycle, ckpt.snapshotCycle, cycle - replayFrom);
+  for (int i = 0; i < ckpt.processCount && length < capacity; i++)
+  {
+    const Process *p = &ckpt.processes[i];
+    length += snprintf(json + length, capacity - length,
+                       "%s{\"pid\": \"%s\", \"state\": \"%s\", \"startTime\": %d, \"finishTime\": %d, \"waitingTime\": %d}",
+                       i > 0 ? ", " : "", p->pid, getProcessStateName(p->state),
+                       p->startTime, p->finishTime, p->waitingTime);
+  }
+  if (length < capacity)
+    snprintf(json + length, capacity - length, "]}");
+
+  emitEventLine(json, -1);
+  free(json);
+}
+
+void checkpointCycle(int cycle, const CheckpointRegion *regions, int regionCount,
+                     const Process *processes, int processCount)
+{
+  ckpt.processes = processes;
+  ckpt.processCount = processCount;
+
+  if (ckpt.writer && cycle >= ckpt.nextCycle)
+  {
+    serializeRegions(regions, regionCount, ckpt.buffer);
+    if (fwrite(&cycle, sizeof(int), 1, ckpt.writer) != 1 ||
+        fwrite(ckpt.buffer, ckpt.header.stateSize, 1, ckpt.writer) != 1)
+    {
+      discardWriter();
+    }
+    else
+    {
+      ckpt.header.recordCount++;
+      ckpt.nextCycle = ckpt.header.recordCount * ckpt.interval;
+    }
+  }
+
+  if (ckpt.muted && !ckpt.whatIf && cycle >= ckpt.seekCycle)
+  {
+    ckpt.muted = 0;
+    setOutputMuted(0);
+    emitSeekEvent(cycle);
+  }
+}
+
+void finishCheckpoints(int cycle)
+{
+  ckpt.finalCycle = cycle;
+
+  if (ckpt.writer)
+  {
+    // Agregar el resultado, completar el encabezado y publicar el archivo
+    ckpt.header.finalCycle = cycle;
+    ckpt.header.processCount = ckpt.processCount;
+    if ((ckpt.processCount > 0 &&
+         fwrite(ckpt.processes, sizeof(Process), ckpt.processCount, ckpt.writer) != (size_t)ckpt.processCount) ||
+        fseek(ckpt.writer, 0, SEEK_SET) != 0 ||
+        fwrite(&ckpt.header, sizeof(ckpt.header), 1, ckpt.writer) != 1 ||
+        fclose(ckpt.writer) != 0)
+    {
+      unlink(ckpt.tempPath);
+    }
+    else if (rename(ckpt.tempPath, ckpt.path) != 0)
+    {
+      unlink(ckpt.tempPath);
+    }
+    ckpt.writer = NULL;
+  }
+
+  // El ciclo pedido quedó después del final: se informa el estado final
+  if (ckpt.muted)
+  {
+    ckpt.muted = 0;
+    setOutputMuted(0);
+    if (!ckpt.whatIf)
+      emitSeekEvent(cycle);
+  }
+
+  ckpt.configured = 0;
+  ckpt.interval = 0;
+  ckpt.seekCycle = 0;
+  ckpt.whatIf = 0;
+  ckpt.processes = NULL;
+  ckpt.processCount = 0;
+}
+
+int checkpointRestoredCycle(void)
+{
+  return ckpt.snapshotCycle;
+}
+
+int checkpointFinalCycle(void)
+{
+  return ckpt.finalCycle;
+}
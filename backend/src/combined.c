@@ -0,0 +1,361 @@
+#include "combined.h"
+#include "ready_queue.h"
+#include "synchronization.h"
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <stdbool.h>
+
+/**
+ * Indica si el recurso tiene capacidad disponible según el mecanismo configurado.
+ * Se usa para despertar procesos bloqueados; el reintento puede volver a fallar si otro proceso
+ * toma el recurso antes.
+ */
+static bool isResourceAvailable(const SyncState *s, int resIdx)
+{
+  const Resource *r = &s->resources[resIdx];
+  return s->config->useMutex ? r->isLocked == 0 : r->counter > 0;
+}
+
+/**
+ * Elige el proceso que ocupa la CPU en este ciclo para los algoritmos distintos de RR.
+ * Replica los criterios de selección y desempate de cada algoritmo de calendarización,
+ * usando la prioridad efectiva para que la herencia de prioridad afecte a PS.
+ *
+ * @param eligible  Procesos que llegaron, no terminaron y no están bloqueados.
+ * @param remaining Ráfaga restante de cada proceso.
+ * @param current   Proceso que ejecutó en el ciclo anterior (-1 si ninguno).
+ * @return Índice del proceso elegido o -1 si no hay procesos listos.
+ */
+static int selectProcess(const SyncState *s, const SimulationControl *control,
+                         const bool *eligible, const int *remaining, int current)
+{
+  const Process *p = s->processes;
+  const int *prio = s->effectivePriority;
+  SchedulingAlgorithm algorithm = control->config.algorithm;
+  bool preemptive = algorithm == ALGO_SRT ||
+                    (algorithm == ALGO_PRIORITY && control->config.isPreemptive);
+
+  // Sin expropiación el proceso actual conserva la CPU mientras pueda ejecutar
+  if (!preemptive && current != -1 && eligible[current])
+    return current;
+
+  int best = -1;
+  for (int i = 0; i < s->processCount; i++)
+  {
+    if (!eligible[i])
+      continue;
+
+    if (best == -1)
+    {
+      best = i;
+      continue;
+    }
+
+    switch (algorithm)
+    {
+    case ALGO_FIFO:
+      if (p[i].arrivalTime < p[best].arrivalTime)
+        best = i;
+      break;
+    case ALGO_SJF:
+      if (p[i].burstTime < p[best].burstTime ||
+          (p[i].burstTime == p[best].burstTime && p[i].arrivalTime < p[best].arrivalTime))
+        best = i;
+      break;
+    case ALGO_SRT:
+      if (remaining[i] < remaining[best])
+        best = i;
+      else if (remaining[i] == remaining[best])
+      {
+        // continuar con el proceso que ya estaba ejecutando, luego mayor prioridad
+        if (i == current)
+          best = i;
+        else if (best != current && prio[i] < prio[best])
+          best = i;
+      }
+      break;
+    case ALGO_PRIORITY:
+      if (prio[i] < prio[best] ||
+          (prio[i] == prio[best] &&
+           (p[i].arrivalTime < p[best].arrivalTime ||
+            (p[i].arrivalTime == p[best].arrivalTime && p[i].burstTime < p[best].burstTime))))
+        best = i;
+      break;
+    default:
+      break;
+    }
+  }
+  return best;
+}
+
+// Indica si el proceso sigue en su sección crítica: su próxima acción está programada para `nextCycle`
+// (una acción atrasada no cuenta, se vuelve a pedir el recurso cuando el proceso ejecute)
+static bool continuesCriticalSection(const SyncState *s, int processIdx, int nextCycle)
+{
+  int j = findNextAction(s, processIdx, nextCycle);
+  return j != -1 && s->actions[j].cycle == nextCycle;
+}
+
+// Finaliza un proceso: registra su estado final, libera sus recursos y exporta métricas
+static void finishCombinedProcess(SyncState *s, int processIdx, int cycle, ProcessState state,
+                                  TimelineEvent *events, int *eventCount)
+{
+  Process *p = &s->processes[processIdx];
+  p->state = state;
+  p->finishTime = cycle + 1;
+  p->waitingTime = p->finishTime - p->arrivalTime - p->burstTime;
+  s->blockedOn[processIdx] = -1;
+  releaseHeldResources(s, processIdx);
+
+  printEventForSyncProcess(p, cycle, state, events, eventCount, ACTION_NONE);
+  exportProcessMetric(p);
+  exportInversionMetric(p, s->inversionTime[processIdx], s->longestInversion[processIdx]);
+}
+
+void simulateCombined(Process *processes, int processCount,
+                      Resource *resources, int resourceCount,
+                      Action *actions, int actionCount,
+                      TimelineEvent *events, int *eventCount,
+                      SimulationControl *control, SyncConfig *config)
+{
+  static SyncState state;
+  SyncState *s = &state;
+
+  // Las acciones que no se emiten en su ciclo quedan pendientes hasta que el proceso ejecute
+  config->priorityQueue = 1;
+  initializeSyncState(s, processes, processCount, resources, resourceCount, actions, actionCount, config);
+
+  int currentCycle = 0;
+  int completed = 0;
+  int current = -1; // proceso en CPU
+  int quantumCounter = 0;
+  int remaining[MAX_PROCESSES];
+  bool newPrinted[MAX_PROCESSES] = {false};
+  ReadyQueue rrQueue = {{0}, 0, 0};
+  *eventCount = 0;
+
+  for (int i = 0; i < processCount; i++)
+  {
+    remaining[i] = processes[i].burstTime;
+    processes[i].startTime = -1;
+  }
+
+  // Estado del bucle principal para los snapshots (seek)
+  CheckpointRegion loopRegions[] = {
+      {&currentCycle, sizeof(currentCycle)},
+      {&completed, sizeof(completed)},
+      {&current, sizeof(current)},
+      {&quantumCounter, sizeof(quantumCounter)},
+      {remaining, sizeof(int) * processCount},
+      {newPrinted, sizeof(bool) * processCount},
+      {&rrQueue, sizeof(rrQueue)},
+  };
+  CheckpointRegion regions[CHECKPOINT_REGION_COUNT(loopRegions) + SYNC_STATE_REGIONS];
+  int regionCount = CHECKPOINT_REGION_COUNT(loopRegions);
+  memcpy(regions, loopRegions, sizeof(loopRegions));
+  regionCount += addSyncStateRegions(s, regions + regionCount);
+  restoreCheckpoint(regions, regionCount);
+
+  while (completed < processCount)
+  {
+    checkpointCycle(currentCycle, regions, regionCount, processes, processCount);
+
+    bool eligible[MAX_PROCESSES] = {false};
+    bool invertedThisCycle[MAX_PROCESSES] = {false};
+    bool pendingArrivals = false;
+
+    // Registrar llegadas (NEW) y encolarlas para RR
+    for (int i = 0; i < processCount; i++)
+    {
+      if (processes[i].arrivalTime == currentCycle && !newPrinted[i])
+      {
+        printEventForSyncProcess(&processes[i], currentCycle, STATE_NEW, events, eventCount, ACTION_NONE);
+        newPrinted[i] = true;
+        if (control->config.algorithm == ALGO_RR)
+          enqueueReady(&rrQueue, i);
+      }
+      else if (processes[i].arrivalTime > currentCycle)
+      {
+        pendingArrivals = true;
+      }
+    }
+
+    // Despertar procesos bloqueados cuyo recurso volvió a estar disponible
+    for (int i = 0; i < processCount; i++)
+    {
+      if (s->blockedOn[i] != -1 && isResourceAvailable(s, s->blockedOn[i]))
+      {
+        s->blockedOn[i] = -1;
+        if (control->config.algorithm == ALGO_RR)
+          enqueueReady(&rrQueue, i);
+      }
+    }
+
+    for (int i = 0; i < processCount; i++)
+    {
+      eligible[i] = newPrinted[i] &&
+                    processes[i].state != STATE_TERMINATED &&
+                    processes[i].state != STATE_OMITED &&
+                    s->blockedOn[i] == -1;
+    }
+
+    // Quantum agotado: el proceso vuelve al final de la cola (conserva sus recursos)
+    if (control->config.algorithm == ALGO_RR && current != -1 &&
+        quantumCounter >= getQuantumForPriority(&control->config, processes[current].priority))
+    {
+      enqueueReady(&rrQueue, current);
+      current = -1;
+    }
+
+    // Elegir el proceso en CPU; si su acción pendiente se bloquea, cede la CPU en el mismo ciclo
+    int running = -1;
+    int runningAction = -1;
+    while (running == -1)
+    {
+      int candidate;
+      if (control->config.algorithm == ALGO_RR)
+        candidate = (current != -1 && eligible[current]) ? current : dequeueReady(&rrQueue);
+      else
+        candidate = selectProcess(s, control, eligible, remaining, current);
+
+      if (candidate == -1)
+        break;
+
+      if (candidate != current)
+        quantumCounter = 0;
+
+      int j = findNextAction(s, candidate, currentCycle);
+      int blockingRes;
+      if (j != -1 && !grantResource(s, candidate, s->actionResource[j], &blockingRes))
+      {
+        s->blockedOn[candidate] = blockingRes;
+        eligible[candidate] = false;
+        if (candidate == current)
+          current = -1;
+        continue;
+      }
+
+      running = candidate;
+      runningAction = j;
+    }
+
+    updateEffectivePriorities(s);
+
+    // Registrar WAITING para procesos listos sin CPU y para procesos bloqueados
+    int blockedCount = 0;
+    for (int i = 0; i < processCount; i++)
+    {
+      if (i == running || !newPrinted[i] ||
+          processes[i].state == STATE_TERMINATED || processes[i].state == STATE_OMITED)
+        continue;
+
+      ActionType waitingAction = ACTION_NONE;
+      if (s->blockedOn[i] != -1)
+      {
+        int j = findNextAction(s, i, currentCycle);
+        waitingAction = j != -1 ? actions[j].action : ACTION_NONE;
+        invertedThisCycle[i] = isPriorityInverted(s, i, s->blockedOn[i]);
+        blockedCount++;
+      }
+      printEventForSyncProcess(&processes[i], currentCycle, STATE_WAITING, events, eventCount, waitingAction);
+    }
+
+    for (int i = 0; i < processCount; i++)
+    {
+      if (invertedThisCycle[i])
+      {
+        s->inversionTime[i]++;
+        s->inversionStreak[i]++;
+        if (s->inversionStreak[i] > s->longestInversion[i])
+          s->longestInversion[i] = s->inversionStreak[i];
+      }
+      else
+      {
+        s->inversionStreak[i] = 0;
+      }
+    }
+
+    // Ocupación de los recursos en el ciclo (antes de liberar lo retenido)
+    sampleResourceTelemetry(s, s->blockedOn, currentCycle);
+
+    int releasedCount = 0;
+    if (running != -1)
+    {
+      Process *p = &processes[running];
+      if (p->startTime == -1)
+        p->startTime = currentCycle;
+
+      // Ejecutar 1 ciclo de CPU (con la acción pendiente si la hay)
+      ActionType action = runningAction != -1 ? actions[runningAction].action : ACTION_NONE;
+      printEventForSyncProcess(p, currentCycle, STATE_ACCESSED, events, eventCount, action);
+      if (runningAction != -1)
+        s->actionProcessed[runningAction] = true;
+      remaining[running]--;
+      quantumCounter++;
+      current = running;
+
+      if (remaining[running] == 0)
+      {
+        finishCombinedProcess(s, running, currentCycle, STATE_TERMINATED, events, eventCount);
+        completed++;
+        current = -1;
+        quantumCounter = 0;
+        releasedCount++;
+      }
+      else if (!continuesCriticalSection(s, running, currentCycle + 1))
+      {
+        // Fin de la sección crítica: liberar lo retenido
+        releasedCount += releaseHeldResources(s, running);
+      }
+    }
+    else
+    {
+      current = -1;
+    }
+
+    // Bloqueo mutuo: nadie puede ejecutar, no hay llegadas y ningún recurso esperado se libera
+    if (running == -1 && blockedCount > 0 && !pendingArrivals && releasedCount == 0)
+    {
+      bool wakeable = false;
+      for (int i = 0; i < processCount; i++)
+      {
+        if (s->blockedOn[i] != -1 && isResourceAvailable(s, s->blockedOn[i]))
+        {
+          wakeable = true;
+          break;
+        }
+      }
+
+      if (!wakeable)
+      {
+        fprintf(stderr, "\nDeadlock detectado: procesos bloqueados sin CPU ni recursos disponibles. Omitiendo procesos bloqueados.\n");
+        for (int i = 0; i < processCount; i++)
+        {
+          if (s->blockedOn[i] != -1)
+          {
+            finishCombinedProcess(s, i, currentCycle, STATE_OMITED, events, eventCount);
+            completed++;
+          }
+        }
+      }
+    }
+
+    currentCycle++;
+    endSimulationCycle();
+  }
+
+  finishCheckpoints(currentCycle);
+
+  // Calcular métricas de la simulación (después del último frame)
+  flushCycleFrame();
+  SimulationMetrics metrics = calculateMetrics(processes, processCount);
+  int totalInversion = 0;
+  for (int i = 0; i < processCount; i++)
+    totalInversion += s->inversionTime[i];
+
+  char line[160];
+  snprintf(line, sizeof(line), "{\"type\": \"metrics\", \"Average Waiting Time\": %.2f, \"Average Inversion Time\": %.2f}",
+           metrics.avgWaitingTime, processCount > 0 ? (float)totalInversion / processCount : 0.0f);
+  printSummaryLine(line);
+}
@@ -0,0 +1,293 @@
+#include "dag.h"
+#include <stdio.h>
+#include <string.h>
+
+static struct
+{
+  int processCount;
+  int edgeCount;
+  int successorStart[MAX_PROCESSES + 1]; // Sucesores de i: successors[successorStart[i] .. successorStart[i + 1])
+  int successors[MAX_PROCESSES * MAX_PREDECESSORS];
+  int predecessorCount[MAX_PROCESSES];
+  int order[MAX_PROCESSES]; // Orden topológico (Kahn)
+  int arrival[MAX_PROCESSES]; // Llegadas originales de la simulación en curso
+
+  // Predecesores que faltan terminar (región de los snapshots)
+  int pending[MAX_PROCESSES];
+} dag;
+
+static int findProcess(const Process *processes, int processCount, const char *pid)
+{
+  for (int i = 0; i < processCount; i++)
+  {
+    if (strcmp(processes[i].pid, pid) == 0)
+      return i;
+  }
+  return -1;
+}
+
+int parseDependencyLine(const char *line, const Process *processes, int processCount, PredecessorList *lists)
+{
+  char pid[COMMON_MAX_LEN];
+  int consumed = 0;
+  if (sscanf(line, " %9[^, \t\r] ,%n", pid, &consumed) < 1 || consumed == 0)
+    return 0;
+
+  int idx = findProcess(processes, processCount, pid);
+  if (idx < 0)
+  {
+    fprintf(stderr, "Dependencias: el proceso %s no existe.\n", pid);
+    return 0;
+  }
+
+  PredecessorList *list = &lists[idx];
+  const char *field = line + consumed;
+  char token[COMMON_MAX_LEN];
+  while (sscanf(field, " %9[^ \t\r,]%n", token, &consumed) == 1)
+  {
+    field += consumed;
+    if (list->count >= MAX_PREDECESSORS)
+    {
+      fprintf(stderr, "Dependencias: %s tiene más de %d predecesores.\n", pid, MAX_PREDECESSORS);
+      break;
+    }
+    strcpy(list->pid[list->count++], token);
+  }
+  return 1;
+}
+
+void loadDependencies(const char *filename, const Process *processes, int processCount, PredecessorList *lists)
+{
+  for (int i = 0; i < processCount; i++)
+    lists[i].count = 0;
+
+  FILE *file = fopen(filename, "r");
+  if (!file)
+    return;
+
+  char line[512];
+  while (fgets(line, sizeof(line), file))
+  {
+    line[strcspn(line, "\n")] = '\0';
+    parseDependencyLine(line, processes, processCount, lists);
+  }
+  fclose(file);
+}
+
+int configureDependencies(const PredecessorList *lists, const Process *processes, int processCount)
+{
+  static int edgeFrom[MAX_PROCESSES * MAX_PREDECESSORS];
+  static int edgeTo[MAX_PROCESSES * MAX_PREDECESSORS];
+  int edges = 0;
+
+  dag.processCount = processCount;
+  dag.edgeCount = 0;
+  memset(dag.predecessorCount, 0, sizeof(dag.predecessorCount));
+  if (!lists)
+    return 0;
+
+  // Aristas predecesor -> proceso, sin las inválidas ni las repetidas
+  for (int i = 0; i < processCount; i++)
+  {
+    for (int k = 0; k < lists[i].count; k++)
+    {
+      const char *pid = lists[i].pid[k];
+      int from = findProcess(processes, processCount, pid);
+      int repeated = 0;
+      for (int e = edges - dag.predecessorCount[i]; e < edges; e++)
+        repeated |= edgeFrom[e] == from;
+
+      if (from < 0)
+        fprintf(stderr, "Dependencias: %s depende de %s, que no existe (se ignora).\n", processes[i].pid, pid);
+      else if (from == i)
+        fprintf(stderr, "Dependencias: %s no puede depender de sí mismo (se ignora).\n", pid);
+      else if (!repeated)
+      {
+        edgeFrom[edges] = from;
+        edgeTo[edges] = i;
+        edges++;
+        dag.predecessorCount[i]++;
+      }
+    }
+  }
+
+  // Sucesores contiguos por proceso (conteo y suma prefija)
+  memset(dag.successorStart, 0, sizeof(dag.successorStart));
+  for (int e = 0; e < edges; e++)
+    dag.successorStart[edgeFrom[e] + 1]++;
+  for (int i = 0; i < processCount; i++)
+    dag.successorStart[i + 1] += dag.successorStart[i];
+  int next[MAX_PROCESSES];
+  memcpy(next, dag.successorStart, sizeof(int) * processCount);
+  for (int e = 0; e < edges; e++)
+    dag.successors[next[edgeFrom[e]]++] = edgeTo[e];
+
+  // Orden topológico: si no se ordenan todos los procesos, los que faltan están en un ciclo
+  int remaining[MAX_PROCESSES];
+  int ordered = 0;
+  memcpy(remaining, dag.predecessorCount, sizeof(int) * processCount);
+  for (int i = 0; i < processCount; i++)
+  {
+    if (remaining[i] == 0)
+      dag.order[ordered++] = i;
+  }
+  for (int head = 0; head < ordered; head++)
+  {
+    int v = dag.order[head];
+    for (int s = dag.successorStart[v]; s < dag.successorStart[v + 1]; s++)
+    {
+      if (--remaining[dag.successors[s]] == 0)
+        dag.order[ordered++] = dag.successors[s];
+    }
+  }
+
+  if (ordered < processCount)
+  {
+    fprintf(stderr, "Dependencias: hay un ciclo entre");
+    for (int i = 0; i < processCount; i++)
+    {
+      if (remaining[i] > 0)
+        fprintf(stderr, " %s", processes[i].pid);
+    }
+    fprintf(stderr, ".\n");
+    memset(dag.predecessorCount, 0, sizeof(dag.predecessorCount));
+    return -1;
+  }
+
+  dag.edgeCount = edges;
+  return 0;
+}
+
+int dependenciesActive(void)
+{
+  return dag.edgeCount > 0;
+}
+
+int beginDependencies(Process *processes, int processCount)
+{
+  if (!dependenciesActive() || processCount != dag.processCount)
+    return 0;
+
+  for (int i = 0; i < processCount; i++)
+  {
+    dag.arrival[i] = processes[i].arrivalTime;
+    dag.pending[i] = dag.predecessorCount[i];
+    if (dag.pending[i] > 0)
+      processes[i].arrivalTime = DAG_BLOCKED;
+  }
+  return 1;
+}
+
+CheckpointRegion dependencyRegion(void)
+{
+  CheckpointRegion region = {dag.pending, sizeof(int) * dag.processCount};
+  return region;
+}
+
+void releaseDependents(Process *processes, int processIdx, int cycle, int *arrivalColumn)
+{
+  if (!dependenciesActive())
+    return;
+
+  for (int s = dag.successorStart[processIdx]; s < dag.successorStart[processIdx + 1]; s++)
+  {
+    int successor = dag.successors[s];
+    if (--dag.pending[successor] > 0)
+      continue;
+
+    int release = dag.arrival[successor] > cycle ? dag.arrival[successor] : cycle;
+    processes[successor].arrivalTime = release;
+    if (arrivalColumn)
+      arrivalColumn[successor] = release;
+  }
+}
+
+unsigned long long dependencyKey(unsigned long long key)
+{
+  if (!dependenciesActive())
+    return key;
+
+  key = checkpointKey(key, dag.successorStart, sizeof(int) * (dag.processCount + 1));
+  return checkpointKey(key, dag.successors, sizeof(int) * dag.edgeCount);
+}
+
+DependencyStats exportDependencyReport(const Process *processes, int processCount)
+{
+  DependencyStats stats = {0, 0, 0, 0};
+  int ready[MAX_PROCESSES];  // Ciclo más temprano en que terminaron todos los predecesores
+  int finish[MAX_PROCESSES]; // Ciclo más temprano en que puede terminar el proceso
+  int previous[MAX_PROCESSES];
+  int last = -1;
+
+  // Camino crítico con CPUs ilimitadas: cada proceso empieza al terminar su predecesor más tardío
+  memset(ready, 0, sizeof(int) * processCount);
+  for (int i = 0; i < processCount; i++)
+    previous[i] = -1;
+  for (int k = 0; k < processCount; k++)
+  {
+    int v = dag.order[k];
+    int start = dag.arrival[v] > ready[v] ? dag.arrival[v] : ready[v];
+    if (dag.arrival[v] > ready[v])
+      previous[v] = -1;
+    finish[v] = start + processes[v].burstTime;
+    if (last < 0 || finish[v] > finish[last])
+      last = v;
+
+    for (int s = dag.successorStart[v]; s < dag.successorStart[v + 1]; s++)
+    {
+      int successor = dag.successors[s];
+      if (finish[v] > ready[successor])
+      {
+        ready[successor] = finish[v];
+        previous[successor] = v;
+      }
+    }
+  }
+  stats.criticalPath = last >= 0 ? finish[last] : 0;
+
+  // Cota de una CPU: los procesos que llegan desde t no terminan antes de t más la suma de sus ráfagas
+  int arrivals[MAX_PROCESSES]; // Índices por llegada descendente
+  for (int i = 0; i < processCount; i++)
+  {
+    int key = i, j = i - 1;
+    while (j >= 0 && dag.arrival[arrivals[j]] < dag.arrival[key])
+    {
+      arrivals[j + 1] = arrivals[j];
+      j--;
+    }
+    arrivals[j + 1] = key;
+  }
+  int work = 0;
+  for (int k = 0; k < processCount; k++)
+  {
+    int v = arrivals[k];
+    work += processes[v].burstTime;
+    if (dag.arrival[v] + work > stats.cpuBound)
+      stats.cpuBound = dag.arrival[v] + work;
+  }
+
+  stats.lowerBound = stats.criticalPath > stats.cpuBound ? stats.criticalPath : stats.cpuBound;
+  for (int i = 0; i < processCount; i++)
+  {
+    if (processes[i].finishTime > stats.makespan)
+      stats.makespan = processes[i].finishTime;
+  }
+
+  // Los pid del camino, del primero al último
+  int path[MAX_PROCESSES];
+  int length = 0;
+  for (int v = last; v >= 0; v = previous[v])
+    path[length++] = v;
+
+  char line[256 + MAX_PROCESSES * (COMMON_MAX_LEN + 4)];
+  int n = snprintf(line, sizeof(line), "{\"event\": \"DAG_METRIC\", \"criticalPath\": %d, \"path\": [",
+                   stats.criticalPath);
+  for (int k = length - 1; k >= 0; k--)
+    n += snprintf(line + n, sizeof(line) - n, "%s\"%s\"", k < length - 1 ? ", " : "", processes[path[k]].pid);
+  snprintf(line + n, sizeof(line) - n,
+           "], \"cpuBound\": %d, \"lowerBound\": %d, \"makespan\": %d, \"boundGap\": %.4f}",
+           stats.cpuBound, stats.lowerBound, stats.makespan,
+           stats.lowerBound > 0 ? (double)(stats.makespan - stats.lowerBound) / stats.lowerBound : 0.0);
+  printSummaryLine(line);
+  return stats;
+}
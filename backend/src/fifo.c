@@ -1,4 +1,6 @@
 #include "fifo.h"
+#include "checkpoint.h"
+#include "dag.h"
 #include <stdio.h>
 #include <string.h>
 #include <unistd.h>
@@ -42,8 +44,25 @@ void simulateFIFO(Process *processes, int processCount,
     processes[i].startTime = -1;
   }
 
+  // Estado del bucle principal para los snapshots (seek)
+  CheckpointRegion loopRegions[] = {
+      {&currentTime, sizeof(currentTime)},
+      {&completed, sizeof(completed)},
+      {&executing, sizeof(executing)},
+      {remainingBurst, sizeof(int) * processCount},
+      {processes, sizeof(Process) * processCount},
+  };
+  CheckpointRegion regions[CHECKPOINT_REGION_COUNT(loopRegions) + CHECKPOINT_OPTIONAL_REGIONS];
+  int regionCount = CHECKPOINT_REGION_COUNT(loopRegions);
+  memcpy(regions, loopRegions, sizeof(loopRegions));
+  if (beginDependencies(processes, processCount))
+    regions[regionCount++] = dependencyRegion();
+  restoreCheckpoint(regions, regionCount);
+
   while (completed < processCount)
   {
+    checkpointCycle(currentTime, regions, regionCount, processes, processCount);
+
     // Marcar procesos que acaban de llegar
     for (int i = 0; i < processCount; i++)
     {
@@ -102,12 +121,14 @@ void simulateFIFO(Process *processes, int processCount,
         processes[executing].state = STATE_TERMINATED;
         printEventForProcess(&processes[executing], currentTime, STATE_TERMINATED, events, eventCount);
         exportProcessMetric(&processes[executing]);
+        releaseDependents(processes, executing, processes[executing].finishTime, NULL);
         completed++;
         executing = -1; // liberar CPU
       }
     }
 
     currentTime++;
-    usleep(SIMULATION_DELAY_US);
+    endSimulationCycle();
   }
+  finishCheckpoints(currentTime);
 }
@@ -0,0 +1,445 @@
+#include "io.h"
+#include "checkpoint.h"
+#include "dag.h"
+#include "ready_queue.h"
+#include "selection.h"
+#include "switching.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+// Carga de I/O configurada para las simulaciones (ver configureIO)
+static struct
+{
+  const BurstSequence *sequences;
+  int processCount;
+  const Device *devices;
+  int deviceCount;
+  int active;
+  IoStats stats;
+} io;
+
+/**
+ * Estado de un dispositivo durante la simulación
+ */
+typedef struct
+{
+  int active;               // Proceso atendido (-1: libre)
+  int size;                 // Procesos en la cola
+  int queue[MAX_PROCESSES]; // Cola en orden de llegada
+  int busyCycles;
+  int served;        // Ráfagas de I/O completadas
+  long queuedCycles; // Suma por ciclo de procesos en la cola
+  int maxQueue;
+} DeviceState;
+
+// ======================== SECUENCIAS DE RÁFAGAS ========================
+
+int findOrAddDevice(Device *devices, int *deviceCount, const char *name)
+{
+  for (int d = 0; d < *deviceCount; d++)
+  {
+    if (strcmp(devices[d].name, name) == 0)
+      return d;
+  }
+  if (*deviceCount >= MAX_DEVICES)
+    return -1;
+
+  Device *device = &devices[(*deviceCount)++];
+  snprintf(device->name, sizeof(device->name), "%s", name);
+  device->policy = DEVICE_FCFS;
+  return *deviceCount - 1;
+}
+
+int addBurst(BurstSequence *sequence, int device, int length)
+{
+  // Posiciones pares: CPU; impares: I/O
+  int isIo = sequence->count % 2 == 1;
+  if (sequence->count >= MAX_BURSTS || length <= 0 || isIo != (device >= 0))
+    return 0;
+
+  sequence->length[sequence->count] = length;
+  sequence->device[sequence->count] = device;
+  sequence->count++;
+  return 1;
+}
+
+void finishBurstSequence(Process *process, BurstSequence *sequence, int valid)
+{
+  if (sequence->count == 0)
+    return;
+
+  if (!valid || sequence->count % 2 == 0)
+  {
+    fprintf(stderr, "Proceso %s: la secuencia de ráfagas debe alternar CPU e I/O y terminar en CPU; se usa burstTime.\n",
+            process->pid);
+    sequence->count = 0;
+    return;
+  }
+
+  process->burstTime = 0;
+  for (int b = 0; b < sequence->count; b += 2)
+    process->burstTime += sequence->length[b];
+}
+
+void parseBurstField(const char *line, Process *process, BurstSequence *sequence,
+                     Device *devices, int *deviceCount)
+{
+  sequence->count = 0;
+
+  // El quinto campo empieza después de la cuarta coma
+  const char *field = line;
+  for (int commas = 0; commas < 4 && field; commas++)
+  {
+    field = strchr(field, ',');
+    if (field)
+      field++;
+  }
+  if (!field)
+    return;
+
+  char token[32];
+  int consumed = 0;
+  int valid = 1;
+  while (sscanf(field, " %31s%n", token, &consumed) == 1)
+  {
+    field += consumed;
+    char *separator = strchr(token, ':');
+    if (separator)
+    {
+      *separator = '\0';
+      int device = findOrAddDevice(devices, deviceCount, token[0] ? token : DEFAULT_IO_DEVICE);
+      valid &= device >= 0 && addBurst(sequence, device, atoi(separator + 1));
+    }
+    else
+    {
+      valid &= addBurst(sequence, -1, atoi(token));
+    }
+  }
+  finishBurstSequence(process, sequence, valid);
+}
+
+void loadBurstSequences(const char *filename, Process *processes, BurstSequence *sequences, int processCount,
+                        Device *devices, int *deviceCount)
+{
+  for (int i = 0; i < processCount; i++)
+    sequences[i].count = 0;
+
+  FILE *file = fopen(filename, "r");
+  if (!file)
+    return;
+
+  char line[512];
+  Process parsed;
+  int index = 0;
+  while (index < processCount && fgets(line, sizeof(line), file))
+  {
+    line[strcspn(line, "\r\n")] = '\0';
+    if (parseProcessLine(line, &parsed))
+    {
+      parseBurstField(line, &processes[index], &sequences[index], devices, deviceCount);
+      index++;
+    }
+  }
+  fclose(file);
+}
+
+void configureIO(const BurstSequence *sequences, int processCount, const Device *devices, int deviceCount)
+{
+  io.sequences = sequences;
+  io.processCount = processCount;
+  io.devices = devices;
+  io.deviceCount = deviceCount;
+
+  io.active = 0;
+  for (int i = 0; i < processCount && sequences; i++)
+  {
+    if (sequences[i].count > 1)
+      io.active = 1;
+  }
+}
+
+int ioModelActive(void)
+{
+  return io.active;
+}
+
+IoStats getIoStats(void)
+{
+  return io.stats;
+}
+
+// ======================== SIMULACIÓN ========================
+
+// Ráfagas de un proceso (sin secuencia: una sola de CPU)
+static int burstCount(int processIdx)
+{
+  int count = processIdx < io.processCount ? io.sequences[processIdx].count : 0;
+  return count > 0 ? count : 1;
+}
+
+static int burstLength(const Process *process, int processIdx, int burst)
+{
+  if (processIdx < io.processCount && io.sequences[processIdx].count > 0)
+    return io.sequences[processIdx].length[burst];
+  return process->burstTime;
+}
+
+// Saca de la cola del dispositivo el próximo proceso a atender según su política
+static int dequeueDevice(DeviceState *device, DeviceQueuePolicy policy, const Process *processes)
+{
+  int pos = 0;
+  if (policy == DEVICE_PRIORITY)
+  {
+    for (int k = 1; k < device->size; k++)
+    {
+      if (processes[device->queue[k]].priority < processes[device->queue[pos]].priority)
+        pos = k;
+    }
+  }
+
+  int processIdx = device->queue[pos];
+  memmove(device->queue + pos, device->queue + pos + 1, sizeof(int) * (device->size - pos - 1));
+  device->size--;
+  return processIdx;
+}
+
+static void exportIoMetric(const Process *p, int ioTime, int ioWaitTime, int ioBursts)
+{
+  char line[256];
+  snprintf(line, sizeof(line),
+           "{\"event\": \"IO_METRIC\", \"pid\": \"%s\", \"cpuTime\": %d, \"ioTime\": %d, \"ioWaitTime\": %d, \"ioBursts\": %d}",
+           p->pid, p->burstTime, ioTime, ioWaitTime, ioBursts);
+  emitEventLine(line, -1);
+}
+
+static void exportDeviceMetric(const Device *device, const DeviceState *state, int cycles)
+{
+  char line[256];
+  double length = cycles > 0 ? cycles : 1;
+  snprintf(line, sizeof(line),
+           "{\"event\": \"DEVICE_METRIC\", \"device\": \"%s\", \"policy\": \"%s\", \"bursts\": %d, "
+           "\"busyCycles\": %d, \"utilization\": %.4f, \"averageQueue\": %.2f, \"maxQueue\": %d}",
+           device->name, device->policy == DEVICE_PRIORITY ? "PRIORITY" : "FCFS", state->served,
+           state->busyCycles, state->busyCycles / length, state->queuedCycles / length, state->maxQueue);
+  printSummaryLine(line);
+}
+
+void simulateIO(Process *processes, int processCount,
+                TimelineEvent *events, int *eventCount,
+                SimulationControl *control)
+{
+  static DeviceState devices[MAX_DEVICES];
+  int currentTime = 0;
+  int completed = 0;
+  int current = -1; // proceso en CPU
+  int quantumCounter = 0;
+  int cpuBusy = 0;
+  int burstIndex[MAX_PROCESSES]; // Ráfaga en curso de cada proceso
+  int remaining[MAX_PROCESSES];  // Lo que falta de la ráfaga en curso (CPU o I/O)
+  int readySince[MAX_PROCESSES]; // Ciclo en que entró a la cola de listos
+  int ioTime[MAX_PROCESSES];
+  int ioWait[MAX_PROCESSES];
+  ProcessColumns columns; // Búsqueda de los algoritmos salvo RR
+  ReadyQueue rrQueue = {{0}, 0, 0};
+  bool isRR = control->config.algorithm == ALGO_RR;
+  *eventCount = 0;
+
+  for (int i = 0; i < processCount; i++)
+  {
+    burstIndex[i] = 0;
+    remaining[i] = burstLength(&processes[i], i, 0);
+    readySince[i] = -1;
+    ioTime[i] = ioWait[i] = 0;
+  }
+  memset(devices, 0, sizeof(devices));
+  for (int d = 0; d < MAX_DEVICES; d++)
+    devices[d].active = -1;
+
+  // Estado del bucle principal para los snapshots (seek)
+  CheckpointRegion loopRegions[] = {
+      {&currentTime, sizeof(currentTime)},
+      {&completed, sizeof(completed)},
+      {&current, sizeof(current)},
+      {&quantumCounter, sizeof(quantumCounter)},
+      {&cpuBusy, sizeof(cpuBusy)},
+      {burstIndex, sizeof(int) * processCount},
+      {remaining, sizeof(int) * processCount},
+      {readySince, sizeof(int) * processCount},
+      {ioTime, sizeof(int) * processCount},
+      {ioWait, sizeof(int) * processCount},
+      {&rrQueue, sizeof(rrQueue)},
+      {devices, sizeof(DeviceState) * io.deviceCount},
+      {processes, sizeof(Process) * processCount},
+  };
+  CheckpointRegion regions[CHECKPOINT_REGION_COUNT(loopRegions) + CHECKPOINT_OPTIONAL_REGIONS];
+  int regionCount = CHECKPOINT_REGION_COUNT(loopRegions);
+  memcpy(regions, loopRegions, sizeof(loopRegions));
+  if (beginDependencies(processes, processCount))
+    regions[regionCount++] = dependencyRegion();
+  if (beginSwitchModel(&control->config))
+    regions[regionCount++] = switchModelRegion();
+  restoreCheckpoint(regions, regionCount);
+
+  while (completed < processCount)
+  {
+    checkpointCycle(currentTime, regions, regionCount, processes, processCount);
+    bool ioDone[MAX_PROCESSES] = {false};
+
+    // Llegadas: entran a la cola de listos
+    for (int i = 0; i < processCount; i++)
+    {
+      if (processes[i].arrivalTime == currentTime && processes[i].state == STATE_NEW)
+      {
+        printEventForProcess(&processes[i], currentTime, STATE_NEW, events, eventCount);
+        processes[i].state = STATE_WAITING;
+        readySince[i] = currentTime;
+        if (isRR)
+          enqueueReady(&rrQueue, i);
+      }
+    }
+
+    // Dispositivos: cada uno atiende una ráfaga de I/O por vez, en paralelo con la CPU
+    for (int d = 0; d < io.deviceCount; d++)
+    {
+      DeviceState *device = &devices[d];
+      const char *name = io.devices[d].name;
+      if (device->active == -1 && device->size > 0)
+      {
+        device->active = dequeueDevice(device, io.devices[d].policy, processes);
+        processes[device->active].state = STATE_IO;
+      }
+
+      if (device->size > device->maxQueue)
+        device->maxQueue = device->size;
+      device->queuedCycles += device->size;
+      for (int k = 0; k < device->size; k++)
+      {
+        int waiter = device->queue[k];
+        printEventForDeviceProcess(&processes[waiter], currentTime, STATE_IO_WAITING, name, events, eventCount);
+        ioWait[waiter]++;
+      }
+
+      int served = device->active;
+      if (served == -1)
+        continue;
+      printEventForDeviceProcess(&processes[served], currentTime, STATE_IO, name, events, eventCount);
+      device->busyCycles++;
+      ioTime[served]++;
+      if (--remaining[served] == 0)
+      {
+        // Vuelve a la cola de listos en el próximo ciclo con su siguiente ráfaga de CPU
+        device->served++;
+        device->active = -1;
+        burstIndex[served]++;
+        remaining[served] = burstLength(&processes[served], served, burstIndex[served]);
+        ioDone[served] = true;
+      }
+    }
+
+    // CPU
+    if (isRR)
+    {
+      if (current == -1 ||
+          quantumCounter >= getQuantumForPriority(&control->config, processes[current].priority))
+      {
+        if (current != -1)
+          enqueueReady(&rrQueue, current); // reencolar el proceso actual
+        current = dequeueReady(&rrQueue);
+        quantumCounter = 0;
+      }
+    }
+    else
+    {
+      // Los listos se ordenan por el ciclo en que entraron a la cola, sobre su ráfaga de CPU en curso
+      for (int i = 0; i < processCount; i++)
+      {
+        columns.arrival[i] = readySince[i];
+        columns.burst[i] = remaining[i];
+        columns.priority[i] = processes[i].priority;
+        columns.remaining[i] = processes[i].state == STATE_WAITING ? remaining[i] : -1;
+      }
+      current = selectReadyProcess(&columns, processCount, currentTime, &control->config, current);
+    }
+
+    if (current != -1 && processes[current].startTime == -1)
+      processes[current].startTime = currentTime;
+
+    // Procesos listos que no tienen la CPU
+    for (int i = 0; i < processCount; i++)
+    {
+      if (i != current && processes[i].state == STATE_WAITING)
+      {
+        printEventForProcess(&processes[i], currentTime, STATE_WAITING, events, eventCount);
+        processes[i].waitingTime++;
+      }
+    }
+
+    if (current != -1 && switchingCycle(current, currentTime))
+    {
+      // Cambio de contexto: ocupa la CPU sin avanzar la ráfaga ni el quantum. Cuenta como espera,
+      // igual que en los motores sin I/O (finish - arrival - burst)
+      printEventForProcess(&processes[current], currentTime, STATE_SWITCHING, events, eventCount);
+      processes[current].waitingTime++;
+      cpuBusy++;
+    }
+    else if (current != -1)
+    {
+      Process *p = &processes[current];
+      printEventForProcess(p, currentTime, STATE_ACCESSED, events, eventCount);
+      cpuBusy++;
+      quantumCounter++;
+
+      if (--remaining[current] == 0)
+      {
+        burstIndex[current]++;
+        if (burstIndex[current] >= burstCount(current))
+        {
+          p->finishTime = currentTime + 1;
+          p->state = STATE_TERMINATED;
+          printEventForProcess(p, currentTime, STATE_TERMINATED, events, eventCount);
+          exportProcessMetric(p);
+          exportIoMetric(p, ioTime[current], ioWait[current], burstCount(current) / 2);
+          releaseDependents(processes, current, p->finishTime, NULL);
+          completed++;
+        }
+        else
+        {
+          // Ráfaga de I/O: a la cola de su dispositivo desde el próximo ciclo
+          DeviceState *device = &devices[io.sequences[current].device[burstIndex[current]]];
+          remaining[current] = burstLength(p, current, burstIndex[current]);
+          device->queue[device->size++] = current;
+          p->state = STATE_IO_WAITING;
+          readySince[current] = -1;
+        }
+        current = -1;
+        quantumCounter = 0;
+      }
+    }
+
+    // Los que terminaron su I/O en este ciclo quedan listos para el siguiente
+    for (int i = 0; i < processCount; i++)
+    {
+      if (!ioDone[i])
+        continue;
+      processes[i].state = STATE_WAITING;
+      readySince[i] = currentTime + 1;
+      if (isRR)
+        enqueueReady(&rrQueue, i);
+    }
+
+    currentTime++;
+    endSimulationCycle();
+  }
+  finishCheckpoints(currentTime);
+
+  io.stats.cycles = currentTime;
+  io.stats.cpuBusyCycles = cpuBusy;
+  io.stats.ioWaitCycles = 0;
+  io.stats.processCount = processCount;
+  for (int i = 0; i < processCount; i++)
+    io.stats.ioWaitCycles += ioWait[i];
+  for (int d = 0; d < io.deviceCount; d++)
+    exportDeviceMetric(&io.devices[d], &devices[d], currentTime);
+}
@@ -0,0 +1,189 @@
+#include "lottery.h"
+#include "checkpoint.h"
+#include "dag.h"
+#include "share.h"
+#include "switching.h"
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+// Estado inicial del generador a partir de la semilla (splitmix64, nunca 0)
+static unsigned long long seedRandom(unsigned int seed)
+{
+  unsigned long long z = seed + 0x9E3779B97F4A7C15ULL;
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  z ^= z >> 31;
+  return z ? z : 1;
+}
+
+// Generador xorshift64*: rápido y con un estado de 64 bits que se guarda en los snapshots
+static unsigned long long nextRandom(unsigned long long *state)
+{
+  unsigned long long x = *state;
+  x ^= x >> 12;
+  x ^= x << 25;
+  x ^= x >> 27;
+  *state = x;
+  return x * 0x2545F4914F6CDD1DULL;
+}
+
+// Sortea la CPU entre los procesos listos en proporción a sus boletos (-1 si no hay ninguno)
+static int drawTicket(const Process *processes, int processCount, const int *tickets, unsigned long long *random)
+{
+  long total = 0;
+  for (int i = 0; i < processCount; i++)
+  {
+    if (processes[i].state == STATE_WAITING)
+      total += tickets[i];
+  }
+  if (total == 0)
+    return -1;
+
+  long winner = (long)(nextRandom(random) % (unsigned long long)total);
+  for (int i = 0; i < processCount; i++)
+  {
+    if (processes[i].state != STATE_WAITING)
+      continue;
+    if (winner < tickets[i])
+      return i;
+    winner -= tickets[i];
+  }
+  return -1;
+}
+
+/**
+ * Simula la planificación por sorteo (Lottery Scheduling) para un conjunto de procesos.
+ *
+ * @param processes    Arreglo de procesos a simular.
+ * @param processCount Número de procesos en el arreglo.
+ * @param events       Arreglo para registrar eventos de ejecución (TimelineEvent).
+ * @param eventCount   Puntero a entero donde se actualizará el conteo de eventos generados.
+ * @param control      Puntero a estructura de control de simulación con el quantum y los boletos.
+ *
+ * Cada proceso tiene boletos: los de `share.tickets` en la configuración o, si no, los derivados de
+ * su prioridad (ver getProcessTickets). Al empezar cada quantum se sortea un boleto entre los
+ * procesos listos, incluido el que venía ejecutando, así que a la larga cada proceso recibe una
+ * parte de la CPU proporcional a sus boletos sin que ninguno quede sin ejecutar.
+ *
+ * En cada ciclo de reloj:
+ *  - Se registran los procesos que llegan (NEW) y pasan a estar listos.
+ *  - Si no hay proceso en turno o agotó su quantum, se sortea el siguiente. El quantum es el de su
+ *    prioridad si `priorityQuantum` define uno, o el quantum general si no.
+ *  - Se registra WAITING para los procesos listos que no ejecutan y ACCESSED (o SWITCHING durante un
+ *    cambio de contexto) para el que ejecuta.
+ *  - Se acumula la parte de CPU recibida frente a la que correspondía (eventos SHARE y SHARE_METRIC).
+ *
+ * El sorteo usa un generador xorshift64* con la semilla `share.seed`: la misma semilla repite la
+ * misma simulación, y el estado del generador se guarda en los snapshots.
+ */
+void simulateLottery(Process *processes, int processCount,
+                     TimelineEvent *events, int *eventCount,
+                     SimulationControl *control)
+{
+  int currentTime = 0;
+  int completed = 0;
+  int remainingBurst[MAX_PROCESSES];
+  int tickets[MAX_PROCESSES];
+  int quantumCounter = 0;
+  int currentProcess = -1;
+  unsigned long long random = seedRandom(control->config.share.seed);
+  *eventCount = 0;
+
+  for (int i = 0; i < processCount; i++)
+  {
+    remainingBurst[i] = processes[i].burstTime;
+    tickets[i] = getProcessTickets(&control->config, &processes[i]);
+  }
+
+  // Estado del bucle principal para los snapshots (seek)
+  CheckpointRegion loopRegions[] = {
+      {&currentTime, sizeof(currentTime)},
+      {&completed, sizeof(completed)},
+      {&currentProcess, sizeof(currentProcess)},
+      {&quantumCounter, sizeof(quantumCounter)},
+      {&random, sizeof(random)},
+      {remainingBurst, sizeof(int) * processCount},
+      {processes, sizeof(Process) * processCount},
+  };
+  CheckpointRegion regions[CHECKPOINT_REGION_COUNT(loopRegions) + CHECKPOINT_OPTIONAL_REGIONS];
+  int regionCount = CHECKPOINT_REGION_COUNT(loopRegions);
+  memcpy(regions, loopRegions, sizeof(loopRegions));
+  beginShareReport(&control->config, processes, processCount);
+  regions[regionCount++] = shareReportRegion();
+  if (beginDependencies(processes, processCount))
+    regions[regionCount++] = dependencyRegion();
+  if (beginSwitchModel(&control->config))
+    regions[regionCount++] = switchModelRegion();
+  restoreCheckpoint(regions, regionCount);
+
+  while (completed < processCount)
+  {
+    checkpointCycle(currentTime, regions, regionCount, processes, processCount);
+
+    // Registrar NEW: el proceso entra al sorteo
+    for (int i = 0; i < processCount; i++)
+    {
+      if (processes[i].arrivalTime == currentTime && processes[i].state == STATE_NEW)
+      {
+        printEventForProcess(&processes[i], currentTime, STATE_NEW, events, eventCount);
+        processes[i].state = STATE_WAITING;
+      }
+    }
+
+    // Sin proceso en turno o con el quantum agotado se sortea el siguiente (el actual también participa)
+    if (currentProcess == -1 ||
+        quantumCounter >= getQuantumForPriority(&control->config, processes[currentProcess].priority))
+    {
+      currentProcess = drawTicket(processes, processCount, tickets, &random);
+      quantumCounter = 0;
+      if (currentProcess != -1 && processes[currentProcess].startTime == -1)
+      {
+        processes[currentProcess].startTime = currentTime;
+      }
+    }
+
+    // Registrar WAITING (una vez por ciclo) para los procesos listos que no se ejecutan
+    for (int i = 0; i < processCount; i++)
+    {
+      if (i != currentProcess && processes[i].state == STATE_WAITING)
+      {
+        printEventForProcess(&processes[i], currentTime, STATE_WAITING, events, eventCount);
+      }
+    }
+
+    int executed = -1;
+    if (currentProcess != -1 && switchingCycle(currentProcess, currentTime))
+    {
+      // Cambio de contexto: ocupa la CPU sin avanzar la ráfaga ni el quantum
+      printEventForProcess(&processes[currentProcess], currentTime, STATE_SWITCHING, events, eventCount);
+    }
+    else if (currentProcess != -1)
+    {
+      printEventForProcess(&processes[currentProcess], currentTime, STATE_ACCESSED, events, eventCount);
+      remainingBurst[currentProcess]--;
+      quantumCounter++;
+      executed = currentProcess;
+
+      if (remainingBurst[currentProcess] == 0)
+      {
+        Process *done = &processes[currentProcess];
+        done->finishTime = currentTime + 1;
+        done->waitingTime = done->finishTime - done->arrivalTime - done->burstTime;
+        done->state = STATE_TERMINATED;
+        printEventForProcess(done, currentTime, STATE_TERMINATED, events, eventCount);
+        exportProcessMetric(done);
+        releaseDependents(processes, currentProcess, done->finishTime, NULL);
+        completed++;
+        currentProcess = -1;
+        quantumCounter = 0;
+      }
+    }
+    recordShareCycle(processes, processCount, executed, currentTime);
+
+    currentTime++;
+    endSimulationCycle();
+  }
+  finishShareReport(processes, processCount, currentTime);
+  finishCheckpoints(currentTime);
+}
@@ -0,0 +1,89 @@
+#include "simulator.h"
+#include "batch.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/**
+ * Corre una matriz de cargas de trabajo × configuraciones y escribe las métricas de cada corrida.
+ *
+ * Uso: batch-runner <cargas> <configuraciones> [salida] [procesos]
+ *  - cargas: directorio o patrón glob (ver findBatchWorkloads)
+ *  - configuraciones: archivo con una configuración JSON por línea o un arreglo JSON (o el JSON mismo)
+ *  - salida: archivo .json para JSON, otro nombre para CSV, "-" o nada para CSV por stdout
+ *  - procesos: simulaciones en paralelo (por defecto uno por CPU)
+ */
+int main(int argc, char *argv[])
+{
+  if (argc < 3)
+  {
+    fprintf(stderr, "Uso: %s <cargas> <configuraciones> [salida] [procesos]\n", argv[0]);
+    return EXIT_FAILURE;
+  }
+  const char *outputPath = argc > 3 ? argv[3] : "-";
+  int workers = argc > 4 ? atoi(argv[4]) : (int)sysconf(_SC_NPROCESSORS_ONLN);
+  if (workers < 1)
+    workers = 1;
+
+  char(*paths)[BATCH_PATH_LEN] = NULL;
+  int workloadCount = findBatchWorkloads(argv[1], &paths);
+  if (workloadCount <= 0)
+  {
+    fprintf(stderr, "No se encontraron cargas de trabajo en %s.\n", argv[1]);
+    free(paths);
+    return EXIT_FAILURE;
+  }
+
+  BatchConfig *configs = NULL;
+  int configCount = loadBatchConfigs(argv[2], &configs);
+  if (configCount <= 0)
+  {
+    fprintf(stderr, "No se pudieron leer configuraciones de %s.\n", argv[2]);
+    free(paths);
+    freeBatchConfigs(configs, configCount > 0 ? configCount : 0);
+    return EXIT_FAILURE;
+  }
+  for (int c = 0; c < configCount; c++)
+  {
+    if (!configs[c].valid)
+      fprintf(stderr, "Configuración %s no válida: %s\n", configs[c].name, configs[c].line);
+  }
+
+  FILE *out = strcmp(outputPath, "-") == 0 ? stdout : fopen(outputPath, "w");
+  if (!out)
+  {
+    perror(outputPath);
+    free(paths);
+    freeBatchConfigs(configs, configCount);
+    return EXIT_FAILURE;
+  }
+
+  BatchMetrics *results = malloc(sizeof(BatchMetrics) * workloadCount * configCount);
+  if (!results)
+  {
+    fprintf(stderr, "Sin memoria para %d corridas.\n", workloadCount * configCount);
+    if (out != stdout)
+      fclose(out);
+    free(paths);
+    freeBatchConfigs(configs, configCount);
+    return EXIT_FAILURE;
+  }
+
+  fprintf(stderr, "[batch] %d cargas x %d configuraciones (%d procesos).\n", workloadCount, configCount,
+          workers < BATCH_MAX_WORKERS ? workers : BATCH_MAX_WORKERS);
+  runBatch(paths, workloadCount, configs, configCount, workers, results);
+
+  size_t length = strlen(outputPath);
+  if (length > 5 && strcmp(outputPath + length - 5, ".json") == 0)
+    writeBatchJson(out, paths, workloadCount, configs, configCount, results);
+  else
+    writeBatchCsv(out, paths, workloadCount, configs, configCount, results);
+
+  if (out != stdout)
+    fclose(out);
+  free(results);
+  free(paths);
+  freeBatchConfigs(configs, configCount);
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,228 @@
+#include "simulator.h"
+#include "session.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <cjson/cJSON.h>
+
+#define DEFAULT_SOCKET_PATH "/tmp/simulator.sock"
+#define DEFAULT_WORKERS 16
+#define DEFAULT_INPUT_DIR "../data/input"
+
+static const char *inputFiles[] = {"procesos.txt", "recursos.txt", "acciones.txt", "dispositivos.txt",
+                                    "dependencias.txt"};
+#define INPUT_FILE_COUNT ((int)(sizeof(inputFiles) / sizeof(inputFiles[0])))
+
+/**
+ * Carga de trabajo en caché junto con la firma (tamaño y fecha) de cada archivo de entrada.
+ */
+typedef struct
+{
+  Workload workload;
+  int loaded;
+  struct stat signature[INPUT_FILE_COUNT];
+} WorkloadCache;
+
+static volatile sig_atomic_t stopRequested = 0;
+
+static void handleStopSignal(int sig)
+{
+  (void)sig;
+  stopRequested = 1;
+}
+
+// Indica si algún archivo de entrada cambió desde la última carga
+static int inputChanged(const WorkloadCache *cache, const char *inputDir, struct stat *current)
+{
+  int changed = !cache->loaded;
+  char path[512];
+
+  for (int f = 0; f < INPUT_FILE_COUNT; f++)
+  {
+    snprintf(path, sizeof(path), "%s/%s", inputDir, inputFiles[f]);
+    if (stat(path, &current[f]) != 0)
+      memset(&current[f], 0, sizeof(struct stat));
+
+    const struct stat *old = &cache->signature[f];
+    if (current[f].st_size != old->st_size ||
+        current[f].st_mtim.tv_sec != old->st_mtim.tv_sec ||
+        current[f].st_mtim.tv_nsec != old->st_mtim.tv_nsec)
+      changed = 1;
+  }
+  return changed;
+}
+
+// Recarga la caché si los archivos de entrada cambiaron
+static void refreshWorkload(WorkloadCache *cache, const char *inputDir)
+{
+  struct stat current[INPUT_FILE_COUNT];
+  if (!inputChanged(cache, inputDir, current))
+    return;
+
+  loadWorkload(&cache->workload, inputDir);
+  memcpy(cache->signature, current, sizeof(current));
+  cache->loaded = 1;
+  fprintf(stderr, "[daemon] Carga recargada: %d procesos, %d recursos, %d acciones.\n",
+          cache->workload.processCount, cache->workload.resourceCount, cache->workload.actionCount);
+}
+
+/**
+ * Atiende una sesión en el proceso hijo: lee la configuración (y la carga en línea si la trae),
+ * redirige stdout al socket y ejecuta la simulación pedida en `mode`. Sin carga en línea se usa
+ * la carga en caché.
+ */
+static int serveSession(int client, const Workload *cached)
+{
+  static Workload sessionWorkload;
+  FILE *in = fdopen(client, "r");
+  if (!in)
+    return -1;
+
+  char *configLine = readSessionConfig(in);
+  if (!configLine)
+    return -1;
+
+  // Modo en línea: los procesos siguen llegando por el socket, así que la entrada queda abierta
+  if (isStreamSession(configLine))
+  {
+    int status = -1;
+    if (dup2(client, STDOUT_FILENO) >= 0)
+      status = runStreamSession(configLine, in);
+    fflush(stdout);
+    fclose(in);
+    free(configLine);
+    return status;
+  }
+
+  int inlineWorkload = loadInlineWorkload(configLine, in, &sessionWorkload);
+  if (inlineWorkload < 0)
+  {
+    free(configLine);
+    return -1;
+  }
+  const Workload *workload = inlineWorkload ? &sessionWorkload : cached;
+
+  cJSON *json = cJSON_Parse(configLine);
+  const cJSON *modeField = json ? cJSON_GetObjectItemCaseSensitive(json, "mode") : NULL;
+  int synchronization = cJSON_IsString(modeField) && modeField->valuestring &&
+                        strcmp(modeField->valuestring, "synchronization") == 0;
+  cJSON_Delete(json);
+
+  if (dup2(client, STDOUT_FILENO) < 0)
+  {
+    free(configLine);
+    return -1;
+  }
+  fclose(in);
+
+  int status = synchronization ? runSynchronizationSession(configLine, workload)
+                               : runSchedulingSession(configLine, workload);
+  fflush(stdout);
+  free(configLine);
+  return status;
+}
+
+// Recolecta las sesiones terminadas; con `block` espera al menos una
+static int reapSessions(int active, int block)
+{
+  pid_t pid;
+  while (active > 0 && (pid = waitpid(-1, NULL, block ? 0 : WNOHANG)) != 0)
+  {
+    if (pid < 0)
+    {
+      if (errno == EINTR && !stopRequested)
+        continue;
+      break;
+    }
+    active--;
+    block = 0;
+  }
+  return active;
+}
+
+int main(int argc, char *argv[])
+{
+  static WorkloadCache cache;
+  const char *socketPath = argc > 1 ? argv[1] : DEFAULT_SOCKET_PATH;
+  int workers = argc > 2 ? atoi(argv[2]) : DEFAULT_WORKERS;
+  const char *inputDir = argc > 3 ? argv[3] : DEFAULT_INPUT_DIR;
+  if (workers <= 0)
+    workers = DEFAULT_WORKERS;
+
+  int server = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (server < 0)
+  {
+    perror("socket");
+    return EXIT_FAILURE;
+  }
+
+  struct sockaddr_un addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  strncpy(addr.sun_path, socketPath, sizeof(addr.sun_path) - 1);
+  unlink(socketPath);
+
+  if (bind(server, (struct sockaddr *)&addr, sizeof(addr)) != 0 || listen(server, 64) != 0)
+  {
+    perror("bind/listen");
+    return EXIT_FAILURE;
+  }
+
+  // Sin SA_RESTART para que accept() despierte al pedir la detención
+  struct sigaction sa;
+  memset(&sa, 0, sizeof(sa));
+  sa.sa_handler = handleStopSignal;
+  sigaction(SIGINT, &sa, NULL);
+  sigaction(SIGTERM, &sa, NULL);
+
+  refreshWorkload(&cache, inputDir);
+  fprintf(stderr, "[daemon] Escuchando en %s (%d sesiones simultáneas).\n", socketPath, workers);
+
+  int active = 0;
+  while (!stopRequested)
+  {
+    // Limitar las sesiones simultáneas al tamaño del pool
+    active = reapSessions(active, active >= workers);
+    if (active >= workers)
+      continue;
+
+    int client = accept(server, NULL, NULL);
+    if (client < 0)
+    {
+      if (errno != EINTR)
+        perror("accept");
+      continue;
+    }
+
+    refreshWorkload(&cache, inputDir);
+
+    // Cada sesión corre en un proceso hijo que hereda la carga en caché (copy-on-write)
+    pid_t pid = fork();
+    if (pid == 0)
+    {
+      close(server);
+      signal(SIGINT, SIG_DFL);
+      signal(SIGTERM, SIG_DFL);
+      _exit(serveSession(client, &cache.workload) == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+    }
+
+    if (pid < 0)
+      perror("fork");
+    else
+      active++;
+    close(client);
+  }
+
+  close(server);
+  unlink(socketPath);
+  while (active > 0 && wait(NULL) > 0)
+    active--;
+  return 0;
+}
@@ -1,118 +1,38 @@
 #include "simulator.h"
-#include "fifo.h"
-#include "sjf.h"
-#include "rr.h"
-#include "ps.h"
-#include "srt.h"
+#include "session.h"
 #include <stdio.h>
-#include <string.h>
-#include <cjson/cJSON.h>
 #include <stdlib.h>
 
-// Traduce string a enum
-SchedulingAlgorithm parseAlgorithm(const char *str)
-{
-  if (strcmp(str, "FIFO") == 0)
-    return ALGO_FIFO;
-  if (strcmp(str, "SJF") == 0)
-    return ALGO_SJF;
-  if (strcmp(str, "RR") == 0)
-    return ALGO_RR;
-  if (strcmp(str, "PS") == 0)
-    return ALGO_PRIORITY;
-  if (strcmp(str, "SRT") == 0)
-    return ALGO_SRT;
-  return ALGO_NONE;
-}
-
-// Lee la configuración desde stdin (en formato JSON) usando cJSON
-void readConfigFromStdin(SimulationControl *control)
-{
-  char buffer[512];
-  if (fgets(buffer, sizeof(buffer), stdin))
-  {
-    cJSON *json = cJSON_Parse(buffer);
-    if (json == NULL)
-    {
-      fprintf(stderr, "Error al parsear configuración JSON.\n");
-      exit(EXIT_FAILURE);
-    }
-
-    const cJSON *alg = cJSON_GetObjectItemCaseSensitive(json, "algorithm");
-    const cJSON *quant = cJSON_GetObjectItemCaseSensitive(json, "quantum");
-    const cJSON *preempt = cJSON_GetObjectItemCaseSensitive(json, "isPreemptive");
-
-    if (cJSON_IsString(alg) && alg->valuestring)
-      control->config.algorithm = parseAlgorithm(alg->valuestring);
-
-    if (cJSON_IsNumber(quant))
-      control->config.quantum = quant->valueint;
-
-    if (cJSON_IsNumber(preempt))
-      control->config.isPreemptive = preempt->valueint;
-
-    printf("Algoritmo: %s | Quantum: %d | Preemptivo: %s\n",
-           alg && alg->valuestring ? alg->valuestring : "(none)",
-           control->config.quantum,
-           control->config.isPreemptive ? "Sí" : "No");
-
-    cJSON_Delete(json);
-  }
-}
-
 int main()
 {
-  Process processes[MAX_PROCESSES];
-  TimelineEvent timelineEvents[MAX_EVENTS];
-  SimulationControl control;
-  int eventCount = 0;
+  static Workload workload;
 
-  readConfigFromStdin(&control);
+  // Leer config desde stdin (en formato JSON), con la carga de trabajo en línea opcional
+  char *configLine = readSessionConfig(stdin);
 
-  int processCount = loadProcesses("../data/input/procesos.txt", processes, MAX_PROCESSES);
-
-  printf("=== Procesos Cargados (%d) ===\n", processCount);
-  for (int i = 0; i < processCount; i++)
+  // Modo en línea: los procesos siguen llegando por stdin mientras corre la simulación
+  if (isStreamSession(configLine))
   {
-    printf("PID: %s, BT: %d, AT: %d, Priority: %d, State: %s\n",
-           processes[i].pid,
-           processes[i].burstTime,
-           processes[i].arrivalTime,
-           processes[i].priority,
-           getProcessStateName(processes[i].state));
+    int status = runStreamSession(configLine, stdin);
+    free(configLine);
+    if (status != 0)
+      exit(EXIT_FAILURE);
+    return 0;
   }
 
-  printf("\n=== Ejecutando Algoritmo: %s ===\n", getAlgorithmName(control.config.algorithm));
+  int inlineWorkload = loadInlineWorkload(configLine, stdin, &workload);
+  if (inlineWorkload < 0)
+    exit(EXIT_FAILURE);
 
-  switch (control.config.algorithm)
-  {
-  case ALGO_FIFO:
-    simulateFIFO(processes, processCount, timelineEvents, &eventCount, &control);
-    break;
-  case ALGO_SJF:
-    simulateSJF(processes, processCount, timelineEvents, &eventCount, &control);
-    break;
-  case ALGO_RR:
-    simulateRR(processes, processCount, timelineEvents, &eventCount, &control);
-    break;
-  case ALGO_PRIORITY:
-    simulatePS(processes, processCount, timelineEvents, &eventCount, &control);
-    break;
-  case ALGO_SRT:
-    simulateSRT(processes, processCount, timelineEvents, &eventCount, &control);
-    break;
-  default:
-    printf("Algoritmo no soportado.\n");
-    return 1;
-  }
+  // Sin carga en línea se usan los archivos de entrada
+  if (inlineWorkload == 0)
+    loadWorkload(&workload, "../data/input");
 
-  SimulationMetrics metrics = calculateMetrics(processes, processCount);
-  printf("{\"type\": \"metrics\", \"Average Waiting Time\": %.2f}\n", metrics.avgWaitingTime);
-  fflush(stdout);
-  // exportMetrics("../data/output/metrics.txt", metrics);
-  // exportTimelineEvents("../data/output/timeline.txt", timelineEvents, eventCount);
+  int status = runSchedulingSession(configLine ? configLine : "", &workload);
+  free(configLine);
 
-  exportSimulationEnd();
+  if (status != 0)
+    exit(EXIT_FAILURE);
 
   return 0;
 }
@@ -1,8 +1,11 @@
 #include "ps.h"
+#include "checkpoint.h"
+#include "dag.h"
+#include "selection.h"
+#include "switching.h"
 #include <stdio.h>
 #include <string.h>
 #include <unistd.h>
-#include <limits.h>
 #include <stdbool.h>
 
 /**
@@ -33,14 +36,15 @@ void simulatePS(Process *processes, int processCount,
   int currentTime = 0;
   int completed = 0;
   int isPreemptive = control->config.isPreemptive;
-  int remainingBurst[MAX_PROCESSES];
+  ProcessColumns columns; // Llegada, ráfaga, prioridad y ráfaga pendiente que recorre la selección
   *eventCount = 0;
   bool newPrinted[MAX_PROCESSES] = {false};
+  int dependent = beginDependencies(processes, processCount);
 
   // Inicializar simulacións restantes y emitir eventos NEW para procesos con llegada en 0
+  loadProcessColumns(&columns, processes, processCount);
   for (int i = 0; i < processCount; i++)
   {
-    remainingBurst[i] = processes[i].burstTime;
     if (processes[i].arrivalTime == 0)
     {
       printEventForProcess(&processes[i], 0, STATE_NEW, events, eventCount);
@@ -48,127 +52,147 @@ void simulatePS(Process *processes, int processCount,
     }
   }
 
+  int runningIdx = -1; // Proceso en ejecución (en no preventivo, hasta completar su ráfaga)
+  int ranCycles = 0;   // Ciclos ejecutados por runningIdx en el modo no preventivo
+
+  // Estado del bucle principal para los snapshots (seek)
+  CheckpointRegion loopRegions[] = {
+      {&currentTime, sizeof(currentTime)},
+      {&completed, sizeof(completed)},
+      {&runningIdx, sizeof(runningIdx)},
+      {&ranCycles, sizeof(ranCycles)},
+      {newPrinted, sizeof(bool) * processCount},
+      {columns.remaining, sizeof(int) * processCount},
+      {processes, sizeof(Process) * processCount},
+  };
+  CheckpointRegion regions[CHECKPOINT_REGION_COUNT(loopRegions) + CHECKPOINT_OPTIONAL_REGIONS];
+  int regionCount = CHECKPOINT_REGION_COUNT(loopRegions);
+  memcpy(regions, loopRegions, sizeof(loopRegions));
+  if (dependent)
+    regions[regionCount++] = dependencyRegion();
+  if (beginSwitchModel(&control->config))
+    regions[regionCount++] = switchModelRegion();
+  restoreCheckpoint(regions, regionCount);
+
+  // Al reanudar, las llegadas de los procesos ya liberados vienen del snapshot
+  for (int i = 0; dependent && i < processCount; i++)
+    columns.arrival[i] = processes[i].arrivalTime;
+
   while (completed < processCount)
   {
-    // Registrar procesos que acaban de llegar (NEW)
-    for (int i = 0; i < processCount; i++)
+    checkpointCycle(currentTime, regions, regionCount, processes, processCount);
+
+    // Si el proceso en ejecución completó su ráfaga en el ciclo anterior
+    if (runningIdx != -1 && columns.remaining[runningIdx] == ranCycles)
     {
-      if (processes[i].arrivalTime == currentTime && !newPrinted[i])
-      {
-        printEventForProcess(&processes[i], currentTime, STATE_NEW, events, eventCount);
-        newPrinted[i] = true;
-      }
+      Process *done = &processes[runningIdx];
+      done->finishTime = currentTime;
+      done->waitingTime = done->finishTime - done->arrivalTime - done->burstTime;
+      done->state = STATE_TERMINATED;
+      printEventForProcess(done, currentTime - 1, STATE_TERMINATED, events, eventCount);
+      exportProcessMetric(done);
+      releaseDependents(processes, runningIdx, currentTime, columns.arrival);
+      completed++;
+      columns.remaining[runningIdx] = -1;
+      runningIdx = -1;
+      if (completed == processCount)
+        break;
     }
 
-    int selectedIdx = -1;
-
-    for (int i = 0; i < processCount; i++)
+    if (isPreemptive || runningIdx == -1)
     {
-      if (processes[i].arrivalTime <= currentTime &&
-          processes[i].state != STATE_TERMINATED &&
-          remainingBurst[i] > 0)
+      // Registrar procesos que acaban de llegar (NEW)
+      for (int i = 0; i < processCount; i++)
       {
-
-        // Desempate:
-        // 1. Mayor prioridad (menor valor)
-        // 2. Misma prioridad y llegó antes
-        // 3. Misma prioridad, llegó al mismo tiempo, menor tiempo en simulación
-        if (selectedIdx == -1 ||
-            processes[i].priority < processes[selectedIdx].priority ||
-            (processes[i].priority == processes[selectedIdx].priority &&
-             (processes[i].arrivalTime < processes[selectedIdx].arrivalTime ||
-              (processes[i].arrivalTime == processes[selectedIdx].arrivalTime &&
-               processes[i].burstTime < processes[selectedIdx].burstTime))))
+        if (processes[i].arrivalTime == currentTime && !newPrinted[i])
         {
-          selectedIdx = i;
+          printEventForProcess(&processes[i], currentTime, STATE_NEW, events, eventCount);
+          newPrinted[i] = true;
         }
       }
-    }
 
-    if (selectedIdx == -1)
-    {
-      currentTime++;
-      usleep(SIMULATION_DELAY_US);
-      continue;
-    }
+      // Desempate:
+      // 1. Mayor prioridad (menor valor)
+      // 2. Misma prioridad y llegó antes
+      // 3. Misma prioridad, llegó al mismo tiempo, menor tiempo en simulación
+      int selectedIdx = selectHighestPriority(&columns, processCount, currentTime);
 
-    // Registrar WAITING para todos los demás procesos activos
-    for (int i = 0; i < processCount; i++)
-    {
-      if (i != selectedIdx &&
-          processes[i].arrivalTime <= currentTime &&
-          processes[i].state != STATE_TERMINATED &&
-          remainingBurst[i] > 0)
+      if (selectedIdx == -1)
       {
-        printEventForProcess(&processes[i], currentTime, STATE_WAITING, events, eventCount);
+        currentTime++;
+        endSimulationCycle();
+        continue;
       }
-    }
-
-    Process *p = &processes[selectedIdx];
 
-    if (p->startTime == -1)
-    {
-      p->startTime = currentTime;
-    }
+      // Registrar WAITING para todos los demás procesos activos
+      for (int i = 0; i < processCount; i++)
+      {
+        if (i != selectedIdx &&
+            columns.arrival[i] <= currentTime &&
+            columns.remaining[i] > 0)
+        {
+          printEventForProcess(&processes[i], currentTime, STATE_WAITING, events, eventCount);
+        }
+      }
 
-    if (isPreemptive)
-    {
-      // Ejecuta 1 ciclo
-      printEventForProcess(p, currentTime, STATE_ACCESSED, events, eventCount);
-      currentTime++;
-      remainingBurst[selectedIdx]--;
-      usleep(SIMULATION_DELAY_US);
+      Process *p = &processes[selectedIdx];
 
-      if (remainingBurst[selectedIdx] == 0)
+      if (p->startTime == -1)
       {
-        p->finishTime = currentTime;
-        p->waitingTime = p->finishTime - p->arrivalTime - p->burstTime;
-        p->state = STATE_TERMINATED;
-        printEventForProcess(p, currentTime - 1, STATE_TERMINATED, events, eventCount);
-        exportProcessMetric(p);
-        completed++;
+        p->startTime = currentTime;
       }
-    }
-    else
-    {
-      // Ejecutar hasta terminar (no preventivo)
-      for (int c = 0; c < remainingBurst[selectedIdx]; c++)
-      {
-        // Verificar si algún proceso llega justo en este ciclo
-        for (int i = 0; i < processCount; i++)
-        {
-          if (processes[i].arrivalTime == currentTime && !newPrinted[i])
-          {
-            printEventForProcess(&processes[i], currentTime, STATE_NEW, events, eventCount);
-            newPrinted[i] = true;
-          }
-        }
 
-        // Registrar WAITING para otros procesos en este ciclo
-        for (int i = 0; i < processCount; i++)
+      runningIdx = selectedIdx;
+      ranCycles = 0;
+
+      if (isPreemptive)
+      {
+        // Cambio de contexto: ocupa la CPU sin avanzar la ráfaga
+        if (switchingCycle(selectedIdx, currentTime))
         {
-          if (i != selectedIdx &&
-              processes[i].arrivalTime <= currentTime &&
-              processes[i].state != STATE_TERMINATED &&
-              remainingBurst[i] > 0)
-          {
-            printEventForProcess(&processes[i], currentTime, STATE_WAITING, events, eventCount);
-          }
+          printEventForProcess(p, currentTime, STATE_SWITCHING, events, eventCount);
+          currentTime++;
+          endSimulationCycle();
+          continue;
         }
 
-        // Ejecutar proceso actual
+        // Ejecuta 1 ciclo
         printEventForProcess(p, currentTime, STATE_ACCESSED, events, eventCount);
         currentTime++;
-        usleep(SIMULATION_DELAY_US);
+        columns.remaining[selectedIdx]--;
+        endSimulationCycle();
+        continue;
       }
+    }
 
-      p->finishTime = currentTime;
-      p->waitingTime = p->finishTime - p->arrivalTime - p->burstTime;
-      p->state = STATE_TERMINATED;
-      printEventForProcess(p, currentTime - 1, STATE_TERMINATED, events, eventCount);
-      exportProcessMetric(p);
-      completed++;
-      remainingBurst[selectedIdx] = 0;
+    // Ejecutar hasta terminar (no preventivo): un ciclo por iteración
+
+    // Verificar si algún proceso llega justo en este ciclo
+    for (int i = 0; i < processCount; i++)
+    {
+      if (processes[i].arrivalTime == currentTime && !newPrinted[i])
+      {
+        printEventForProcess(&processes[i], currentTime, STATE_NEW, events, eventCount);
+        newPrinted[i] = true;
+      }
     }
+
+    // Registrar WAITING para otros procesos en este ciclo
+    for (int i = 0; i < processCount; i++)
+    {
+      if (i != runningIdx &&
+          columns.arrival[i] <= currentTime &&
+          columns.remaining[i] > 0)
+      {
+        printEventForProcess(&processes[i], currentTime, STATE_WAITING, events, eventCount);
+      }
+    }
+
+    // Ejecutar proceso actual
+    printEventForProcess(&processes[runningIdx], currentTime, STATE_ACCESSED, events, eventCount);
+    currentTime++;
+    ranCycles++;
+    endSimulationCycle();
   }
+  finishCheckpoints(currentTime);
 }
@@ -0,0 +1,17 @@
+#include "ready_queue.h"
+
+void enqueueReady(ReadyQueue *queue, int processIdx)
+{
+  queue->items[(queue->start + queue->size) % MAX_PROCESSES] = processIdx;
+  queue->size++;
+}
+
+int dequeueReady(ReadyQueue *queue)
+{
+  if (queue->size == 0)
+    return -1;
+  int processIdx = queue->items[queue->start];
+  queue->start = (queue->start + 1) % MAX_PROCESSES;
+  queue->size--;
+  return processIdx;
+}
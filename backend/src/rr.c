@@ -1,4 +1,8 @@
 #include "rr.h"
+#include "checkpoint.h"
+#include "dag.h"
+#include "ready_queue.h"
+#include "switching.h"
 #include <stdio.h>
 #include <string.h>
 #include <unistd.h>
@@ -14,13 +18,14 @@
  *
  * Esta función implementa la planificación Round Robin, que asigna tiempo de CPU a los procesos
  * por turnos de duración fija (quantum), en orden de llegada. El algoritmo considera el tiempo de
- * llegada de cada proceso, y los coloca en una cola a medida que van llegando.
+ * llegada de cada proceso, y los coloca en una cola circular a medida que van llegando.
  *
  * En cada ciclo de reloj:
  *  - Se agregan nuevos procesos a la cola si han llegado en ese tiempo.
- *  - Se registra el estado de espera (STATE_WAITING) para los procesos en cola que no están ejecutando.
- *  - Se ejecuta el proceso en turno por hasta `quantum` ciclos o hasta que termine su ráfaga.
- *  - Si el proceso no termina dentro del quantum, se reencola al final.
+ *  - Si el proceso en turno agotó su quantum, se reencola al final y se toma el primero de la cola.
+ *  - Se registra una vez el estado de espera (STATE_WAITING) de cada proceso listo que no ejecuta.
+ *  - Se ejecuta el proceso en turno por hasta su quantum o hasta que termine su ráfaga. El quantum
+ *    es el de su prioridad si `priorityQuantum` define uno, o el quantum general si no.
  *
  * Durante la simulación:
  *  - Se generan eventos STATE_NEW, STATE_WAITING, STATE_ACCESSED y STATE_TERMINATED.
@@ -35,23 +40,40 @@ void simulateRR(Process *processes, int processCount,
 {
   int currentTime = 0;
   int completed = 0;
-  int quantum = control->config.quantum;
-  int queue[MAX_PROCESSES];
-  int queueStart = 0, queueEnd = 0;
+  ReadyQueue queue = {{0}, 0, 0};
   int remainingBurst[MAX_PROCESSES];
   int quantumCounter = 0;
   int currentProcess = -1;
   *eventCount = 0;
 
-  printf("Quantum recibido: %d\n", quantum);
-
   for (int i = 0; i < processCount; i++)
   {
     remainingBurst[i] = processes[i].burstTime;
   }
 
+  // Estado del bucle principal para los snapshots (seek)
+  CheckpointRegion loopRegions[] = {
+      {&currentTime, sizeof(currentTime)},
+      {&completed, sizeof(completed)},
+      {&currentProcess, sizeof(currentProcess)},
+      {&quantumCounter, sizeof(quantumCounter)},
+      {&queue, sizeof(queue)},
+      {remainingBurst, sizeof(int) * processCount},
+      {processes, sizeof(Process) * processCount},
+  };
+  CheckpointRegion regions[CHECKPOINT_REGION_COUNT(loopRegions) + CHECKPOINT_OPTIONAL_REGIONS];
+  int regionCount = CHECKPOINT_REGION_COUNT(loopRegions);
+  memcpy(regions, loopRegions, sizeof(loopRegions));
+  if (beginDependencies(processes, processCount))
+    regions[regionCount++] = dependencyRegion();
+  if (beginSwitchModel(&control->config))
+    regions[regionCount++] = switchModelRegion();
+  restoreCheckpoint(regions, regionCount);
+
   while (completed < processCount)
   {
+    checkpointCycle(currentTime, regions, regionCount, processes, processCount);
+
     // Agregar procesos nuevos al queue y registrar NEW
     for (int i = 0; i < processCount; i++)
     {
@@ -59,30 +81,22 @@ void simulateRR(Process *processes, int processCount,
       {
         printEventForProcess(&processes[i], currentTime, STATE_NEW, events, eventCount);
         processes[i].state = STATE_WAITING;
-        queue[queueEnd++] = i;
-      }
-    }
-
-    // Registrar WAITING para procesos en cola que no están ejecutando
-    for (int i = queueStart; i < queueEnd; i++)
-    {
-      if (queue[i] != currentProcess)
-      {
-        printEventForProcess(&processes[queue[i]], currentTime, STATE_WAITING, events, eventCount);
+        enqueueReady(&queue, i);
       }
     }
 
     // Si no hay proceso actual o se agotó el quantum = cambio de proceso en ejecución
-    if (currentProcess == -1 || quantumCounter == quantum)
+    if (currentProcess == -1 ||
+        quantumCounter >= getQuantumForPriority(&control->config, processes[currentProcess].priority))
     {
       if (currentProcess != -1 && remainingBurst[currentProcess] > 0)
       {
-        queue[queueEnd++] = currentProcess; // reencolar el proceso actual
+        enqueueReady(&queue, currentProcess); // reencolar el proceso actual
       }
 
-      if (queueStart < queueEnd)
+      currentProcess = dequeueReady(&queue);
+      if (currentProcess != -1)
       {
-        currentProcess = queue[queueStart++];
         quantumCounter = 0;
 
         if (processes[currentProcess].startTime == -1)
@@ -90,26 +104,23 @@ void simulateRR(Process *processes, int processCount,
           processes[currentProcess].startTime = currentTime;
         }
       }
-      else
-      {
-        currentProcess = -1;
-      }
     }
 
-    // Espera implícita para procesos activos pero no ejecutando en este ciclo
+    // Registrar WAITING (una vez por ciclo) para los procesos listos que no se ejecutan
     for (int i = 0; i < processCount; i++)
     {
-      if (i != currentProcess &&
-          processes[i].arrivalTime <= currentTime &&
-          processes[i].startTime != -1 &&
-          processes[i].state != STATE_TERMINATED &&
-          remainingBurst[i] > 0)
+      if (i != currentProcess && processes[i].state == STATE_WAITING)
       {
-        printEventForProcess(&processes[i], currentTime, STATE_WAITING, events, eventCount); // marcar procesos que ya estan en la simulación pero no se ejecutan
+        printEventForProcess(&processes[i], currentTime, STATE_WAITING, events, eventCount);
       }
     }
 
-    if (currentProcess != -1)
+    if (currentProcess != -1 && switchingCycle(currentProcess, currentTime))
+    {
+      // Cambio de contexto: ocupa la CPU sin avanzar la ráfaga ni el quantum
+      printEventForProcess(&processes[currentProcess], currentTime, STATE_SWITCHING, events, eventCount);
+    }
+    else if (currentProcess != -1)
     {
       // Ejecutar proceso
       printEventForProcess(&processes[currentProcess], currentTime, STATE_ACCESSED, events, eventCount);
@@ -124,6 +135,7 @@ void simulateRR(Process *processes, int processCount,
         processes[currentProcess].state = STATE_TERMINATED;
         printEventForProcess(&processes[currentProcess], currentTime, STATE_TERMINATED, events, eventCount);
         exportProcessMetric(&processes[currentProcess]);
+        releaseDependents(processes, currentProcess, processes[currentProcess].finishTime, NULL);
         completed++;
         currentProcess = -1;
         quantumCounter = 0;
@@ -131,6 +143,7 @@ void simulateRR(Process *processes, int processCount,
     }
 
     currentTime++;
-    usleep(SIMULATION_DELAY_US);
+    endSimulationCycle();
   }
+  finishCheckpoints(currentTime);
 }
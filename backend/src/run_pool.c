@@ -0,0 +1,155 @@
+#include "run_pool.h"
+#include "switching.h"
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+int compareInt(const void *a, const void *b)
+{
+  return *(const int *)a - *(const int *)b;
+}
+
+void measureRun(const Process *processes, int processCount, const SimulationConfig *config, RunMetrics *metrics)
+{
+  int responses[MAX_PROCESSES];
+  long waiting = 0, turnaround = 0, response = 0;
+
+  memset(metrics, 0, sizeof(*metrics));
+  for (int i = 0; i < processCount; i++)
+  {
+    const Process *p = &processes[i];
+    responses[i] = p->startTime - p->arrivalTime;
+    waiting += p->waitingTime;
+    turnaround += p->finishTime - p->arrivalTime;
+    response += responses[i];
+    if (p->finishTime > metrics->cycles)
+      metrics->cycles = p->finishTime;
+  }
+
+  // Percentil 99 por rango más cercano
+  qsort(responses, processCount, sizeof(int), compareInt);
+  metrics->p99Response = processCount > 0 ? responses[(99 * processCount + 99) / 100 - 1] : 0;
+
+  double n = processCount > 0 ? processCount : 1;
+  metrics->waiting = waiting / n;
+  metrics->turnaround = turnaround / n;
+  metrics->response = response / n;
+
+  SwitchStats stats = switchCostEnabled(config) ? getSwitchStats() : (SwitchStats){0, 0, 0};
+  int busy = stats.overheadCycles + stats.executedCycles;
+  metrics->switches = stats.switches;
+  metrics->overheadCycles = stats.overheadCycles;
+  metrics->switchOverhead = busy > 0 ? (double)stats.overheadCycles / busy : 0.0;
+}
+
+// Lee exactamente `size` bytes de un pipe; 0 en fin de archivo
+static int readRecord(int fd, void *buffer, size_t size)
+{
+  size_t done = 0;
+  while (done < size)
+  {
+    ssize_t n = read(fd, (char *)buffer + done, size - done);
+    if (n < 0 && errno == EINTR)
+      continue;
+    if (n <= 0)
+      return 0;
+    done += n;
+  }
+  return 1;
+}
+
+void runWorkerPool(int count, int workers, size_t resultSize, void *results, RunJob job, void *context)
+{
+  struct pollfd fds[RUN_POOL_MAX_WORKERS];
+  pid_t pids[RUN_POOL_MAX_WORKERS];
+  int open = 0;
+
+  // Registro del pipe: índice de la corrida seguido de su resultado
+  size_t recordSize = sizeof(int) + resultSize;
+  char *record = malloc(recordSize);
+  char *delivered = calloc(count > 0 ? count : 1, 1);
+  if (!record || !delivered)
+    workers = 1;
+  if (workers > RUN_POOL_MAX_WORKERS)
+    workers = RUN_POOL_MAX_WORKERS;
+  if (workers > count)
+    workers = count;
+
+  fflush(stdout);
+  for (int w = 0; w < workers && workers > 1; w++)
+  {
+    int ends[2];
+    if (pipe(ends) != 0)
+      continue;
+
+    pid_t pid = fork();
+    if (pid == 0)
+    {
+      close(ends[0]);
+      for (int o = 0; o < open; o++)
+        close(fds[o].fd);
+      for (int index = w; index < count; index += workers)
+      {
+        memcpy(record, &index, sizeof(int));
+        memset(record + sizeof(int), 0, resultSize);
+        job(index, record + sizeof(int), context);
+        if (write(ends[1], record, recordSize) != (ssize_t)recordSize)
+          _exit(EXIT_FAILURE);
+      }
+      _exit(EXIT_SUCCESS);
+    }
+
+    close(ends[1]);
+    if (pid < 0)
+    {
+      close(ends[0]);
+      continue;
+    }
+    pids[open] = pid;
+    fds[open].fd = ends[0];
+    fds[open].events = POLLIN;
+    open++;
+  }
+
+  int pending = open;
+  while (pending > 0)
+  {
+    if (poll(fds, open, -1) < 0)
+    {
+      if (errno == EINTR)
+        continue;
+      break;
+    }
+    for (int o = 0; o < open; o++)
+    {
+      if (fds[o].fd < 0 || !(fds[o].revents & (POLLIN | POLLHUP | POLLERR)))
+        continue;
+
+      int index;
+      if (readRecord(fds[o].fd, record, recordSize) && (memcpy(&index, record, sizeof(int)), index >= 0) &&
+          index < count)
+      {
+        memcpy((char *)results + index * resultSize, record + sizeof(int), resultSize);
+        delivered[index] = 1;
+        continue;
+      }
+      close(fds[o].fd);
+      fds[o].fd = -1; // poll ignora los descriptores negativos
+      pending--;
+    }
+  }
+  for (int o = 0; o < open; o++)
+    waitpid(pids[o], NULL, 0);
+
+  for (int index = 0; index < count; index++)
+  {
+    if (delivered && delivered[index])
+      continue;
+    job(index, (char *)results + index * resultSize, context);
+  }
+  free(record);
+  free(delivered);
+}
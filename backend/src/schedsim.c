@@ -0,0 +1,435 @@
+#include "schedsim.h"
+#include "session.h"
+#include "checkpoint.h"
+#include "io.h"
+#include "dag.h"
+#include "share.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Las estructuras públicas reflejan las internas
+_Static_assert(SCHEDSIM_NAME_LEN == COMMON_MAX_LEN, "SCHEDSIM_NAME_LEN debe coincidir con COMMON_MAX_LEN");
+_Static_assert((int)SCHEDSIM_STATE_OMITED == (int)STATE_OMITED, "SchedSimState debe coincidir con ProcessState");
+_Static_assert((int)SCHEDSIM_WRITE == (int)ACTION_WRITE, "SchedSimActionType debe coincidir con ActionType");
+
+/**
+ * Fases del motor: el motor corre en su propio hilo y se detiene al cerrar cada ciclo hasta que se
+ * pide el siguiente paso, así los pasos no requieren reescribir los bucles de los algoritmos.
+ */
+typedef enum
+{
+  PHASE_RUNNING, // El motor avanza (el llamador espera)
+  PHASE_PAUSED,  // El motor cerró un ciclo y espera el siguiente paso
+  PHASE_DONE     // La simulación terminó
+} SimPhase;
+
+struct SchedSim
+{
+  int mode;
+  SimulationControl control;
+  SyncConfig syncConfig;
+  int frames;
+
+  Process processes[MAX_PROCESSES];
+  int processCount;
+  Resource resources[MAX_PROCESSES];
+  int resourceCount;
+  Action actions[MAX_EVENTS];
+  int actionCount;
+
+  pthread_t thread;
+  pthread_mutex_t lock;
+  pthread_cond_t changed;
+  int started;
+  SimPhase phase;
+  int status;  // Resultado del motor (0: terminó)
+  int discard; // Se destruye antes de terminar: la salida restante se descarta
+  int cycle;
+
+  // Eventos del paso en curso (líneas JSON separadas por '\n')
+  char *events;
+  size_t eventsLength;
+  size_t eventsCapacity;
+  SchedSimEventCallback callback;
+  void *userData;
+};
+
+static pthread_mutex_t activeLock = PTHREAD_MUTEX_INITIALIZER;
+static SchedSim *activeSim = NULL;
+
+int schedsimVersion(void)
+{
+  return SCHEDSIM_API_VERSION;
+}
+
+void schedsimDefaultConfig(SchedSimConfig *config)
+{
+  config->mode = SCHEDSIM_SCHEDULING;
+  config->algorithm = "FIFO";
+  config->quantum = 1;
+  config->isPreemptive = 0;
+  config->frames = 0;
+  config->useMutex = 1;
+  config->priorityQueue = 0;
+  config->protocol = "none";
+  config->shards = 1;
+}
+
+// Traduce el nombre de un protocolo (-1 si no es válido)
+static int parseProtocolName(const char *str)
+{
+  if (!str)
+    return PROTOCOL_NONE;
+
+  for (int protocol = PROTOCOL_NONE; protocol <= PROTOCOL_CEILING; protocol++)
+  {
+    if (strcmp(str, getProtocolName(protocol)) == 0)
+      return protocol;
+  }
+  return -1;
+}
+
+// Traduce la configuración pública a la del simulador (-1 si no es válida)
+static int applyConfig(SchedSim *sim, const SchedSimConfig *config)
+{
+  if (config->mode != SCHEDSIM_SCHEDULING && config->mode != SCHEDSIM_SYNCHRONIZATION)
+    return -1;
+
+  SchedulingAlgorithm algorithm = config->algorithm ? parseAlgorithm(config->algorithm) : ALGO_NONE;
+  if ((config->algorithm || config->mode == SCHEDSIM_SCHEDULING) && algorithm == ALGO_NONE)
+    return -1;
+  // La simulación combinada no reparte por boletos
+  if (config->mode == SCHEDSIM_SYNCHRONIZATION && (algorithm == ALGO_LOTTERY || algorithm == ALGO_STRIDE))
+    return -1;
+  if (config->quantum <= 0)
+    return -1;
+
+  int protocol = parseProtocolName(config->protocol);
+  if (protocol < 0)
+    return -1;
+
+  // Mismos valores por defecto que la sesión de sincronización
+  SyncConfig syncConfig = {1, 0, PROTOCOL_NONE, 0, 1000, 2000, 0, {4, 100, 5.0, 1.0, 2.0, 50.0, 1000.0}, 1};
+  syncConfig.useMutex = config->useMutex;
+  syncConfig.priorityQueue = config->priorityQueue;
+  syncConfig.protocol = protocol;
+  if (config->shards > 0)
+    syncConfig.shards = config->shards;
+
+  // Los protocolos de prioridad y la simulación combinada requieren colas de espera
+  if (syncConfig.protocol != PROTOCOL_NONE || algorithm != ALGO_NONE)
+    syncConfig.priorityQueue = 1;
+
+  sim->mode = config->mode;
+  sim->control.config.algorithm = algorithm;
+  sim->control.config.quantum = config->quantum;
+  sim->control.config.isPreemptive = config->isPreemptive;
+  sim->control.config.share.seed = SHARE_DEFAULT_SEED;
+  sim->control.config.share.window = SHARE_DEFAULT_WINDOW;
+  sim->syncConfig = syncConfig;
+  sim->frames = config->frames;
+  return 0;
+}
+
+// Copia la carga pública con el mismo estado inicial que los archivos de entrada
+static void copyWorkload(SchedSim *sim,
+                         const SchedSimProcess *processes, int processCount,
+                         const SchedSimResource *resources, int resourceCount,
+                         const SchedSimAction *actions, int actionCount)
+{
+  for (int i = 0; i < processCount; i++)
+  {
+    Process *p = &sim->processes[i];
+    snprintf(p->pid, COMMON_MAX_LEN, "%.*s", COMMON_MAX_LEN - 1, processes[i].pid);
+    p->burstTime = processes[i].burstTime;
+    p->arrivalTime = processes[i].arrivalTime;
+    p->priority = processes[i].priority;
+    p->state = STATE_NEW;
+    p->startTime = -1;
+    p->finishTime = -1;
+    p->waitingTime = 0;
+  }
+
+  for (int i = 0; i < resourceCount; i++)
+  {
+    snprintf(sim->resources[i].name, COMMON_MAX_LEN, "%.*s", COMMON_MAX_LEN - 1, resources[i].name);
+    sim->resources[i].counter = resources[i].counter;
+    sim->resources[i].isLocked = 0;
+  }
+
+  for (int i = 0; i < actionCount; i++)
+  {
+    Action *a = &sim->actions[i];
+    snprintf(a->pid, COMMON_MAX_LEN, "%.*s", COMMON_MAX_LEN - 1, actions[i].pid);
+    snprintf(a->resourceName, COMMON_MAX_LEN, "%.*s", COMMON_MAX_LEN - 1, actions[i].resource);
+    a->action = actions[i].action == SCHEDSIM_READ    ? ACTION_READ
+                : actions[i].action == SCHEDSIM_WRITE ? ACTION_WRITE
+                                                      : ACTION_NONE;
+    a->cycle = actions[i].cycle;
+  }
+
+  sim->processCount = processCount;
+  sim->resourceCount = resourceCount;
+  sim->actionCount = actionCount;
+}
+
+SchedSim *schedsimCreate(const SchedSimConfig *config,
+                         const SchedSimProcess *processes, int processCount,
+                         const SchedSimResource *resources, int resourceCount,
+                         const SchedSimAction *actions, int actionCount)
+{
+  if (!config ||
+      processCount < 0 || processCount > MAX_PROCESSES || (processCount > 0 && !processes) ||
+      resourceCount < 0 || resourceCount > MAX_PROCESSES || (resourceCount > 0 && !resources) ||
+      actionCount < 0 || actionCount > MAX_EVENTS || (actionCount > 0 && !actions))
+    return NULL;
+
+  SchedSim *sim = calloc(1, sizeof(SchedSim));
+  if (!sim)
+    return NULL;
+
+  if (applyConfig(sim, config) != 0)
+  {
+    free(sim);
+    return NULL;
+  }
+  copyWorkload(sim, processes, processCount, resources, resourceCount, actions, actionCount);
+
+  // Los motores comparten el estado de salida: una simulación en curso a la vez
+  pthread_mutex_lock(&activeLock);
+  int busy = activeSim != NULL;
+  if (!busy)
+    activeSim = sim;
+  pthread_mutex_unlock(&activeLock);
+  if (busy)
+  {
+    free(sim);
+    return NULL;
+  }
+
+  pthread_mutex_init(&sim->lock, NULL);
+  pthread_cond_init(&sim->changed, NULL);
+  sim->phase = PHASE_PAUSED;
+  return sim;
+}
+
+void schedsimSetEventCallback(SchedSim *sim, SchedSimEventCallback callback, void *userData)
+{
+  if (!sim)
+    return;
+  sim->callback = callback;
+  sim->userData = userData;
+}
+
+// Libera la simulación en curso para que pueda crearse otra
+static void releaseActive(SchedSim *sim)
+{
+  pthread_mutex_lock(&activeLock);
+  if (activeSim == sim)
+    activeSim = NULL;
+  pthread_mutex_unlock(&activeLock);
+}
+
+// Destino de la salida (hilo del motor): agrega la línea a los eventos del paso
+static void appendEvent(const char *line, size_t length, void *context)
+{
+  SchedSim *sim = context;
+  if (sim->discard)
+    return;
+
+  if (sim->eventsLength + length + 2 > sim->eventsCapacity)
+  {
+    size_t capacity = sim->eventsCapacity ? sim->eventsCapacity : 4096;
+    while (sim->eventsLength + length + 2 > capacity)
+      capacity *= 2;
+
+    char *grown = realloc(sim->events, capacity);
+    if (!grown)
+      return;
+    sim->events = grown;
+    sim->eventsCapacity = capacity;
+  }
+  memcpy(sim->events + sim->eventsLength, line, length);
+  sim->eventsLength += length;
+  sim->events[sim->eventsLength++] = '\n';
+  sim->events[sim->eventsLength] = '\0';
+}
+
+// Fin de ciclo (hilo del motor): entrega el paso y espera el siguiente
+static void pauseAtCycleEnd(void *context)
+{
+  SchedSim *sim = context;
+
+  pthread_mutex_lock(&sim->lock);
+  sim->cycle++;
+  if (!sim->discard)
+  {
+    sim->phase = PHASE_PAUSED;
+    pthread_cond_broadcast(&sim->changed);
+    while (sim->phase == PHASE_PAUSED)
+      pthread_cond_wait(&sim->changed, &sim->lock);
+  }
+  pthread_mutex_unlock(&sim->lock);
+}
+
+static void *runSimulation(void *context)
+{
+  SchedSim *sim = context;
+  int status = 0;
+
+  configureCheckpoints(0, 0, NULL, 0);
+  configureIO(NULL, 0, NULL, 0); // La biblioteca simula solo ráfagas de CPU
+  configureDependencies(NULL, NULL, 0);
+  setFrameBatching(sim->frames);
+  setOutputSink(appendEvent, pauseAtCycleEnd, sim);
+
+  if (sim->mode == SCHEDSIM_SCHEDULING)
+  {
+    status = runSchedulingEngine(sim->processes, sim->processCount, &sim->control);
+  }
+  else
+  {
+    runSynchronizationEngine(sim->processes, sim->processCount,
+                             sim->resources, sim->resourceCount,
+                             sim->actions, sim->actionCount,
+                             &sim->syncConfig, &sim->control);
+  }
+
+  if (status == 0)
+    exportSimulationEnd();
+  setOutputSink(NULL, NULL, NULL);
+  setFrameBatching(0);
+  releaseActive(sim);
+
+  pthread_mutex_lock(&sim->lock);
+  sim->status = status;
+  sim->phase = PHASE_DONE;
+  pthread_cond_broadcast(&sim->changed);
+  pthread_mutex_unlock(&sim->lock);
+  return NULL;
+}
+
+// Entrega los eventos del paso al callback
+static void deliverEvents(SchedSim *sim)
+{
+  if (!sim->callback)
+    return;
+
+  const char *line = sim->events;
+  const char *end = sim->events + sim->eventsLength;
+  while (line < end)
+  {
+    const char *newline = memchr(line, '\n', end - line);
+    sim->callback(line, newline - line, sim->userData);
+    line = newline + 1;
+  }
+}
+
+int schedsimStep(SchedSim *sim)
+{
+  if (!sim)
+    return -1;
+
+  pthread_mutex_lock(&sim->lock);
+  sim->eventsLength = 0;
+  if (sim->events)
+    sim->events[0] = '\0';
+
+  if (sim->phase == PHASE_DONE)
+  {
+    pthread_mutex_unlock(&sim->lock);
+    return sim->status == 0 ? 0 : -1;
+  }
+
+  sim->phase = PHASE_RUNNING;
+  if (!sim->started)
+  {
+    if (pthread_create(&sim->thread, NULL, runSimulation, sim) != 0)
+    {
+      sim->status = -1;
+      sim->phase = PHASE_DONE;
+      pthread_mutex_unlock(&sim->lock);
+      releaseActive(sim);
+      return -1;
+    }
+    sim->started = 1;
+  }
+  else
+  {
+    pthread_cond_broadcast(&sim->changed);
+  }
+
+  while (sim->phase == PHASE_RUNNING)
+    pthread_cond_wait(&sim->changed, &sim->lock);
+  SimPhase phase = sim->phase;
+  pthread_mutex_unlock(&sim->lock);
+
+  deliverEvents(sim);
+  if (phase == PHASE_DONE)
+    return sim->status == 0 ? 0 : -1;
+  return 1;
+}
+
+int schedsimRun(SchedSim *sim)
+{
+  int status;
+  while ((status = schedsimStep(sim)) > 0)
+    ;
+  return status;
+}
+
+const char *schedsimEvents(const SchedSim *sim, size_t *length)
+{
+  if (length)
+    *length = sim && sim->events ? sim->eventsLength : 0;
+  return sim && sim->events ? sim->events : "";
+}
+
+int schedsimCycle(const SchedSim *sim)
+{
+  return sim ? sim->cycle : 0;
+}
+
+int schedsimResults(const SchedSim *sim, SchedSimResult *results, int capacity)
+{
+  if (!sim)
+    return 0;
+
+  for (int i = 0; i < sim->processCount && i < capacity; i++)
+  {
+    const Process *p = &sim->processes[i];
+    memcpy(results[i].pid, p->pid, COMMON_MAX_LEN);
+    results[i].state = p->state;
+    results[i].startTime = p->startTime;
+    results[i].endTime = p->finishTime;
+    results[i].waitingTime = p->waitingTime;
+  }
+  return sim->processCount;
+}
+
+void schedsimDestroy(SchedSim *sim)
+{
+  if (!sim)
+    return;
+
+  // Una simulación a medias se completa sin entregar eventos (los motores no se interrumpen)
+  pthread_mutex_lock(&sim->lock);
+  if (sim->started && sim->phase != PHASE_DONE)
+  {
+    sim->discard = 1;
+    sim->phase = PHASE_RUNNING;
+    pthread_cond_broadcast(&sim->changed);
+  }
+  pthread_mutex_unlock(&sim->lock);
+
+  if (sim->started)
+    pthread_join(sim->thread, NULL);
+  releaseActive(sim);
+
+  pthread_mutex_destroy(&sim->lock);
+  pthread_cond_destroy(&sim->changed);
+  free(sim->events);
+  free(sim);
+}
@@ -0,0 +1,336 @@
+#include "selection.h"
+#include <limits.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define SELECTION_X86 1
+#include <immintrin.h>
+#endif
+
+#define SELECTION_MAX_KEYS 3
+
+/**
+ * Búsqueda lexicográfica sobre las columnas: un proceso es candidato si está listo (llegó y su
+ * ráfaga pendiente es al menos `minRemaining`) y sus primeras claves son iguales a los mínimos ya
+ * encontrados.
+ */
+typedef struct
+{
+  const int *arrival;
+  const int *remaining;
+  int currentTime;
+  int minRemaining;
+  int count;
+  const int *keys[SELECTION_MAX_KEYS];
+  int mins[SELECTION_MAX_KEYS];
+} SelectionQuery;
+
+/**
+ * Operaciones de una implementación:
+ *  - minKey: mínimo de keys[depth] entre los candidatos con keys[0..depth-1] fijas (INT_MAX si no hay).
+ *  - firstMatch: primer candidato con keys[0..depth-1] fijas (-1 si no hay).
+ */
+typedef struct
+{
+  const char *name;
+  int (*minKey)(const SelectionQuery *q, int depth);
+  int (*firstMatch)(const SelectionQuery *q, int depth);
+} KernelOps;
+
+// ======================== ESCALAR ========================
+
+static int isCandidate(const SelectionQuery *q, int i, int depth)
+{
+  if (q->arrival[i] > q->currentTime || q->remaining[i] < q->minRemaining)
+    return 0;
+  for (int k = 0; k < depth; k++)
+  {
+    if (q->keys[k][i] != q->mins[k])
+      return 0;
+  }
+  return 1;
+}
+
+static int minKeyScalar(const SelectionQuery *q, int depth)
+{
+  int best = INT_MAX;
+  for (int i = 0; i < q->count; i++)
+  {
+    if (isCandidate(q, i, depth) && q->keys[depth][i] < best)
+      best = q->keys[depth][i];
+  }
+  return best;
+}
+
+static int firstMatchScalar(const SelectionQuery *q, int depth)
+{
+  for (int i = 0; i < q->count; i++)
+  {
+    if (isCandidate(q, i, depth))
+      return i;
+  }
+  return -1;
+}
+
+// Mínimo de los procesos [from, count) que no cubre el vector (resto del arreglo)
+static int minKeyTail(const SelectionQuery *q, int depth, int from, int best)
+{
+  for (int i = from; i < q->count; i++)
+  {
+    if (isCandidate(q, i, depth) && q->keys[depth][i] < best)
+      best = q->keys[depth][i];
+  }
+  return best;
+}
+
+static int firstMatchTail(const SelectionQuery *q, int depth, int from)
+{
+  for (int i = from; i < q->count; i++)
+  {
+    if (isCandidate(q, i, depth))
+      return i;
+  }
+  return -1;
+}
+
+#ifdef SELECTION_X86
+
+// ======================== SSE2 (4 procesos por instrucción) ========================
+
+// Máscara de candidatos de los procesos [i, i + 4)
+__attribute__((target("sse2"))) static __m128i candidateMaskSSE2(const SelectionQuery *q, int depth, int i)
+{
+  __m128i arrival = _mm_loadu_si128((const __m128i *)(q->arrival + i));
+  __m128i remaining = _mm_loadu_si128((const __m128i *)(q->remaining + i));
+  __m128i notReady = _mm_or_si128(_mm_cmpgt_epi32(arrival, _mm_set1_epi32(q->currentTime)),
+                                  _mm_cmpgt_epi32(_mm_set1_epi32(q->minRemaining), remaining));
+  __m128i mask = _mm_xor_si128(notReady, _mm_set1_epi32(-1));
+  for (int k = 0; k < depth; k++)
+  {
+    __m128i key = _mm_loadu_si128((const __m128i *)(q->keys[k] + i));
+    mask = _mm_and_si128(mask, _mm_cmpeq_epi32(key, _mm_set1_epi32(q->mins[k])));
+  }
+  return mask;
+}
+
+__attribute__((target("sse2"))) static int minKeySSE2(const SelectionQuery *q, int depth)
+{
+  __m128i best = _mm_set1_epi32(INT_MAX);
+  int i = 0;
+  for (; i + 4 <= q->count; i += 4)
+  {
+    __m128i mask = candidateMaskSSE2(q, depth, i);
+    __m128i key = _mm_loadu_si128((const __m128i *)(q->keys[depth] + i));
+    // Los no candidatos valen INT_MAX; SSE2 no tiene min de 32 bits, se arma con una comparación
+    key = _mm_or_si128(_mm_and_si128(mask, key), _mm_andnot_si128(mask, best));
+    __m128i lower = _mm_cmplt_epi32(key, best);
+    best = _mm_or_si128(_mm_and_si128(lower, key), _mm_andnot_si128(lower, best));
+  }
+
+  int lanes[4];
+  _mm_storeu_si128((__m128i *)lanes, best);
+  int result = lanes[0];
+  for (int l = 1; l < 4; l++)
+  {
+    if (lanes[l] < result)
+      result = lanes[l];
+  }
+  return minKeyTail(q, depth, i, result);
+}
+
+__attribute__((target("sse2"))) static int firstMatchSSE2(const SelectionQuery *q, int depth)
+{
+  int i = 0;
+  for (; i + 4 <= q->count; i += 4)
+  {
+    int bits = _mm_movemask_ps(_mm_castsi128_ps(candidateMaskSSE2(q, depth, i)));
+    if (bits)
+      return i + __builtin_ctz(bits);
+  }
+  return firstMatchTail(q, depth, i);
+}
+
+// ======================== AVX2 (8 procesos por instrucción) ========================
+
+__attribute__((target("avx2"))) static __m256i candidateMaskAVX2(const SelectionQuery *q, int depth, int i)
+{
+  __m256i arrival = _mm256_loadu_si256((const __m256i *)(q->arrival + i));
+  __m256i remaining = _mm256_loadu_si256((const __m256i *)(q->remaining + i));
+  __m256i notReady = _mm256_or_si256(_mm256_cmpgt_epi32(arrival, _mm256_set1_epi32(q->currentTime)),
+                                     _mm256_cmpgt_epi32(_mm256_set1_epi32(q->minRemaining), remaining));
+  __m256i mask = _mm256_xor_si256(notReady, _mm256_set1_epi32(-1));
+  for (int k = 0; k < depth; k++)
+  {
+    __m256i key = _mm256_loadu_si256((const __m256i *)(q->keys[k] + i));
+    mask = _mm256_and_si256(mask, _mm256_cmpeq_epi32(key, _mm256_set1_epi32(q->mins[k])));
+  }
+  return mask;
+}
+
+__attribute__((target("avx2"))) static int minKeyAVX2(const SelectionQuery *q, int depth)
+{
+  __m256i best = _mm256_set1_epi32(INT_MAX);
+  int i = 0;
+  for (; i + 8 <= q->count; i += 8)
+  {
+    __m256i mask = candidateMaskAVX2(q, depth, i);
+    __m256i key = _mm256_loadu_si256((const __m256i *)(q->keys[depth] + i));
+    best = _mm256_min_epi32(best, _mm256_blendv_epi8(best, key, mask));
+  }
+
+  // Reducción horizontal: 8 -> 4 -> 2 -> 1
+  __m128i half = _mm_min_epi32(_mm256_castsi256_si128(best), _mm256_extracti128_si256(best, 1));
+  half = _mm_min_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(1, 0, 3, 2)));
+  half = _mm_min_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(2, 3, 0, 1)));
+  return minKeyTail(q, depth, i, _mm_cvtsi128_si32(half));
+}
+
+__attribute__((target("avx2"))) static int firstMatchAVX2(const SelectionQuery *q, int depth)
+{
+  int i = 0;
+  for (; i + 8 <= q->count; i += 8)
+  {
+    int bits = _mm256_movemask_ps(_mm256_castsi256_ps(candidateMaskAVX2(q, depth, i)));
+    if (bits)
+      return i + __builtin_ctz(bits);
+  }
+  return firstMatchTail(q, depth, i);
+}
+
+#endif
+
+// ======================== SELECCIÓN EN TIEMPO DE EJECUCIÓN ========================
+
+static const KernelOps kernelOps[] = {
+    {"scalar", minKeyScalar, firstMatchScalar},
+#ifdef SELECTION_X86
+    {"sse2", minKeySSE2, firstMatchSSE2},
+    {"avx2", minKeyAVX2, firstMatchAVX2},
+#endif
+};
+
+static const KernelOps *activeKernel = NULL;
+
+static int kernelSupported(SelectionKernel kernel)
+{
+  switch (kernel)
+  {
+  case KERNEL_SCALAR:
+    return 1;
+#ifdef SELECTION_X86
+  case KERNEL_SSE2:
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("sse2");
+  case KERNEL_AVX2:
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#endif
+  default:
+    return 0;
+  }
+}
+
+// Implementación en uso; al primer uso se elige la mejor que soporte la CPU
+static const KernelOps *currentKernel(void)
+{
+  if (!activeKernel)
+  {
+    SelectionKernel best = KERNEL_SCALAR;
+    if (kernelSupported(KERNEL_AVX2))
+      best = KERNEL_AVX2;
+    else if (kernelSupported(KERNEL_SSE2))
+      best = KERNEL_SSE2;
+    activeKernel = &kernelOps[best];
+  }
+  return activeKernel;
+}
+
+int setSelectionKernel(SelectionKernel kernel)
+{
+  if (!kernelSupported(kernel))
+    return -1;
+  activeKernel = &kernelOps[kernel];
+  return 0;
+}
+
+const char *getSelectionKernelName(void)
+{
+  return currentKernel()->name;
+}
+
+// ======================== BÚSQUEDAS ========================
+
+void loadProcessColumns(ProcessColumns *columns, const Process *processes, int processCount)
+{
+  for (int i = 0; i < processCount; i++)
+  {
+    columns->arrival[i] = processes[i].arrivalTime;
+    columns->burst[i] = processes[i].burstTime;
+    columns->priority[i] = processes[i].priority;
+    columns->remaining[i] = processes[i].state == STATE_TERMINATED ? -1 : processes[i].burstTime;
+  }
+}
+
+// Mínimo lexicográfico por `keyCount` claves; en empate total, el de menor índice
+static int lexicographicArgmin(SelectionQuery *q, int keyCount)
+{
+  const KernelOps *ops = currentKernel();
+  for (int k = 0; k < keyCount; k++)
+  {
+    q->mins[k] = ops->minKey(q, k);
+  }
+  return ops->firstMatch(q, keyCount);
+}
+
+int selectShortestRemaining(const ProcessColumns *columns, int processCount, int currentTime, int lastIdx)
+{
+  SelectionQuery q = {columns->arrival, columns->remaining, currentTime, 1, processCount,
+                      {columns->remaining, columns->priority}};
+  q.mins[0] = currentKernel()->minKey(&q, 0);
+
+  // Empate en ráfaga pendiente: sigue el que ya estaba ejecutando
+  if (lastIdx >= 0 && lastIdx < processCount && isCandidate(&q, lastIdx, 1))
+    return lastIdx;
+
+  q.mins[1] = currentKernel()->minKey(&q, 1);
+  return currentKernel()->firstMatch(&q, 2);
+}
+
+int selectShortestJob(const ProcessColumns *columns, int processCount, int currentTime)
+{
+  SelectionQuery q = {columns->arrival, columns->remaining, currentTime, 0, processCount,
+                      {columns->burst, columns->arrival}};
+  return lexicographicArgmin(&q, 2);
+}
+
+int selectHighestPriority(const ProcessColumns *columns, int processCount, int currentTime)
+{
+  SelectionQuery q = {columns->arrival, columns->remaining, currentTime, 1, processCount,
+                      {columns->priority, columns->arrival, columns->burst}};
+  return lexicographicArgmin(&q, 3);
+}
+
+int selectFirstArrived(const ProcessColumns *columns, int processCount, int currentTime)
+{
+  SelectionQuery q = {columns->arrival, columns->remaining, currentTime, 1, processCount, {columns->arrival}};
+  return lexicographicArgmin(&q, 1);
+}
+
+int selectReadyProcess(const ProcessColumns *columns, int processCount, int currentTime,
+                       const SimulationConfig *config, int current)
+{
+  int preemptive = config->algorithm == ALGO_SRT || (config->algorithm == ALGO_PRIORITY && config->isPreemptive);
+  if (!preemptive && current != -1)
+    return current;
+
+  switch (config->algorithm)
+  {
+  case ALGO_SJF:
+    return selectShortestJob(columns, processCount, currentTime);
+  case ALGO_SRT:
+    return selectShortestRemaining(columns, processCount, currentTime, current);
+  case ALGO_PRIORITY:
+    return selectHighestPriority(columns, processCount, currentTime);
+  default:
+    return selectFirstArrived(columns, processCount, currentTime);
+  }
+}
@@ -0,0 +1,1419 @@
+#include "session.h"
+#include "fifo.h"
+#include "sjf.h"
+#include "rr.h"
+#include "ps.h"
+#include "srt.h"
+#include "lottery.h"
+#include "stride.h"
+#include "share.h"
+#include "synchronization.h"
+#include "combined.h"
+#include "switching.h"
+#include "sync_threads.h"
+#include "sync_spinlock.h"
+#include "checkpoint.h"
+#include "trace.h"
+#include "telemetry.h"
+#include "tuner.h"
+#include "io.h"
+#include "dag.h"
+#include "stream.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <stdbool.h>
+#include <cjson/cJSON.h>
+
+int loadWorkload(Workload *workload, const char *inputDir)
+{
+  char path[512];
+
+  // Los archivos ausentes se tratan como vacíos (calendarización no usa recursos ni acciones)
+  snprintf(path, sizeof(path), "%s/procesos.txt", inputDir);
+  workload->processCount = loadProcesses(path, workload->processes, MAX_PROCESSES);
+
+  snprintf(path, sizeof(path), "%s/recursos.txt", inputDir);
+  workload->resourceCount = loadResources(path, workload->resources, MAX_PROCESSES);
+
+  snprintf(path, sizeof(path), "%s/acciones.txt", inputDir);
+  workload->actionCount = loadActions(path, workload->actions, MAX_EVENTS);
+
+  // Dispositivos declarados y ráfagas de I/O del quinto campo de procesos.txt
+  snprintf(path, sizeof(path), "%s/dispositivos.txt", inputDir);
+  workload->deviceCount = loadDevices(path, workload->devices, MAX_DEVICES);
+  if (workload->deviceCount < 0)
+    workload->deviceCount = 0;
+  snprintf(path, sizeof(path), "%s/procesos.txt", inputDir);
+  loadBurstSequences(path, workload->processes, workload->bursts,
+                     workload->processCount > 0 ? workload->processCount : 0,
+                     workload->devices, &workload->deviceCount);
+
+  // Predecesores de cada proceso (sin el archivo, ninguno)
+  snprintf(path, sizeof(path), "%s/dependencias.txt", inputDir);
+  loadDependencies(path, workload->processes, workload->processCount > 0 ? workload->processCount : 0,
+                   workload->predecessors);
+
+  int status = workload->processCount < 0 ? -1 : 0;
+  if (workload->processCount < 0)
+    workload->processCount = 0;
+  if (workload->resourceCount < 0)
+    workload->resourceCount = 0;
+  if (workload->actionCount < 0)
+    workload->actionCount = 0;
+  return status;
+}
+
+char *readSessionConfig(FILE *in)
+{
+  size_t capacity = 512, length = 0;
+  char *line = malloc(capacity);
+  if (!line)
+    return NULL;
+
+  int c;
+  while ((c = fgetc(in)) != EOF && c != '\n')
+  {
+    if (length + 1 >= capacity)
+    {
+      char *grown = realloc(line, capacity * 2);
+      if (!grown)
+      {
+        free(line);
+        return NULL;
+      }
+      line = grown;
+      capacity *= 2;
+    }
+    line[length++] = (char)c;
+  }
+
+  if (c == EOF && length == 0)
+  {
+    free(line);
+    return NULL;
+  }
+  line[length] = '\0';
+  return line;
+}
+
+// Copia un string JSON a un campo de largo fijo (truncando)
+static void copyJsonString(char *dest, const cJSON *item)
+{
+  const char *value = cJSON_IsString(item) && item->valuestring ? item->valuestring : "";
+  snprintf(dest, COMMON_MAX_LEN, "%s", value);
+}
+
+// Valor entero de un campo JSON (o el valor por defecto si no es numérico)
+static int jsonInt(const cJSON *object, const char *key, int fallback)
+{
+  const cJSON *item = cJSON_GetObjectItemCaseSensitive(object, key);
+  return cJSON_IsNumber(item) ? item->valueint : fallback;
+}
+
+// Quantum de RR por prioridad: "priorityQuantum": {"<prioridad>": quantum, ...}
+static void parsePriorityQuantum(const cJSON *json, SimulationConfig *config)
+{
+  const cJSON *field = cJSON_GetObjectItemCaseSensitive(json, "priorityQuantum");
+  if (!cJSON_IsObject(field))
+    return;
+
+  const cJSON *item = NULL;
+  cJSON_ArrayForEach(item, field)
+  {
+    char *end = NULL;
+    long priority = strtol(item->string, &end, 10);
+    if (end == item->string || *end != '\0' || priority < 0 || priority >= MAX_PRIORITY_LEVELS)
+    {
+      fprintf(stderr, "Prioridad fuera de rango en priorityQuantum: %s (se ignora).\n", item->string);
+      continue;
+    }
+    if (cJSON_IsNumber(item) && item->valueint > 0)
+      config->priorityQuantum[priority] = item->valueint;
+  }
+}
+
+// Costo de los cambios de contexto: "contextSwitchCost", "warmupCost" y "warmupWindow" (ciclos)
+static void parseSwitchCost(const cJSON *json, SimulationConfig *config)
+{
+  SwitchCostConfig *cost = &config->switchCost;
+  cost->contextSwitch = jsonInt(json, "contextSwitchCost", 0);
+  cost->warmup = jsonInt(json, "warmupCost", 0);
+  cost->warmupWindow = jsonInt(json, "warmupWindow", 0);
+  if (cost->contextSwitch < 0 || cost->warmup < 0 || cost->warmupWindow < 0)
+  {
+    fprintf(stderr, "Costos de cambio de contexto negativos (se ignoran).\n");
+    memset(cost, 0, sizeof(*cost));
+  }
+}
+
+// Reparto proporcional de LOTTERY y STRIDE: "seed", "shareWindow" y "tickets": {"<pid>": boletos, ...}
+static void parseShareConfig(const cJSON *json, SimulationConfig *config)
+{
+  ShareConfig *share = &config->share;
+  share->seed = (unsigned int)jsonInt(json, "seed", SHARE_DEFAULT_SEED);
+  share->window = jsonInt(json, "shareWindow", SHARE_DEFAULT_WINDOW);
+  share->ticketCount = 0;
+
+  const cJSON *field = cJSON_GetObjectItemCaseSensitive(json, "tickets");
+  if (!cJSON_IsObject(field))
+    return;
+
+  const cJSON *item = NULL;
+  cJSON_ArrayForEach(item, field)
+  {
+    if (!cJSON_IsNumber(item) || item->valueint <= 0 || share->ticketCount >= MAX_PROCESSES)
+    {
+      fprintf(stderr, "Boletos inválidos para %s (se usan los de su prioridad).\n", item->string);
+      continue;
+    }
+    // Con más de STRIDE_ONE boletos el paso de STRIDE sería 0 y el proceso no dejaría ejecutar a nadie
+    int tickets = item->valueint;
+    if (tickets > STRIDE_ONE)
+    {
+      fprintf(stderr, "Boletos de %s mayores que %lld (se usan %lld).\n", item->string, STRIDE_ONE, STRIDE_ONE);
+      tickets = (int)STRIDE_ONE;
+    }
+    snprintf(share->ticketPid[share->ticketCount], COMMON_MAX_LEN, "%s", item->string);
+    share->tickets[share->ticketCount++] = tickets;
+  }
+}
+
+// Indica si el algoritmo reparte la CPU por boletos (LOTTERY o STRIDE)
+static int isShareAlgorithm(SchedulingAlgorithm algorithm)
+{
+  return algorithm == ALGO_LOTTERY || algorithm == ALGO_STRIDE;
+}
+
+// Incluye en la llave de la corrida las opciones que no van en los parámetros básicos (si se usan)
+static unsigned long long schedulingOptionsKey(unsigned long long key, const SimulationConfig *config)
+{
+  for (int i = 0; i < MAX_PRIORITY_LEVELS; i++)
+  {
+    if (config->priorityQuantum[i] > 0)
+    {
+      key = checkpointKey(key, config->priorityQuantum, sizeof(config->priorityQuantum));
+      break;
+    }
+  }
+  if (switchCostEnabled(config))
+    key = checkpointKey(key, &config->switchCost, sizeof(config->switchCost));
+  if (isShareAlgorithm(config->algorithm))
+    key = checkpointKey(key, &config->share, sizeof(config->share));
+  return key;
+}
+
+/**
+ * Snapshots y seek pedidos en la configuración de la sesión (ver checkpoint.h).
+ */
+typedef struct
+{
+  int interval;  // "checkpointInterval": ciclos entre snapshots (0: sin snapshots)
+  int seekCycle; // "seek": ciclo desde el que se emite la salida (0: desde el inicio)
+  char directory[256];
+} CheckpointSettings;
+
+// Indica si `name` es un nombre simple (sin "/" ni ".."), que no puede salir del directorio donde se ubica
+static bool isBareName(const char *name)
+{
+  return name[0] && !strchr(name, '/') && !strchr(name, '\\') && !strstr(name, "..");
+}
+
+static void parseCheckpointSettings(const cJSON *json, CheckpointSettings *settings)
+{
+  settings->interval = jsonInt(json, "checkpointInterval", 0);
+  settings->seekCycle = jsonInt(json, "seek", 0);
+  settings->directory[0] = '\0';
+
+  // "checkpointDir" es un subdirectorio de DEFAULT_CHECKPOINT_DIR: el cliente no elige dónde se escribe
+  const cJSON *dirField = cJSON_GetObjectItemCaseSensitive(json, "checkpointDir");
+  if (!cJSON_IsString(dirField) || !dirField->valuestring || !dirField->valuestring[0])
+    return;
+  if (isBareName(dirField->valuestring))
+    snprintf(settings->directory, sizeof(settings->directory), "%s/%s", DEFAULT_CHECKPOINT_DIR,
+             dirField->valuestring);
+  else
+    fprintf(stderr, "checkpointDir debe ser un nombre sin \"/\" ni \"..\" (se usa %s).\n", DEFAULT_CHECKPOINT_DIR);
+}
+
+// Archivo de la traza Chrome/Perfetto pedida con "trace": un nombre de archivo en TRACE_OUTPUT_DIR, o
+// true para la ruta por defecto. Con "/" o ".." no se escribe la traza.
+static void parseTracePath(const cJSON *json, char *path, size_t size)
+{
+  const cJSON *field = cJSON_GetObjectItemCaseSensitive(json, "trace");
+  path[0] = '\0';
+  if (cJSON_IsString(field) && field->valuestring && field->valuestring[0])
+  {
+    if (isBareName(field->valuestring))
+      snprintf(path, size, "%s/%s", TRACE_OUTPUT_DIR, field->valuestring);
+    else
+      fprintf(stderr, "trace debe ser un nombre de archivo sin \"/\" ni \"..\" (no se escribe la traza).\n");
+  }
+  else if (cJSON_IsTrue(field) || (cJSON_IsNumber(field) && field->valueint))
+    snprintf(path, size, "%s", DEFAULT_TRACE_PATH);
+}
+
+/**
+ * Búsqueda del quantum de RR: "tune": {"objective": "p99Response", "minQuantum": 1, "maxQuantum": 20,
+ * "points": 16, "perPriority": true, "workers": 4} o "tune": true (espera promedio, rango completo).
+ *
+ * @return 0 si la búsqueda está bien formada (o no se pidió), -1 si el objetivo no existe.
+ */
+static int parseTuneSettings(const cJSON *json, TuneSettings *tune)
+{
+  const cJSON *field = cJSON_GetObjectItemCaseSensitive(json, "tune");
+  memset(tune, 0, sizeof(*tune));
+  tune->active = cJSON_IsObject(field) || cJSON_IsTrue(field);
+  if (!cJSON_IsObject(field))
+    return 0;
+
+  const cJSON *objective = cJSON_GetObjectItemCaseSensitive(field, "objective");
+  if (cJSON_IsString(objective) && objective->valuestring)
+  {
+    int parsed = parseTuneObjective(objective->valuestring);
+    if (parsed < 0)
+    {
+      fprintf(stderr, "Tune: objetivo desconocido %s.\n", objective->valuestring);
+      return -1;
+    }
+    tune->objective = parsed;
+  }
+  tune->minQuantum = jsonInt(field, "minQuantum", 1);
+  tune->maxQuantum = jsonInt(field, "maxQuantum", 0);
+  tune->points = jsonInt(field, "points", 0);
+  tune->workers = jsonInt(field, "workers", 0);
+  const cJSON *perPriority = cJSON_GetObjectItemCaseSensitive(field, "perPriority");
+  tune->perPriority = cJSON_IsTrue(perPriority) || (cJSON_IsNumber(perPriority) && perPriority->valueint);
+  return 0;
+}
+
+// Firma de la corrida: modo, parámetros que afectan el resultado y carga de trabajo
+static unsigned long long runKey(const char *mode, const int *params, int paramCount,
+                                 const Process *processes, int processCount,
+                                 const Resource *resources, int resourceCount,
+                                 const Action *actions, int actionCount)
+{
+  unsigned long long key = checkpointKey(CHECKPOINT_KEY_SEED, mode, strlen(mode) + 1);
+  key = checkpointKey(key, params, sizeof(int) * paramCount);
+
+  for (int i = 0; i < processCount; i++)
+  {
+    const Process *p = &processes[i];
+    int fields[] = {p->burstTime, p->arrivalTime, p->priority, p->state};
+    key = checkpointKey(key, p->pid, strlen(p->pid) + 1);
+    key = checkpointKey(key, fields, sizeof(fields));
+  }
+  for (int i = 0; i < resourceCount; i++)
+  {
+    key = checkpointKey(key, resources[i].name, strlen(resources[i].name) + 1);
+    key = checkpointKey(key, &resources[i].counter, sizeof(int));
+  }
+  for (int i = 0; i < actionCount; i++)
+  {
+    int fields[] = {actions[i].action, actions[i].cycle};
+    key = checkpointKey(key, actions[i].pid, strlen(actions[i].pid) + 1);
+    key = checkpointKey(key, actions[i].resourceName, strlen(actions[i].resourceName) + 1);
+    key = checkpointKey(key, fields, sizeof(fields));
+  }
+  return key;
+}
+
+/**
+ * Consulta what-if: cambios sobre procesos de la carga base (-1 deja el campo sin cambios).
+ */
+typedef struct
+{
+  int active;
+  int count;
+  struct
+  {
+    char pid[COMMON_MAX_LEN];
+    int burstTime;
+    int arrivalTime;
+    int priority;
+  } changes[MAX_PROCESSES];
+} WhatIfQuery;
+
+// Lee el objeto "whatIf": { "processes": [ { "pid": "P2", "burstTime": 8 }, ... ] }
+static void parseWhatIf(const cJSON *json, WhatIfQuery *query)
+{
+  const cJSON *whatIf = cJSON_GetObjectItemCaseSensitive(json, "whatIf");
+  const cJSON *item;
+  query->active = cJSON_IsObject(whatIf);
+  query->count = 0;
+
+  cJSON_ArrayForEach(item, cJSON_GetObjectItemCaseSensitive(whatIf, "processes"))
+  {
+    if (query->count >= MAX_PROCESSES)
+      break;
+    copyJsonString(query->changes[query->count].pid, cJSON_GetObjectItemCaseSensitive(item, "pid"));
+    query->changes[query->count].burstTime = jsonInt(item, "burstTime", -1);
+    query->changes[query->count].arrivalTime = jsonInt(item, "arrivalTime", -1);
+    query->changes[query->count].priority = jsonInt(item, "priority", -1);
+    query->count++;
+  }
+}
+
+static int findProcessByPid(const Process *processes, int processCount, const char *pid)
+{
+  for (int i = 0; i < processCount; i++)
+  {
+    if (strcmp(processes[i].pid, pid) == 0)
+      return i;
+  }
+  return -1;
+}
+
+// Ejecuta el algoritmo de la sesión sobre `processes` (el contexto trae el resto de la sesión)
+typedef int (*SimulationRunner)(Process *processes, int processCount, void *context);
+
+// Emite la diferencia de métricas entre la corrida base y la variante
+static void printWhatIfReport(const Process *base, const Process *variant, const bool *modified,
+                              int processCount, int divergence, int baseCycles)
+{
+  char line[512];
+  int resumed = checkpointRestoredCycle();
+  int cycles = checkpointFinalCycle();
+
+  snprintf(line, sizeof(line),
+           "{\"event\": \"WHAT_IF\", \"divergenceCycle\": %d, \"resumedCycle\": %d, \"simulatedCycles\": %d, "
+           "\"baseCycles\": %d, \"cycles\": %d, \"baseAverageWaitingTime\": %.2f, \"averageWaitingTime\": %.2f}",
+           divergence, resumed, cycles - (resumed > 0 ? resumed : 0), baseCycles, cycles,
+           calculateMetrics((Process *)base, processCount).avgWaitingTime,
+           calculateMetrics((Process *)variant, processCount).avgWaitingTime);
+  printSummaryLine(line);
+
+  // Solo los procesos modificados o cuyas métricas cambiaron
+  for (int i = 0; i < processCount; i++)
+  {
+    const Process *b = &base[i];
+    const Process *v = &variant[i];
+    if (!modified[i] && b->state == v->state && b->startTime == v->startTime &&
+        b->finishTime == v->finishTime && b->waitingTime == v->waitingTime)
+      continue;
+
+    snprintf(line, sizeof(line),
+             "{\"event\": \"WHAT_IF_METRIC\", \"pid\": \"%s\", \"modified\": %d, \"state\": \"%s\", \"baseState\": \"%s\", "
+             "\"startTime\": %d, \"endTime\": %d, \"waitingTime\": %d, "
+             "\"startTimeDelta\": %d, \"endTimeDelta\": %d, \"waitingTimeDelta\": %d}",
+             v->pid, modified[i] ? 1 : 0, getProcessStateName(v->state), getProcessStateName(b->state),
+             v->startTime, v->finishTime, v->waitingTime,
+             v->startTime - b->startTime, v->finishTime - b->finishTime, v->waitingTime - b->waitingTime);
+    printSummaryLine(line);
+  }
+}
+
+/**
+ * Re-simula la carga con los cambios de la consulta what-if a partir de la corrida base.
+ *
+ * El resultado de la corrida base se lee de su archivo de snapshots; si no existe, se simula una vez
+ * completa (sin salida) y queda guardado. La variante parte del snapshot anterior al primer ciclo en
+ * que puede divergir (la llegada más temprana, antes o después del cambio, de un proceso modificado)
+ * y simula solo el resto.
+ *
+ * @param processes Entrada: procesos de la carga base. Salida: procesos de la variante.
+ * @param syncMode  En sincronización, los cambios de prioridad (techos de los recursos) y las ráfagas
+ *                  nulas (terminan en el ciclo 0) divergen desde el inicio.
+ */
+static int runWhatIf(const WhatIfQuery *query, const CheckpointSettings *checkpoints,
+                     unsigned long long baseKey, int syncMode,
+                     Process *processes, int processCount,
+                     SimulationRunner run, void *context)
+{
+  static Process base[MAX_PROCESSES];
+  bool modified[MAX_PROCESSES] = {false};
+  int baseCycles = 0;
+
+  if (readCheckpointResult(checkpoints->directory, baseKey, base, processCount, &baseCycles) != 0)
+  {
+    // Primera consulta sobre esta carga: simular la base y guardar sus snapshots
+    int interval = checkpoints->interval > 0 ? checkpoints->interval : DEFAULT_CHECKPOINT_INTERVAL;
+    memcpy(base, processes, sizeof(Process) * processCount);
+    configureCheckpoints(interval, 0, checkpoints->directory, baseKey);
+    setOutputMuted(1);
+    int status = run(base, processCount, context);
+    setOutputMuted(0);
+    if (status != 0)
+      return -1;
+    baseCycles = checkpointFinalCycle();
+  }
+
+  // Aplicar los cambios y ubicar el primer ciclo en que la variante puede divergir
+  int divergence = INT_MAX;
+  for (int c = 0; c < query->count; c++)
+  {
+    int i = findProcessByPid(processes, processCount, query->changes[c].pid);
+    if (i < 0)
+    {
+      fprintf(stderr, "What-if: el proceso %s no existe en la carga.\n", query->changes[c].pid);
+      return -1;
+    }
+
+    Process before = processes[i];
+    if (query->changes[c].burstTime >= 0)
+      processes[i].burstTime = query->changes[c].burstTime;
+    if (query->changes[c].arrivalTime >= 0)
+      processes[i].arrivalTime = query->changes[c].arrivalTime;
+    if (query->changes[c].priority >= 0)
+      processes[i].priority = query->changes[c].priority;
+    modified[i] = true;
+
+    int first = before.arrivalTime < processes[i].arrivalTime ? before.arrivalTime : processes[i].arrivalTime;
+    if (syncMode && (before.priority != processes[i].priority ||
+                     before.burstTime == 0 || processes[i].burstTime == 0))
+      first = 0;
+    if (first < divergence)
+      divergence = first;
+  }
+  if (divergence == INT_MAX)
+    divergence = baseCycles;
+
+  configureWhatIf(checkpoints->directory, baseKey, divergence);
+  if (run(processes, processCount, context) != 0)
+    return -1;
+
+  printWhatIfReport(base, processes, modified, processCount, divergence, baseCycles);
+  return 0;
+}
+
+// Declara un dispositivo (o actualiza la política de uno ya referenciado por una ráfaga)
+static void declareDevice(Workload *workload, const char *name, const char *policy)
+{
+  int d = findOrAddDevice(workload->devices, &workload->deviceCount, name);
+  if (d >= 0)
+    workload->devices[d].policy = policy && strcmp(policy, "PRIORITY") == 0 ? DEVICE_PRIORITY : DEVICE_FCFS;
+}
+
+// Ráfagas del proceso: "bursts": [{"cpu": 3}, {"io": 4, "device": "disk"}, {"cpu": 2}]
+static void parseJsonBursts(const cJSON *item, Process *process, BurstSequence *sequence, Workload *workload)
+{
+  const cJSON *burst;
+  int valid = 1;
+  sequence->count = 0;
+
+  cJSON_ArrayForEach(burst, cJSON_GetObjectItemCaseSensitive(item, "bursts"))
+  {
+    const cJSON *cpu = cJSON_GetObjectItemCaseSensitive(burst, "cpu");
+    if (cJSON_IsNumber(cpu))
+    {
+      valid &= addBurst(sequence, -1, cpu->valueint);
+      continue;
+    }
+
+    const cJSON *deviceName = cJSON_GetObjectItemCaseSensitive(burst, "device");
+    int device = findOrAddDevice(workload->devices, &workload->deviceCount,
+                                 cJSON_IsString(deviceName) && deviceName->valuestring ? deviceName->valuestring
+                                                                                       : DEFAULT_IO_DEVICE);
+    valid &= device >= 0 && addBurst(sequence, device, jsonInt(burst, "io", 0));
+  }
+  finishBurstSequence(process, sequence, valid);
+}
+
+/**
+ * Rechaza un proceso de la carga en línea que los motores no pueden simular (igual que el batch-runner:
+ * con burstTime <= 0 el proceso nunca termina). Se llama después de leer sus ráfagas, que definen el
+ * burstTime cuando las trae.
+ *
+ * @return 0 si es válido, -1 (con el motivo en stderr) si no.
+ */
+static int checkWorkloadProcess(const Process *p, int index)
+{
+  const char *reason = NULL;
+  if (p->burstTime <= 0)
+    reason = "burstTime debe ser mayor que 0";
+  else if (p->arrivalTime < 0)
+    reason = "arrivalTime no puede ser negativo";
+
+  if (!reason)
+    return 0;
+  fprintf(stderr, "Proceso %d (%s) de la carga en línea inválido: %s.\n", index, p->pid, reason);
+  return -1;
+}
+
+/**
+ * Carga la carga de trabajo desde el objeto JSON "workload".
+ *
+ * @return 0 si es válida, -1 si algún proceso no tiene pid (o excede COMMON_MAX_LEN - 1 caracteres),
+ *         no trae un burstTime positivo o llega en un ciclo negativo.
+ */
+static int parseJsonWorkload(const cJSON *json, Workload *workload)
+{
+  const cJSON *item;
+
+  cJSON_ArrayForEach(item, cJSON_GetObjectItemCaseSensitive(json, "devices"))
+  {
+    char name[COMMON_MAX_LEN] = "";
+    const cJSON *queue = cJSON_GetObjectItemCaseSensitive(item, "queue");
+    copyJsonString(name, cJSON_GetObjectItemCaseSensitive(item, "name"));
+    if (name[0])
+      declareDevice(workload, name, cJSON_IsString(queue) ? queue->valuestring : NULL);
+  }
+
+  cJSON_ArrayForEach(item, cJSON_GetObjectItemCaseSensitive(json, "processes"))
+  {
+    if (workload->processCount >= MAX_PROCESSES)
+      break;
+    Process *p = &workload->processes[workload->processCount];
+    const cJSON *pid = cJSON_GetObjectItemCaseSensitive(item, "pid");
+    if (!cJSON_IsString(pid) || !pid->valuestring || !pid->valuestring[0] ||
+        strlen(pid->valuestring) >= COMMON_MAX_LEN)
+    {
+      fprintf(stderr, "Proceso %d de la carga en línea inválido: pid vacío o de más de %d caracteres.\n",
+              workload->processCount, COMMON_MAX_LEN - 1);
+      return -1;
+    }
+    copyJsonString(p->pid, pid);
+    p->burstTime = jsonInt(item, "burstTime", 0);
+    p->arrivalTime = jsonInt(item, "arrivalTime", 0);
+    p->priority = jsonInt(item, "priority", 0);
+    p->state = STATE_NEW;
+    p->startTime = -1;
+    p->finishTime = -1;
+    p->waitingTime = 0;
+    parseJsonBursts(item, p, &workload->bursts[workload->processCount], workload);
+    if (checkWorkloadProcess(p, workload->processCount) != 0)
+      return -1;
+
+    // "dependsOn": ["P1", "P2"]: se resuelven al configurar la simulación
+    PredecessorList *list = &workload->predecessors[workload->processCount];
+    const cJSON *predecessor;
+    list->count = 0;
+    cJSON_ArrayForEach(predecessor, cJSON_GetObjectItemCaseSensitive(item, "dependsOn"))
+    {
+      if (list->count < MAX_PREDECESSORS && cJSON_IsString(predecessor))
+        copyJsonString(list->pid[list->count++], predecessor);
+    }
+    workload->processCount++;
+  }
+
+  cJSON_ArrayForEach(item, cJSON_GetObjectItemCaseSensitive(json, "resources"))
+  {
+    if (workload->resourceCount >= MAX_PROCESSES)
+      break;
+    Resource *r = &workload->resources[workload->resourceCount++];
+    copyJsonString(r->name, cJSON_GetObjectItemCaseSensitive(item, "name"));
+    r->counter = jsonInt(item, "counter", 1);
+    r->isLocked = 0;
+  }
+
+  cJSON_ArrayForEach(item, cJSON_GetObjectItemCaseSensitive(json, "actions"))
+  {
+    if (workload->actionCount >= MAX_EVENTS)
+      break;
+    Action *a = &workload->actions[workload->actionCount++];
+    const cJSON *type = cJSON_GetObjectItemCaseSensitive(item, "action");
+    copyJsonString(a->pid, cJSON_GetObjectItemCaseSensitive(item, "pid"));
+    copyJsonString(a->resourceName, cJSON_GetObjectItemCaseSensitive(item, "resource"));
+    a->action = cJSON_IsString(type) && type->valuestring ? parseActionType(type->valuestring) : ACTION_NONE;
+    a->cycle = jsonInt(item, "cycle", 0);
+  }
+  return 0;
+}
+
+/**
+ * Carga la carga de trabajo desde el bloque compacto: las líneas de procesos.txt, recursos.txt,
+ * acciones.txt, dispositivos.txt y dependencias.txt precedidas por los encabezados "#procesos",
+ * "#recursos", "#acciones", "#dispositivos" y "#dependencias" (después de los procesos).
+ */
+static int parseCompactWorkload(char *block, Workload *workload)
+{
+  enum
+  {
+    SECTION_NONE,
+    SECTION_PROCESSES,
+    SECTION_RESOURCES,
+    SECTION_ACTIONS,
+    SECTION_DEVICES,
+    SECTION_DEPENDENCIES
+  } section = SECTION_NONE;
+
+  for (char *line = strtok(block, "\n"); line; line = strtok(NULL, "\n"))
+  {
+    line[strcspn(line, "\r")] = '\0';
+
+    if (strcmp(line, "#procesos") == 0)
+      section = SECTION_PROCESSES;
+    else if (strcmp(line, "#recursos") == 0)
+      section = SECTION_RESOURCES;
+    else if (strcmp(line, "#acciones") == 0)
+      section = SECTION_ACTIONS;
+    else if (strcmp(line, "#dispositivos") == 0)
+      section = SECTION_DEVICES;
+    else if (strcmp(line, "#dependencias") == 0)
+      section = SECTION_DEPENDENCIES;
+    else if (section == SECTION_PROCESSES && workload->processCount < MAX_PROCESSES)
+    {
+      Process *p = &workload->processes[workload->processCount];
+      if (parseProcessLine(line, p))
+      {
+        parseBurstField(line, p, &workload->bursts[workload->processCount], workload->devices, &workload->deviceCount);
+        if (checkWorkloadProcess(p, workload->processCount) != 0)
+          return -1;
+        workload->processCount++;
+      }
+    }
+    else if (section == SECTION_RESOURCES && workload->resourceCount < MAX_PROCESSES)
+      workload->resourceCount += parseResourceLine(line, &workload->resources[workload->resourceCount]);
+    else if (section == SECTION_ACTIONS && workload->actionCount < MAX_EVENTS)
+      workload->actionCount += parseActionLine(line, &workload->actions[workload->actionCount]);
+    else if (section == SECTION_DEVICES)
+    {
+      Device device;
+      if (parseDeviceLine(line, &device))
+        declareDevice(workload, device.name, device.policy == DEVICE_PRIORITY ? "PRIORITY" : "FCFS");
+    }
+    else if (section == SECTION_DEPENDENCIES)
+      parseDependencyLine(line, workload->processes, workload->processCount, workload->predecessors);
+  }
+  return 0;
+}
+
+int loadInlineWorkload(const char *configLine, FILE *in, Workload *workload)
+{
+  if (!configLine)
+    return 0;
+
+  cJSON *json = cJSON_Parse(configLine);
+  if (!json)
+    return 0;
+
+  const cJSON *inlineJson = cJSON_GetObjectItemCaseSensitive(json, "workload");
+  const cJSON *bytesField = cJSON_GetObjectItemCaseSensitive(json, "workloadBytes");
+  int status = 0;
+
+  if (cJSON_IsObject(inlineJson) || cJSON_IsNumber(bytesField))
+  {
+    workload->processCount = 0;
+    workload->resourceCount = 0;
+    workload->actionCount = 0;
+    workload->deviceCount = 0;
+    for (int i = 0; i < MAX_PROCESSES; i++)
+      workload->predecessors[i].count = 0;
+    status = 1;
+  }
+
+  if (cJSON_IsObject(inlineJson))
+  {
+    if (parseJsonWorkload(inlineJson, workload) != 0)
+      status = -1;
+  }
+  else if (cJSON_IsNumber(bytesField))
+  {
+    // El bloque compacto sigue a la línea de configuración y mide exactamente workloadBytes
+    size_t size = bytesField->valuedouble > 0 ? (size_t)bytesField->valuedouble : 0;
+    char *block = malloc(size + 1);
+    if (!block || fread(block, 1, size, in) != size)
+    {
+      fprintf(stderr, "Bloque de carga incompleto: se esperaban %zu bytes.\n", size);
+      status = -1;
+    }
+    else
+    {
+      block[size] = '\0';
+      if (parseCompactWorkload(block, workload) != 0)
+        status = -1;
+    }
+    free(block);
+  }
+
+  if (status == 1 && (workload->processCount >= MAX_PROCESSES || workload->actionCount >= MAX_EVENTS))
+    fprintf(stderr, "Carga en línea truncada a %d procesos y %d acciones.\n", MAX_PROCESSES, MAX_EVENTS);
+
+  cJSON_Delete(json);
+  return status;
+}
+
+// ======================== CALENDARIZACIÓN ========================
+
+// Opciones del algoritmo: algorithm, quantum, isPreemptive, priorityQuantum, costo de cambio y boletos
+static void readAlgorithmOptions(const cJSON *json, SimulationConfig *config)
+{
+  const cJSON *alg = cJSON_GetObjectItemCaseSensitive(json, "algorithm");
+  const cJSON *quant = cJSON_GetObjectItemCaseSensitive(json, "quantum");
+  const cJSON *preempt = cJSON_GetObjectItemCaseSensitive(json, "isPreemptive");
+
+  if (cJSON_IsString(alg) && alg->valuestring)
+    config->algorithm = parseAlgorithm(alg->valuestring);
+
+  if (cJSON_IsNumber(quant))
+    config->quantum = quant->valueint;
+  parsePriorityQuantum(json, config);
+  parseSwitchCost(json, config);
+  parseShareConfig(json, config);
+
+  if (cJSON_IsNumber(preempt))
+    config->isPreemptive = preempt->valueint;
+}
+
+int parseSimulationConfig(const char *configLine, SimulationConfig *config)
+{
+  cJSON *json = configLine ? cJSON_Parse(configLine) : NULL;
+  if (!cJSON_IsObject(json))
+  {
+    cJSON_Delete(json);
+    return -1;
+  }
+  readAlgorithmOptions(json, config);
+  cJSON_Delete(json);
+  return 0;
+}
+
+// Lee la configuración de calendarización (en formato JSON) usando cJSON; -1 si no es válida
+static int parseSchedulingConfig(const char *configLine, SimulationControl *control,
+                                 CheckpointSettings *checkpoints, WhatIfQuery *whatIf,
+                                 char *tracePath, size_t tracePathSize, int *telemetryWindow,
+                                 TuneSettings *tune)
+{
+  if (configLine && configLine[0] != '\0')
+  {
+    cJSON *json = cJSON_Parse(configLine);
+    if (json == NULL)
+    {
+      fprintf(stderr, "Error al parsear configuración JSON.\n");
+      return -1;
+    }
+
+    const cJSON *alg = cJSON_GetObjectItemCaseSensitive(json, "algorithm");
+    readAlgorithmOptions(json, &control->config);
+
+    // Un frame por ciclo con todos sus eventos
+    const cJSON *framesField = cJSON_GetObjectItemCaseSensitive(json, "frames");
+    setFrameBatching(cJSON_IsNumber(framesField) ? framesField->valueint : cJSON_IsTrue(framesField));
+
+    parseCheckpointSettings(json, checkpoints);
+    parseWhatIf(json, whatIf);
+    parseTracePath(json, tracePath, tracePathSize);
+    *telemetryWindow = jsonInt(json, "telemetryWindow", 0);
+    if (parseTuneSettings(json, tune) != 0)
+    {
+      cJSON_Delete(json);
+      return -1;
+    }
+
+    printf("Algoritmo: %s | Quantum: %d | Preemptivo: %s\n",
+           alg && alg->valuestring ? alg->valuestring : "(none)",
+           control->config.quantum,
+           control->config.isPreemptive ? "Sí" : "No");
+
+    cJSON_Delete(json);
+  }
+  return 0;
+}
+
+int runSchedulingEngine(Process *processes, int processCount, SimulationControl *control)
+{
+  static TimelineEvent timelineEvents[MAX_EVENTS];
+  int eventCount = 0;
+
+  if (ioModelActive() && isShareAlgorithm(control->config.algorithm))
+  {
+    fprintf(stderr, "%s: no se admite en cargas con ráfagas de I/O.\n", getAlgorithmName(control->config.algorithm));
+    return -1;
+  }
+  if (ioModelActive() && control->config.algorithm != ALGO_NONE)
+  {
+    // Con ráfagas de I/O cualquier algoritmo corre sobre el motor con dispositivos
+    simulateIO(processes, processCount, timelineEvents, &eventCount, control);
+  }
+  else
+  {
+    switch (control->config.algorithm)
+    {
+    case ALGO_FIFO:
+      simulateFIFO(processes, processCount, timelineEvents, &eventCount, control);
+      break;
+    case ALGO_SJF:
+      simulateSJF(processes, processCount, timelineEvents, &eventCount, control);
+      break;
+    case ALGO_RR:
+      simulateRR(processes, processCount, timelineEvents, &eventCount, control);
+      break;
+    case ALGO_PRIORITY:
+      simulatePS(processes, processCount, timelineEvents, &eventCount, control);
+      break;
+    case ALGO_SRT:
+      simulateSRT(processes, processCount, timelineEvents, &eventCount, control);
+      break;
+    case ALGO_LOTTERY:
+      simulateLottery(processes, processCount, timelineEvents, &eventCount, control);
+      break;
+    case ALGO_STRIDE:
+      simulateStride(processes, processCount, timelineEvents, &eventCount, control);
+      break;
+    default:
+      printf("Algoritmo no soportado.\n");
+      return -1;
+    }
+  }
+
+  flushCycleFrame();
+  DependencyStats dependencies = {0, 0, 0, 0};
+  if (dependenciesActive())
+    dependencies = exportDependencyReport(processes, processCount);
+  SimulationMetrics metrics = calculateMetrics(processes, processCount);
+  char line[384];
+  int n = snprintf(line, sizeof(line), "{\"type\": \"metrics\", \"Average Waiting Time\": %.2f", metrics.avgWaitingTime);
+  if (switchCostEnabled(&control->config))
+  {
+    // Cambios de contexto y fracción del tiempo de CPU ocupado que se perdió en ellos
+    SwitchStats stats = getSwitchStats();
+    int busy = stats.overheadCycles + stats.executedCycles;
+    n += snprintf(line + n, sizeof(line) - n,
+                  ", \"Context Switches\": %d, \"Switch Overhead Cycles\": %d, \"Switch Overhead\": %.4f",
+                  stats.switches, stats.overheadCycles, busy > 0 ? (double)stats.overheadCycles / busy : 0.0);
+  }
+  if (isShareAlgorithm(control->config.algorithm))
+  {
+    // Fracción de la CPU que no fue a quien le correspondía por sus boletos
+    n += snprintf(line + n, sizeof(line) - n, ", \"Share Error\": %.4f", getShareError());
+  }
+  if (ioModelActive())
+  {
+    // Ocupación de la CPU y espera promedio en las colas de los dispositivos
+    IoStats stats = getIoStats();
+    n += snprintf(line + n, sizeof(line) - n, ", \"CPU Utilization\": %.4f, \"Average I/O Wait\": %.2f",
+                  stats.cycles > 0 ? (double)stats.cpuBusyCycles / stats.cycles : 0.0,
+                  stats.processCount > 0 ? (double)stats.ioWaitCycles / stats.processCount : 0.0);
+  }
+  if (dependenciesActive())
+  {
+    // Makespan logrado frente a la cota inferior (camino crítico o trabajo total de la CPU)
+    n += snprintf(line + n, sizeof(line) - n,
+                  ", \"Critical Path\": %d, \"Makespan\": %d, \"Lower Bound\": %d, \"Bound Gap\": %.4f",
+                  dependencies.criticalPath, dependencies.makespan, dependencies.lowerBound,
+                  dependencies.lowerBound > 0
+                      ? (double)(dependencies.makespan - dependencies.lowerBound) / dependencies.lowerBound
+                      : 0.0);
+  }
+  snprintf(line + n, sizeof(line) - n, "}");
+  printSummaryLine(line);
+  // exportMetrics("../data/output/metrics.txt", metrics);
+  // exportTimelineEvents("../data/output/timeline.txt", timelineEvents, eventCount);
+  return 0;
+}
+
+static int runSchedulingAlgorithm(Process *processes, int processCount, void *context)
+{
+  return runSchedulingEngine(processes, processCount, context);
+}
+
+int runSchedulingSession(const char *configLine, const Workload *workload)
+{
+  static Process processes[MAX_PROCESSES];
+  static WhatIfQuery whatIf;
+  SimulationControl control = {{ALGO_NONE, 1, 0}};
+  CheckpointSettings checkpoints = {0, 0, ""};
+  char tracePath[256] = "";
+  int telemetryWindow = 0;
+  TuneSettings tune = {0};
+
+  whatIf.active = 0;
+  if (parseSchedulingConfig(configLine, &control, &checkpoints, &whatIf,
+                            tracePath, sizeof(tracePath), &telemetryWindow, &tune) != 0)
+    return -1;
+
+  // Copiar los procesos de la carga de trabajo (la simulación los modifica)
+  int processCount = workload->processCount;
+  memcpy(processes, workload->processes, sizeof(Process) * processCount);
+  configureIO(workload->bursts, processCount, workload->devices, workload->deviceCount);
+  if (configureDependencies(workload->predecessors, processes, processCount) != 0)
+    return -1;
+
+  printf("=== Procesos Cargados (%d) ===\n", processCount);
+  for (int i = 0; i < processCount; i++)
+  {
+    printf("PID: %s, BT: %d, AT: %d, Priority: %d, State: %s\n",
+           processes[i].pid,
+           processes[i].burstTime,
+           processes[i].arrivalTime,
+           processes[i].priority,
+           getProcessStateName(processes[i].state));
+  }
+
+  printf("\n=== Ejecutando Algoritmo: %s ===\n", getAlgorithmName(control.config.algorithm));
+
+  int params[] = {control.config.algorithm, control.config.quantum, control.config.isPreemptive};
+  unsigned long long key = runKey("scheduling", params, 3, processes, processCount, NULL, 0, NULL, 0);
+  key = schedulingOptionsKey(key, &control.config);
+  key = dependencyKey(key);
+  if (ioModelActive())
+  {
+    // Las ráfagas y los dispositivos también determinan el resultado
+    for (int i = 0; i < processCount; i++)
+    {
+      const BurstSequence *sequence = &workload->bursts[i];
+      key = checkpointKey(key, &sequence->count, sizeof(int));
+      key = checkpointKey(key, sequence->length, sizeof(int) * sequence->count);
+      key = checkpointKey(key, sequence->device, sizeof(int) * sequence->count);
+    }
+    for (int d = 0; d < workload->deviceCount; d++)
+    {
+      key = checkpointKey(key, workload->devices[d].name, strlen(workload->devices[d].name) + 1);
+      key = checkpointKey(key, &workload->devices[d].policy, sizeof(DeviceQueuePolicy));
+    }
+  }
+
+  if (tune.active)
+  {
+    // Solo RR tiene quantum; la búsqueda reemplaza a la simulación de la sesión
+    if (control.config.algorithm != ALGO_RR)
+    {
+      fprintf(stderr, "Tune: la búsqueda del quantum requiere el algoritmo RR.\n");
+      return -1;
+    }
+    if (runQuantumTuning(&tune, processes, processCount, &control.config) != 0)
+      return -1;
+  }
+  else if (whatIf.active)
+  {
+    // Los cambios de what-if son sobre burstTime; con secuencias de ráfagas no tienen sentido
+    if (ioModelActive())
+    {
+      fprintf(stderr, "What-if: no se admite en cargas con ráfagas de I/O.\n");
+      return -1;
+    }
+    if (runWhatIf(&whatIf, &checkpoints, key, 0, processes, processCount, runSchedulingAlgorithm, &control) != 0)
+      return -1;
+  }
+  else
+  {
+    configureCheckpoints(checkpoints.interval, checkpoints.seekCycle, checkpoints.directory, key);
+    if (tracePath[0])
+      openTrace(tracePath, getAlgorithmName(control.config.algorithm), processes, processCount);
+    configureTelemetry(telemetryWindow, processes, processCount, NULL, 0);
+
+    int status = runSchedulingAlgorithm(processes, processCount, &control);
+    finishTelemetry();
+    closeTrace();
+    if (status != 0)
+      return -1;
+  }
+
+  exportSimulationEnd();
+
+  return 0;
+}
+
+int isStreamSession(const char *configLine)
+{
+  cJSON *json = configLine ? cJSON_Parse(configLine) : NULL;
+  int stream = json && cJSON_IsTrue(cJSON_GetObjectItemCaseSensitive(json, "stream"));
+  cJSON_Delete(json);
+  return stream;
+}
+
+int runStreamSession(const char *configLine, FILE *in)
+{
+  static Process slots[STREAM_MAX_LIVE];
+  static TimelineEvent timelineEvents[MAX_EVENTS];
+  static WhatIfQuery whatIf;
+  SimulationControl control = {{ALGO_NONE, 1, 0}};
+  CheckpointSettings checkpoints = {0, 0, ""};
+  char tracePath[256] = "";
+  int telemetryWindow = 0;
+  TuneSettings tune = {0};
+  int eventCount = 0;
+
+  whatIf.active = 0;
+  if (parseSchedulingConfig(configLine, &control, &checkpoints, &whatIf,
+                            tracePath, sizeof(tracePath), &telemetryWindow, &tune) != 0)
+    return -1;
+
+  // La entrada se consume a medida que se simula: no se puede volver a correr ni saltar
+  if (tune.active || whatIf.active || checkpoints.interval > 0 || checkpoints.seekCycle > 0)
+  {
+    fprintf(stderr, "Stream: el modo en línea no admite tune, what-if, snapshots ni seek.\n");
+    return -1;
+  }
+  if (tracePath[0])
+    fprintf(stderr, "Stream: la traza no está disponible en el modo en línea; se ignora.\n");
+
+  printf("=== Procesos en Línea (hasta %d vivos) ===\n", STREAM_MAX_LIVE);
+  printf("\n=== Ejecutando Algoritmo: %s ===\n", getAlgorithmName(control.config.algorithm));
+
+  configureTelemetry(telemetryWindow, slots, STREAM_MAX_LIVE, NULL, 0);
+  int status = simulateStream(in, slots, timelineEvents, &eventCount, &control);
+  finishTelemetry();
+  if (status != 0)
+  {
+    printf("Algoritmo no soportado.\n");
+    return -1;
+  }
+
+  flushCycleFrame();
+  StreamStats stats = getStreamStats();
+  char line[384];
+  int n = snprintf(line, sizeof(line),
+                   "{\"type\": \"metrics\", \"Average Waiting Time\": %.2f, \"Average Turnaround Time\": %.2f, "
+                   "\"Completed\": %d, \"Max Live Processes\": %d, \"Delayed Admissions\": %d, "
+                   "\"Rejected Lines\": %d, \"CPU Utilization\": %.4f",
+                   stats.completed > 0 ? (double)stats.waitingTime / stats.completed : 0.0,
+                   stats.completed > 0 ? (double)stats.turnaroundTime / stats.completed : 0.0,
+                   stats.completed, stats.maxLive, stats.delayed, stats.rejected,
+                   stats.cycles > 0 ? (double)stats.cpuBusyCycles / stats.cycles : 0.0);
+  if (switchCostEnabled(&control.config))
+  {
+    SwitchStats switchStats = getSwitchStats();
+    int busy = switchStats.overheadCycles + switchStats.executedCycles;
+    n += snprintf(line + n, sizeof(line) - n,
+                  ", \"Context Switches\": %d, \"Switch Overhead Cycles\": %d, \"Switch Overhead\": %.4f",
+                  switchStats.switches, switchStats.overheadCycles,
+                  busy > 0 ? (double)switchStats.overheadCycles / busy : 0.0);
+  }
+  snprintf(line + n, sizeof(line) - n, "}");
+  printSummaryLine(line);
+
+  exportSimulationEnd();
+  return 0;
+}
+
+// ======================== SINCRONIZACIÓN ========================
+
+// Traduce string a enum
+static PriorityProtocol parseProtocol(const char *str)
+{
+  if (strcmp(str, "inheritance") == 0)
+    return PROTOCOL_INHERITANCE;
+  if (strcmp(str, "ceiling") == 0)
+    return PROTOCOL_CEILING;
+  return PROTOCOL_NONE;
+}
+
+// Traduce el modelo de lock pedido a la máscara de LockType (0 si no se pide comparación)
+static int parseLockModels(const char *str)
+{
+  if (strcmp(str, "all") == 0)
+    return LOCK_ALL;
+  if (strcmp(str, "blocking") == 0)
+    return LOCK_BLOCKING;
+  if (strcmp(str, "tas") == 0)
+    return LOCK_TAS;
+  if (strcmp(str, "ticket") == 0)
+    return LOCK_TICKET;
+  if (strcmp(str, "mcs") == 0)
+    return LOCK_MCS;
+  return 0;
+}
+
+static void printLoadedDataJSON(Process *processes, int processCount,
+                                Resource *resources, int resourceCount,
+                                Action *actions, int actionCount,
+                                SyncConfig *config, SimulationControl *control)
+{
+  // Imprimir configuración del mecanismo (y del algoritmo de CPU si la simulación es combinada)
+  printf("{\"event\":\"CONFIG\",\"mechanism\":\"%s\",\"priorityQueue\":%d,\"protocol\":\"%s\","
+         "\"algorithm\":\"%s\",\"quantum\":%d,\"isPreemptive\":%d}\n",
+         config->useMutex ? "mutex" : "semaphore", config->priorityQueue, getProtocolName(config->protocol),
+         getAlgorithmName(control->config.algorithm), control->config.quantum, control->config.isPreemptive);
+
+  // Procesos cargados
+  for (int i = 0; i < processCount; i++)
+  {
+    printf(
+        "{\"event\":\"PROCESS_LOADED\",\"pid\":\"%s\",\"burstTime\":%d,\"arrivalTime\":%d,\"priority\":%d}\n",
+        processes[i].pid, processes[i].burstTime, processes[i].arrivalTime, processes[i].priority);
+  }
+
+  // Recursos cargados
+  for (int i = 0; i < resourceCount; i++)
+  {
+    printf("{\"event\":\"RESOURCE_LOADED\",\"name\":\"%s\",\"counter\":%d}\n",
+           resources[i].name, resources[i].counter);
+  }
+
+  // Acciones cargadas
+  for (int i = 0; i < actionCount; i++)
+  {
+    printf(
+        "{\"event\":\"ACTION_LOADED\",\"pid\":\"%s\",\"action\":\"%s\",\"resource\":\"%s\",\"cycle\":%d}\n",
+        actions[i].pid, getActionTypeName(actions[i].action), actions[i].resourceName, actions[i].cycle);
+  }
+}
+
+static void printDataHumanReadable(Process *processes, int processCount,
+                                   Resource *resources, int resourceCount,
+                                   Action *actions, int actionCount)
+{
+  printf("\n=== PROCESOS (%d) ===\n", processCount);
+  for (int i = 0; i < processCount; i++)
+  {
+    printf("PID: %s, BT: %d, AT: %d, Priority: %d, State: %s\n",
+           processes[i].pid, processes[i].burstTime, processes[i].arrivalTime,
+           processes[i].priority, getProcessStateName(processes[i].state));
+  }
+
+  printf("\n=== RECURSOS (%d) ===\n", resourceCount);
+  for (int i = 0; i < resourceCount; i++)
+  {
+    printf("Nombre: %s, Disponible: %d, Bloqueado: %s\n",
+           resources[i].name, resources[i].counter,
+           resources[i].isLocked ? "Sí" : "No");
+  }
+
+  printf("\n=== ACCIONES (%d) ===\n", actionCount);
+  for (int i = 0; i < actionCount; i++)
+  {
+    printf("PID: %s, Acción: %s, Recurso: %s, Ciclo: %d\n",
+           actions[i].pid, getActionTypeName(actions[i].action),
+           actions[i].resourceName, actions[i].cycle);
+  }
+}
+
+/**
+ * Contexto de una simulación de sincronización: cada ejecución parte de una copia nueva de los
+ * recursos y acciones de la carga (la simulación los modifica).
+ */
+typedef struct
+{
+  const Workload *workload;
+  Resource *resources;
+  Action *actions;
+  SyncConfig *config;
+  SimulationControl *control;
+} SyncRun;
+
+void runSynchronizationEngine(Process *processes, int processCount,
+                              Resource *resources, int resourceCount,
+                              Action *actions, int actionCount,
+                              SyncConfig *config, SimulationControl *control)
+{
+  static TimelineEvent events[MAX_EVENTS];
+  int eventCount = 0;
+
+  if (control->config.algorithm != ALGO_NONE)
+  {
+    simulateCombined(processes, processCount,
+                     resources, resourceCount,
+                     actions, actionCount,
+                     events, &eventCount,
+                     control, config);
+  }
+  else
+  {
+    simulateSynchronization(processes, processCount,
+                            resources, resourceCount,
+                            actions, actionCount,
+                            events, &eventCount,
+                            config);
+  }
+}
+
+// Ejecuta la sincronización sobre una copia nueva de los recursos y acciones de la carga
+static int runSyncAlgorithm(Process *processes, int processCount, void *context)
+{
+  SyncRun *run = context;
+  int resourceCount = run->workload->resourceCount;
+  int actionCount = run->workload->actionCount;
+
+  memcpy(run->resources, run->workload->resources, sizeof(Resource) * resourceCount);
+  memcpy(run->actions, run->workload->actions, sizeof(Action) * actionCount);
+
+  runSynchronizationEngine(processes, processCount, run->resources, resourceCount,
+                           run->actions, actionCount, run->config, run->control);
+  return 0;
+}
+
+int runSynchronizationSession(const char *configLine, const Workload *workload)
+{
+  static Process processes[MAX_PROCESSES];
+  static Resource resources[MAX_PROCESSES];
+  static Action actions[MAX_EVENTS];
+  static WhatIfQuery whatIf;
+
+  // Configuración de la sesión
+  SyncConfig config = {1, 0, PROTOCOL_NONE, 0, 1000, 2000, 0, {4, 100, 5.0, 1.0, 2.0, 50.0, 1000.0}, 1};
+  SimulationControl control = {{ALGO_NONE, 1, 0}};
+  CheckpointSettings checkpoints = {0, 0, ""};
+  char tracePath[256] = "";
+  int telemetryWindow = 0;
+  whatIf.active = 0;
+  if (configLine && configLine[0] != '\0')
+  {
+    cJSON *json = cJSON_Parse(configLine);
+    if (!json)
+    {
+      fprintf(stderr, "Error al parsear JSON de configuración.\n");
+      return -1;
+    }
+
+    const cJSON *mutexField = cJSON_GetObjectItemCaseSensitive(json, "useMutex");
+    if (cJSON_IsNumber(mutexField))
+    {
+      config.useMutex = mutexField->valueint;
+    }
+
+    const cJSON *queueField = cJSON_GetObjectItemCaseSensitive(json, "priorityQueue");
+    if (cJSON_IsNumber(queueField))
+    {
+      config.priorityQueue = queueField->valueint;
+    }
+
+    const cJSON *protocolField = cJSON_GetObjectItemCaseSensitive(json, "protocol");
+    if (cJSON_IsString(protocolField) && protocolField->valuestring)
+    {
+      config.protocol = parseProtocol(protocolField->valuestring);
+    }
+
+    // Reproducción opcional con hilos reales
+    const cJSON *threadsField = cJSON_GetObjectItemCaseSensitive(json, "realThreads");
+    const cJSON *cycleField = cJSON_GetObjectItemCaseSensitive(json, "cycleUs");
+    const cJSON *timeoutField = cJSON_GetObjectItemCaseSensitive(json, "timeoutMs");
+
+    if (cJSON_IsNumber(threadsField))
+      config.realThreads = threadsField->valueint;
+
+    if (cJSON_IsNumber(cycleField) && cycleField->valueint > 0)
+      config.cycleUs = cycleField->valueint;
+
+    if (cJSON_IsNumber(timeoutField) && timeoutField->valueint > 0)
+      config.timeoutMs = timeoutField->valueint;
+
+    // Concesión de accesos repartida por recurso entre varios hilos
+    const cJSON *shardsField = cJSON_GetObjectItemCaseSensitive(json, "shards");
+    if (cJSON_IsNumber(shardsField) && shardsField->valueint > 0)
+      config.shards = shardsField->valueint;
+
+    // Comparación opcional de modelos de lock (spinlock, ticket, MCS) y su modelo de costos
+    const cJSON *lockField = cJSON_GetObjectItemCaseSensitive(json, "lockModel");
+    if (cJSON_IsString(lockField) && lockField->valuestring)
+      config.lockModels = parseLockModels(lockField->valuestring);
+
+    const cJSON *coresField = cJSON_GetObjectItemCaseSensitive(json, "cores");
+    const cJSON *ticksField = cJSON_GetObjectItemCaseSensitive(json, "ticksPerCycle");
+    const cJSON *transferField = cJSON_GetObjectItemCaseSensitive(json, "cacheLineTransfer");
+    const cJSON *spinField = cJSON_GetObjectItemCaseSensitive(json, "spinCost");
+    const cJSON *handoffField = cJSON_GetObjectItemCaseSensitive(json, "handoffLatency");
+    const cJSON *wakeupField = cJSON_GetObjectItemCaseSensitive(json, "wakeupLatency");
+    const cJSON *penaltyField = cJSON_GetObjectItemCaseSensitive(json, "preemptionPenalty");
+
+    if (cJSON_IsNumber(coresField) && coresField->valueint > 0)
+      config.costModel.cores = coresField->valueint;
+
+    if (cJSON_IsNumber(ticksField) && ticksField->valueint > 0)
+      config.costModel.ticksPerCycle = ticksField->valueint;
+
+    if (cJSON_IsNumber(transferField) && transferField->valuedouble >= 0)
+      config.costModel.cacheLineTransfer = transferField->valuedouble;
+
+    if (cJSON_IsNumber(spinField) && spinField->valuedouble > 0)
+      config.costModel.spinCost = spinField->valuedouble;
+
+    if (cJSON_IsNumber(handoffField) && handoffField->valuedouble >= 0)
+      config.costModel.handoffLatency = handoffField->valuedouble;
+
+    if (cJSON_IsNumber(wakeupField) && wakeupField->valuedouble >= 0)
+      config.costModel.wakeupLatency = wakeupField->valuedouble;
+
+    if (cJSON_IsNumber(penaltyField) && penaltyField->valuedouble >= 0)
+      config.costModel.preemptionPenalty = penaltyField->valuedouble;
+
+    // Con un algoritmo de CPU se ejecuta la simulación combinada
+    const cJSON *alg = cJSON_GetObjectItemCaseSensitive(json, "algorithm");
+    const cJSON *quant = cJSON_GetObjectItemCaseSensitive(json, "quantum");
+    const cJSON *preempt = cJSON_GetObjectItemCaseSensitive(json, "isPreemptive");
+
+    if (cJSON_IsString(alg) && alg->valuestring)
+      control.config.algorithm = parseAlgorithm(alg->valuestring);
+
+    if (cJSON_IsNumber(quant) && quant->valueint > 0)
+      control.config.quantum = quant->valueint;
+    parsePriorityQuantum(json, &control.config);
+
+    if (cJSON_IsNumber(preempt))
+      control.config.isPreemptive = preempt->valueint;
+
+    // Un frame por ciclo con todos sus eventos
+    const cJSON *framesField = cJSON_GetObjectItemCaseSensitive(json, "frames");
+    setFrameBatching(cJSON_IsNumber(framesField) ? framesField->valueint : cJSON_IsTrue(framesField));
+
+    parseCheckpointSettings(json, &checkpoints);
+    parseWhatIf(json, &whatIf);
+    parseTracePath(json, tracePath, sizeof(tracePath));
+    telemetryWindow = jsonInt(json, "telemetryWindow", 0);
+    cJSON_Delete(json);
+  }
+
+  // La simulación combinada elige por prioridad, ráfaga o llegada; no reparte por boletos
+  if (isShareAlgorithm(control.config.algorithm))
+  {
+    fprintf(stderr, "%s: no se admite en la simulación combinada.\n", getAlgorithmName(control.config.algorithm));
+    return -1;
+  }
+
+  // Los protocolos de prioridad y la simulación combinada requieren colas de espera
+  if (config.protocol != PROTOCOL_NONE || control.config.algorithm != ALGO_NONE)
+  {
+    config.priorityQueue = 1;
+  }
+
+  // Copiar la carga de trabajo (la simulación modifica procesos y recursos)
+  int processCount = workload->processCount;
+  int resourceCount = workload->resourceCount;
+  int actionCount = workload->actionCount;
+  memcpy(processes, workload->processes, sizeof(Process) * processCount);
+  memcpy(resources, workload->resources, sizeof(Resource) * resourceCount);
+  memcpy(actions, workload->actions, sizeof(Action) * actionCount);
+
+  // Exportar JSON de elementos cargados
+  printLoadedDataJSON(processes, processCount, resources, resourceCount, actions, actionCount, &config, &control);
+  printDataHumanReadable(processes, processCount, resources, resourceCount, actions, actionCount);
+  printf("\n=== Ejecutando sincronización con: %s (protocolo: %s) ===\n",
+         config.useMutex ? "mutex" : "semaphore", getProtocolName(config.protocol));
+
+  int params[] = {config.useMutex, config.priorityQueue, config.protocol,
+                  control.config.algorithm, control.config.quantum, control.config.isPreemptive};
+  unsigned long long key = runKey("synchronization", params, 6, processes, processCount,
+                                  resources, resourceCount, actions, actionCount);
+  key = schedulingOptionsKey(key, &control.config);
+
+  if (control.config.algorithm != ALGO_NONE)
+    printf("=== Planificación de CPU: %s ===\n", getAlgorithmName(control.config.algorithm));
+
+  // Ejecutar simulación
+  SyncRun run = {workload, resources, actions, &config, &control};
+  if (whatIf.active)
+  {
+    // La consulta what-if solo informa la diferencia de métricas
+    int status = runWhatIf(&whatIf, &checkpoints, key, 1, processes, processCount, runSyncAlgorithm, &run);
+    if (status == 0)
+      exportSimulationEnd();
+    return status;
+  }
+
+  configureCheckpoints(checkpoints.interval, checkpoints.seekCycle, checkpoints.directory, key);
+  if (tracePath[0])
+  {
+    char title[64];
+    snprintf(title, sizeof(title), "%s (%s)", config.useMutex ? "mutex" : "semaphore", getProtocolName(config.protocol));
+    openTrace(tracePath, title, processes, processCount);
+  }
+  configureTelemetry(telemetryWindow, processes, processCount, resources, resourceCount);
+
+  runSyncAlgorithm(processes, processCount, &run);
+  finishTelemetry();
+  closeTrace();
+
+  // Reproducir el mismo escenario con hilos reales y reportarlo junto al resultado simulado
+  if (config.realThreads && processCount > 0)
+  {
+    if (runThreadedSynchronization(workload->processes, processCount,
+                                   workload->resources, resourceCount,
+                                   actions, actionCount,
+                                   &config, processes) != 0)
+      fprintf(stderr, "Error al ejecutar la reproducción con hilos reales.\n");
+  }
+
+  // Comparar los modelos de lock sobre la misma traza
+  if (config.lockModels)
+  {
+    simulateLockModels(workload->processes, processCount,
+                       workload->resources, resourceCount,
+                       actions, actionCount,
+                       config.lockModels, &config.costModel);
+  }
+
+  exportSimulationEnd();
+
+  return 0;
+}
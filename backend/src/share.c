@@ -0,0 +1,142 @@
+#include "share.h"
+#include <stdio.h>
+#include <string.h>
+
+static struct
+{
+  int window;
+  int processCount;
+  int tickets[MAX_PROCESSES];
+
+  // Acumulados que cambian durante la simulación (región de los snapshots)
+  struct
+  {
+    int windowStart;
+    int windowCycles;                     // Ciclos repartidos en la ventana en curso
+    double entitled[MAX_PROCESSES];       // Ciclos que le correspondían a cada proceso
+    int received[MAX_PROCESSES];          // Ciclos que ejecutó cada proceso
+    double windowEntitled[MAX_PROCESSES];
+    int windowReceived[MAX_PROCESSES];
+  } state;
+} report;
+
+int getProcessTickets(const SimulationConfig *config, const Process *process)
+{
+  for (int i = 0; i < config->share.ticketCount; i++)
+  {
+    if (strcmp(config->share.ticketPid[i], process->pid) == 0)
+      return config->share.tickets[i];
+  }
+  int priority = process->priority > 0 ? process->priority : 0;
+  int tickets = SHARE_BASE_TICKETS / (priority + 1);
+  return tickets > 0 ? tickets : 1;
+}
+
+void beginShareReport(const SimulationConfig *config, const Process *processes, int processCount)
+{
+  memset(&report, 0, sizeof(report));
+  report.window = config->share.window > 0 ? config->share.window : 0;
+  report.processCount = processCount;
+  for (int i = 0; i < processCount; i++)
+    report.tickets[i] = getProcessTickets(config, &processes[i]);
+}
+
+CheckpointRegion shareReportRegion(void)
+{
+  CheckpointRegion region = {&report.state, sizeof(report.state)};
+  return region;
+}
+
+// Emite la ventana [start, end) con la parte de cada proceso activo y reinicia sus acumulados
+static void emitShareWindow(const Process *processes, int start, int end)
+{
+  static char line[256 + MAX_PROCESSES * 96];
+  if (report.state.windowCycles > 0)
+  {
+    double length = report.state.windowCycles;
+    int n = snprintf(line, sizeof(line), "{\"event\": \"SHARE\", \"startCycle\": %d, \"endCycle\": %d, \"processes\": [",
+                     start, end);
+    int listed = 0;
+    for (int i = 0; i < report.processCount; i++)
+    {
+      if (report.state.windowEntitled[i] <= 0 && report.state.windowReceived[i] == 0)
+        continue;
+      n += snprintf(line + n, sizeof(line) - n,
+                    "%s{\"pid\": \"%s\", \"tickets\": %d, \"entitled\": %.4f, \"achieved\": %.4f}",
+                    listed++ ? ", " : "", processes[i].pid, report.tickets[i],
+                    report.state.windowEntitled[i] / length, report.state.windowReceived[i] / length);
+    }
+    snprintf(line + n, sizeof(line) - n, "]}");
+    emitEventLine(line, -1);
+  }
+
+  report.state.windowCycles = 0;
+  memset(report.state.windowEntitled, 0, sizeof(report.state.windowEntitled));
+  memset(report.state.windowReceived, 0, sizeof(report.state.windowReceived));
+}
+
+void recordShareCycle(const Process *processes, int processCount, int running, int cycle)
+{
+  if (report.window > 0)
+  {
+    // Las ventanas se alinean a múltiplos de `window`
+    if (report.state.windowCycles == 0 && cycle >= report.state.windowStart + report.window)
+      report.state.windowStart = cycle - cycle % report.window;
+    while (cycle >= report.state.windowStart + report.window)
+    {
+      emitShareWindow(processes, report.state.windowStart, report.state.windowStart + report.window);
+      report.state.windowStart += report.window;
+    }
+  }
+  if (running < 0)
+    return;
+
+  long total = 0;
+  for (int i = 0; i < processCount; i++)
+  {
+    if (i == running || processes[i].state == STATE_WAITING)
+      total += report.tickets[i];
+  }
+  for (int i = 0; i < processCount; i++)
+  {
+    if (i != running && processes[i].state != STATE_WAITING)
+      continue;
+    double part = (double)report.tickets[i] / total;
+    report.state.entitled[i] += part;
+    report.state.windowEntitled[i] += part;
+  }
+  report.state.received[running]++;
+  report.state.windowReceived[running]++;
+  report.state.windowCycles++;
+}
+
+void finishShareReport(const Process *processes, int processCount, int cycle)
+{
+  if (report.window > 0 && cycle > report.state.windowStart)
+    emitShareWindow(processes, report.state.windowStart, cycle);
+
+  char line[256];
+  for (int i = 0; i < processCount; i++)
+  {
+    double entitled = report.state.entitled[i];
+    snprintf(line, sizeof(line),
+             "{\"event\": \"SHARE_METRIC\", \"pid\": \"%s\", \"tickets\": %d, \"entitledCycles\": %.2f, "
+             "\"cpuCycles\": %d, \"shareRatio\": %.4f}",
+             processes[i].pid, report.tickets[i], entitled, report.state.received[i],
+             entitled > 0 ? report.state.received[i] / entitled : 0.0);
+    emitEventLine(line, -1);
+  }
+}
+
+double getShareError(void)
+{
+  double deviation = 0;
+  long delivered = 0;
+  for (int i = 0; i < report.processCount; i++)
+  {
+    double difference = report.state.received[i] - report.state.entitled[i];
+    deviation += difference < 0 ? -difference : difference;
+    delivered += report.state.received[i];
+  }
+  return delivered > 0 ? deviation / 2 / delivered : 0.0;
+}
@@ -1,7 +1,10 @@
 #include "simulator.h"
+#include "trace.h"
+#include "telemetry.h"
 #include <string.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <unistd.h>
 
 /**
  * Devuelve el nombre en cadena del estado de un proceso dado su enum.
@@ -23,6 +26,12 @@ const char *getProcessStateName(ProcessState state)
     return "TERMINATED";
   case STATE_OMITED:
     return "OMITED";
+  case STATE_SWITCHING:
+    return "SWITCHING";
+  case STATE_IO:
+    return "IO";
+  case STATE_IO_WAITING:
+    return "IO_WAITING";
   default:
     return "UNKNOWN";
   }
@@ -69,6 +78,10 @@ const char *getAlgorithmName(SchedulingAlgorithm algorithm)
     return "SJF";
   case ALGO_SRT:
     return "SRT";
+  case ALGO_LOTTERY:
+    return "LOTTERY";
+  case ALGO_STRIDE:
+    return "STRIDE";
   case ALGO_NONE:
     return "NONE";
   default:
@@ -76,6 +89,166 @@ const char *getAlgorithmName(SchedulingAlgorithm algorithm)
   }
 }
 
+/**
+ * Traduce el nombre corto de un algoritmo (FIFO, SJF, RR, PS, SRT, LOTTERY, STRIDE) a su enum.
+ *
+ * @param str Nombre del algoritmo recibido en la configuración.
+ * @return Algoritmo correspondiente, o ALGO_NONE si no se reconoce.
+ */
+SchedulingAlgorithm parseAlgorithm(const char *str)
+{
+  if (strcmp(str, "FIFO") == 0)
+    return ALGO_FIFO;
+  if (strcmp(str, "SJF") == 0)
+    return ALGO_SJF;
+  if (strcmp(str, "RR") == 0)
+    return ALGO_RR;
+  if (strcmp(str, "PS") == 0)
+    return ALGO_PRIORITY;
+  if (strcmp(str, "SRT") == 0)
+    return ALGO_SRT;
+  if (strcmp(str, "LOTTERY") == 0)
+    return ALGO_LOTTERY;
+  if (strcmp(str, "STRIDE") == 0)
+    return ALGO_STRIDE;
+  return ALGO_NONE;
+}
+
+/**
+ * Devuelve el quantum de Round Robin que corresponde a una prioridad.
+ *
+ * @param config   Configuración de la simulación.
+ * @param priority Prioridad del proceso.
+ * @return El quantum configurado para la prioridad, o el quantum general si no tiene uno propio.
+ */
+int getQuantumForPriority(const SimulationConfig *config, int priority)
+{
+  if (priority >= 0 && priority < MAX_PRIORITY_LEVELS && config->priorityQuantum[priority] > 0)
+    return config->priorityQuantum[priority];
+  return config->quantum;
+}
+
+/**
+ * Devuelve el nombre en cadena del protocolo de prioridad dado su enum.
+ *
+ * @param protocol Protocolo de prioridad (PriorityProtocol).
+ * @return Cadena con el nombre del protocolo, o "UNKNOWN" si no es válido.
+ */
+const char *getProtocolName(PriorityProtocol protocol)
+{
+  switch (protocol)
+  {
+  case PROTOCOL_NONE:
+    return "none";
+  case PROTOCOL_INHERITANCE:
+    return "inheritance";
+  case PROTOCOL_CEILING:
+    return "ceiling";
+  default:
+    return "UNKNOWN";
+  }
+}
+
+/**
+ * Devuelve el nombre en cadena de un modelo de lock dado su enum.
+ *
+ * @param lock Modelo de lock (LockType).
+ * @return Cadena con el nombre del lock, o "UNKNOWN" si no es válido.
+ */
+const char *getLockTypeName(LockType lock)
+{
+  switch (lock)
+  {
+  case LOCK_BLOCKING:
+    return "blocking";
+  case LOCK_TAS:
+    return "tas";
+  case LOCK_TICKET:
+    return "ticket";
+  case LOCK_MCS:
+    return "mcs";
+  default:
+    return "UNKNOWN";
+  }
+}
+
+/**
+ * Parsea una línea de proceso con el formato: PID, BT, AT, PRIORITY
+ * @return 1 si la línea es válida, 0 en caso contrario.
+ */
+int parseProcessLine(const char *line, Process *process)
+{
+  if (sscanf(line, " %9[^,], %d, %d, %d",
+             process->pid,
+             &process->burstTime,
+             &process->arrivalTime,
+             &process->priority) != 4)
+    return 0;
+
+  process->state = STATE_NEW;
+  process->startTime = -1;
+  process->finishTime = -1;
+  process->waitingTime = 0;
+  return 1;
+}
+
+/**
+ * Parsea una línea de recurso con el formato: NOMBRE, CONTADOR
+ * @return 1 si la línea es válida, 0 en caso contrario.
+ */
+int parseResourceLine(const char *line, Resource *resource)
+{
+  if (sscanf(line, " %9[^,], %d", resource->name, &resource->counter) != 2)
+    return 0;
+
+  resource->isLocked = 0;
+  return 1;
+}
+
+/**
+ * Parsea una línea de acción con el formato: PID, ACTION, RESOURCE, CYCLE
+ * Donde ACTION puede ser "READ" o "WRITE".
+ * @return 1 si la línea es válida, 0 en caso contrario.
+ */
+int parseActionLine(const char *line, Action *action)
+{
+  char actionStr[10];
+  if (sscanf(line, " %9[^,], %9[^,], %9[^,], %d",
+             action->pid,
+             actionStr,
+             action->resourceName,
+             &action->cycle) != 4)
+    return 0;
+
+  action->action = parseActionType(actionStr);
+  return 1;
+}
+
+// Traduce "READ"/"WRITE" a enum (ACTION_NONE si no es válido)
+ActionType parseActionType(const char *str)
+{
+  if (strcmp(str, "READ") == 0)
+    return ACTION_READ;
+  if (strcmp(str, "WRITE") == 0)
+    return ACTION_WRITE;
+  return ACTION_NONE;
+}
+
+/**
+ * Parsea una línea de dispositivo con el formato: NOMBRE, POLÍTICA
+ * Donde POLÍTICA puede ser "FCFS" (por defecto) o "PRIORITY".
+ * @return 1 si la línea es válida, 0 en caso contrario.
+ */
+int parseDeviceLine(const char *line, Device *device)
+{
+  char policy[16] = "FCFS";
+  if (sscanf(line, " %9[^, \t\r] , %15s", device->name, policy) < 1)
+    return 0;
+
+  device->policy = strcmp(policy, "PRIORITY") == 0 ? DEVICE_PRIORITY : DEVICE_FCFS;
+  return 1;
+}
+
 /*
  * Carga los procesos desde un archivo de texto.
  * @param filename: Nombre del archivo que contiene los procesos.
@@ -89,24 +262,14 @@ int loadProcesses(const char *filename, Process *processes, int maxProcesses)
   if (!file)
     return -1;
 
-  char line[128];
+  char line[512]; // Con secuencia de ráfagas la línea puede ser larga
   int count = 0;
 
   while (count < maxProcesses && fgets(line, sizeof(line), file))
   {
     line[strcspn(line, "\n")] = '\0';
-    if (sscanf(line, " %[^,], %d, %d, %d",
-               processes[count].pid,
-               &processes[count].burstTime,
-               &processes[count].arrivalTime,
-               &processes[count].priority) == 4)
-    {
-      processes[count].state = STATE_NEW;
-      processes[count].startTime = -1;
-      processes[count].finishTime = -1;
-      processes[count].waitingTime = 0;
+    if (parseProcessLine(line, &processes[count]))
       count++;
-    }
   }
 
   fclose(file);
@@ -132,13 +295,32 @@ int loadResources(const char *filename, Resource *resources, int maxResources)
   while (count < maxResources && fgets(line, sizeof(line), file))
   {
     line[strcspn(line, "\n")] = '\0';
-    if (sscanf(line, " %[^,], %d",
-               resources[count].name,
-               &resources[count].counter) == 2)
-    {
-      resources[count].isLocked = 0;
+    if (parseResourceLine(line, &resources[count]))
+      count++;
+  }
+
+  fclose(file);
+  return count;
+}
+
+/**
+ * Carga los dispositivos de I/O desde un archivo de texto (formato: NOMBRE, POLÍTICA).
+ * @return Número de dispositivos cargados o -1 si el archivo no existe.
+ */
+int loadDevices(const char *filename, Device *devices, int maxDevices)
+{
+  FILE *file = fopen(filename, "r");
+  if (!file)
+    return -1;
+
+  char line[128];
+  int count = 0;
+
+  while (count < maxDevices && fgets(line, sizeof(line), file))
+  {
+    line[strcspn(line, "\n")] = '\0';
+    if (parseDeviceLine(line, &devices[count]))
       count++;
-    }
   }
 
   fclose(file);
@@ -162,28 +344,13 @@ int loadActions(const char *filename, Action *actions, int maxActions)
     return -1;
 
   char line[128];
-  char actionStr[10];
   int count = 0;
 
   while (count < maxActions && fgets(line, sizeof(line), file))
   {
     line[strcspn(line, "\n")] = '\0';
-    if (sscanf(line, " %[^,], %[^,], %[^,], %d",
-               actions[count].pid,
-               actionStr,
-               actions[count].resourceName,
-               &actions[count].cycle) == 4)
-    {
-      if (strcmp(actionStr, "READ") == 0)
-      {
-        actions[count].action = ACTION_READ;
-      }
-      else if (strcmp(actionStr, "WRITE") == 0)
-      {
-        actions[count].action = ACTION_WRITE;
-      }
+    if (parseActionLine(line, &actions[count]))
       count++;
-    }
   }
 
   fclose(file);
@@ -259,6 +426,169 @@ void exportMetrics(const char *filename, SimulationMetrics metrics)
   fclose(file);
 }
 
+/**
+ * Salida agrupada por ciclo (frames).
+ *
+ * Con el agrupamiento activo, los eventos de un ciclo se acumulan y se emiten en una sola línea
+ * {"type": "CYCLE", "cycle": N, "events": [...]} al cerrar el ciclo, en el mismo orden en que se
+ * habrían impreso por separado. Sin agrupamiento cada evento se imprime en su propia línea.
+ */
+static int frameBatching = 0;
+static char *frameBuffer = NULL;
+static size_t frameLength = 0;
+static size_t frameCapacity = 0;
+static int frameEvents = 0;
+static int frameCycle = 0;
+static int outputMuted = 0;
+
+// Destino de la salida en modo biblioteca (NULL: stdout con retardo por ciclo)
+static OutputSink outputSink = NULL;
+static CycleSink cycleSink = NULL;
+static void *sinkContext = NULL;
+
+void setFrameBatching(int enabled)
+{
+  frameBatching = enabled;
+}
+
+void setOutputMuted(int muted)
+{
+  outputMuted = muted;
+}
+
+int isOutputMuted(void)
+{
+  return outputMuted;
+}
+
+void setOutputSink(OutputSink sink, CycleSink cycleEnd, void *context)
+{
+  outputSink = sink;
+  cycleSink = cycleEnd;
+  sinkContext = context;
+}
+
+// Escribe una línea completa de salida en stdout o en el destino configurado
+static void writeOutputLine(const char *line, size_t length)
+{
+  if (outputSink)
+  {
+    outputSink(line, length, sinkContext);
+    return;
+  }
+
+  printf("%s\n", line);
+  fflush(stdout);
+}
+
+// Amplía el buffer del frame para `size` bytes (0 si no hay memoria)
+static int reserveFrame(size_t size)
+{
+  if (size <= frameCapacity)
+    return 1;
+
+  size_t capacity = frameCapacity ? frameCapacity : 4096;
+  while (size > capacity)
+    capacity *= 2;
+
+  char *grown = realloc(frameBuffer, capacity);
+  if (!grown)
+    return 0;
+  frameBuffer = grown;
+  frameCapacity = capacity;
+  return 1;
+}
+
+// Agrega texto al frame en construcción, ampliando el buffer si hace falta
+static void appendToFrame(const char *text, size_t length)
+{
+  if (!reserveFrame(frameLength + length + 1))
+    return;
+  memcpy(frameBuffer + frameLength, text, length);
+  frameLength += length;
+  frameBuffer[frameLength] = '\0';
+}
+
+/**
+ * Emite una línea JSON de evento (sin salto de línea): la imprime o la agrega al frame del ciclo.
+ *
+ * @param json  Objeto JSON del evento.
+ * @param cycle Ciclo del evento, o -1 si no corresponde a un ciclo (métricas).
+ */
+void emitEventLine(const char *json, int cycle)
+{
+  if (outputMuted)
+    return;
+
+  if (!frameBatching)
+  {
+    writeOutputLine(json, strlen(json));
+    return;
+  }
+
+  // El frame toma el ciclo del último evento de la línea de tiempo (el ciclo que cierra)
+  if (cycle >= 0)
+    frameCycle = cycle;
+  if (frameEvents > 0)
+    appendToFrame(", ", 2);
+  appendToFrame(json, strlen(json));
+  frameEvents++;
+}
+
+// Emite el frame del ciclo en curso si tiene eventos
+void flushCycleFrame(void)
+{
+  if (!frameBatching || frameEvents == 0)
+    return;
+
+  if (!outputSink)
+  {
+    printf("{\"type\": \"CYCLE\", \"cycle\": %d, \"events\": [%s]}\n", frameCycle, frameBuffer ? frameBuffer : "");
+    fflush(stdout);
+  }
+  else
+  {
+    // El destino recibe la línea completa: se arma en el mismo buffer, alrededor de los eventos
+    char header[64];
+    size_t headerLength = snprintf(header, sizeof(header), "{\"type\": \"CYCLE\", \"cycle\": %d, \"events\": [", frameCycle);
+    size_t lineLength = headerLength + frameLength + 2;
+    if (reserveFrame(lineLength + 1))
+    {
+      memmove(frameBuffer + headerLength, frameBuffer, frameLength);
+      memcpy(frameBuffer, header, headerLength);
+      memcpy(frameBuffer + headerLength + frameLength, "]}", 3);
+      outputSink(frameBuffer, lineLength, sinkContext);
+    }
+  }
+  frameLength = 0;
+  frameEvents = 0;
+}
+
+void printSummaryLine(const char *json)
+{
+  if (outputMuted)
+    return;
+
+  writeOutputLine(json, strlen(json));
+}
+
+// Cierra el ciclo simulado: emite su frame y espera el retardo de la simulación en tiempo real
+// (en modo biblioteca avisa el fin del ciclo en lugar de esperar)
+void endSimulationCycle(void)
+{
+  if (outputMuted)
+    return;
+
+  flushCycleFrame();
+  if (outputSink)
+  {
+    if (cycleSink)
+      cycleSink(sinkContext);
+    return;
+  }
+  usleep(SIMULATION_DELAY_US);
+}
+
 /**
  * Imprime en formato JSON las métricas de un proceso específico en la salida estándar.
  *
@@ -278,12 +608,15 @@ void exportMetrics(const char *filename, SimulationMetrics metrics)
  */
 void exportProcessMetric(const Process *p)
 {
-  printf(
-      "{\"event\": \"PROCESS_METRIC\", \"pid\": \"%s\", \"arrivalTime\": %d, \"burstTime\": %d, \"priority\": %d, "
-      "\"startTime\": %d, \"endTime\": %d, \"waitingTime\": %d}\n",
-      p->pid, p->arrivalTime, p->burstTime, p->priority,
-      p->startTime, p->finishTime, p->waitingTime);
-  fflush(stdout);
+  char line[256];
+  snprintf(line, sizeof(line),
+           "{\"event\": \"PROCESS_METRIC\", \"pid\": \"%s\", \"arrivalTime\": %d, \"burstTime\": %d, \"priority\": %d, "
+           "\"startTime\": %d, \"endTime\": %d, \"waitingTime\": %d}",
+           p->pid, p->arrivalTime, p->burstTime, p->priority,
+           p->startTime, p->finishTime, p->waitingTime);
+  emitEventLine(line, -1);
+  if (!outputMuted)
+    traceProcessMetric(p);
 }
 
 void exportProcessMetricWithOriginalBT(const Process *p, int originalBT)
@@ -291,13 +624,16 @@ void exportProcessMetricWithOriginalBT(const Process *p, int originalBT)
   int bt_consumido = originalBT - p->burstTime;
   int bt_pendiente = p->burstTime;
 
-  printf(
-      "{\"event\": \"PROCESS_METRIC\", \"pid\": \"%s\", \"arrivalTime\": %d, "
-      "\"burstTime\": %d, \"burstTimeConsumed\": %d, \"burstTimePending\": %d, "
-      "\"priority\": %d, \"startTime\": %d, \"endTime\": %d, \"waitingTime\": %d}\n",
-      p->pid, p->arrivalTime, originalBT, bt_consumido, bt_pendiente,
-      p->priority, p->startTime, p->finishTime, p->waitingTime);
-  fflush(stdout);
+  char line[320];
+  snprintf(line, sizeof(line),
+           "{\"event\": \"PROCESS_METRIC\", \"pid\": \"%s\", \"arrivalTime\": %d, "
+           "\"burstTime\": %d, \"burstTimeConsumed\": %d, \"burstTimePending\": %d, "
+           "\"priority\": %d, \"startTime\": %d, \"endTime\": %d, \"waitingTime\": %d}",
+           p->pid, p->arrivalTime, originalBT, bt_consumido, bt_pendiente,
+           p->priority, p->startTime, p->finishTime, p->waitingTime);
+  emitEventLine(line, -1);
+  if (!outputMuted)
+    traceProcessMetric(p);
 }
 
 /**
@@ -317,23 +653,51 @@ void exportProcessMetricWithOriginalBT(const Process *p, int originalBT)
  */
 void exportEventRealtime(TimelineEvent *event)
 {
-  printf("{\"pid\": \"%s\", \"startCycle\": %d, \"endCycle\": %d, \"state\": \"%s\"}\n",
-         event->pid,
-         event->startCycle,
-         event->endCycle,
-         getProcessStateName(event->state));
-  fflush(stdout);
+  char line[160];
+  if (outputMuted)
+    return; // Corridas sin salida (what-if, búsqueda del quantum): no vale la pena armar la línea
+  snprintf(line, sizeof(line), "{\"pid\": \"%s\", \"startCycle\": %d, \"endCycle\": %d, \"state\": \"%s\"}",
+           event->pid,
+           event->startCycle,
+           event->endCycle,
+           getProcessStateName(event->state));
+  emitEventLine(line, event->startCycle);
 }
 
 void exportSyncEventRealtime(TimelineEvent *event, ActionType action)
 {
-  printf("{\"pid\": \"%s\", \"startCycle\": %d, \"endCycle\": %d, \"state\": \"%s\", \"action\": \"%s\"}\n",
-         event->pid,
-         event->startCycle,
-         event->endCycle,
-         getProcessStateName(event->state),
-         getActionTypeName(action));
-  fflush(stdout);
+  char line[192];
+  if (outputMuted)
+    return;
+  snprintf(line, sizeof(line), "{\"pid\": \"%s\", \"startCycle\": %d, \"endCycle\": %d, \"state\": \"%s\", \"action\": \"%s\"}",
+           event->pid,
+           event->startCycle,
+           event->endCycle,
+           getProcessStateName(event->state),
+           getActionTypeName(action));
+  emitEventLine(line, event->startCycle);
+}
+
+/**
+ * Imprime en formato JSON las métricas de inversión de prioridad de un proceso.
+ *
+ * Se considera inversión cada ciclo en que el proceso esperó por un recurso
+ * retenido (o bloqueado por techo) por un proceso de menor prioridad base.
+ *
+ * @param p                Puntero al proceso.
+ * @param inversionTime    Total de ciclos en inversión de prioridad.
+ * @param longestInversion Racha más larga de ciclos consecutivos en inversión.
+ */
+void exportInversionMetric(const Process *p, int inversionTime, int longestInversion)
+{
+  char line[192];
+  snprintf(line, sizeof(line),
+           "{\"event\": \"INVERSION_METRIC\", \"pid\": \"%s\", \"priority\": %d, "
+           "\"inversionTime\": %d, \"longestInversion\": %d}",
+           p->pid, p->priority, inversionTime, longestInversion);
+  emitEventLine(line, -1);
+  if (!outputMuted)
+    traceInversionMetric(p, inversionTime);
 }
 
 /**
@@ -345,8 +709,9 @@ void exportSyncEventRealtime(TimelineEvent *event, ActionType action)
  */
 void exportSimulationEnd()
 {
-  printf("{\"event\": \"SIMULATION_END\"}\n");
-  fflush(stdout);
+  static const char line[] = "{\"event\": \"SIMULATION_END\"}";
+  flushCycleFrame();
+  writeOutputLine(line, sizeof(line) - 1);
 }
 
 /**
@@ -356,7 +721,8 @@ void exportSimulationEnd()
  * en el ciclo actual (`currentTime`). El evento se guarda en el arreglo `events` en la posición indicada por `*eventCount`,
  * luego se exporta en tiempo real mediante `exportEventRealtime` y finalmente se incrementa el contador de eventos.
  *
- * El evento registrado cubre un ciclo desde `currentTime` hasta `currentTime + 1`.
+ * El evento registrado cubre un ciclo desde `currentTime` hasta `currentTime + 1`. El arreglo guarda los
+ * últimos MAX_EVENTS eventos (se reutiliza de forma circular), por lo que las simulaciones largas no lo desbordan.
  *
  * @param process Puntero al proceso (`Process`) para el cual se registra el evento.
  * @param currentTime Tiempo actual del ciclo en la simulación.
@@ -367,21 +733,54 @@ void exportSimulationEnd()
  */
 void printEventForProcess(Process *process, int currentTime, ProcessState state, TimelineEvent *events, int *eventCount)
 {
-  snprintf(events[*eventCount].pid, COMMON_MAX_LEN, "%s", process->pid);
-  events[*eventCount].startCycle = currentTime;
-  events[*eventCount].endCycle = currentTime + 1;
-  events[*eventCount].state = state;
-  exportEventRealtime(&events[*eventCount]);
+  TimelineEvent *event = &events[*eventCount % MAX_EVENTS];
+  snprintf(event->pid, COMMON_MAX_LEN, "%s", process->pid);
+  event->startCycle = currentTime;
+  event->endCycle = currentTime + 1;
+  event->state = state;
+  exportEventRealtime(event);
+  if (!outputMuted)
+  {
+    traceProcessEvent(process, currentTime, state, ACTION_NONE);
+    telemetryProcessEvent(process, currentTime, state, ACTION_NONE);
+  }
+  (*eventCount)++;
+}
+
+// Evento de un proceso en un dispositivo de I/O (IO o IO_WAITING), con el nombre del dispositivo
+void printEventForDeviceProcess(Process *process, int currentTime, ProcessState state, const char *device, TimelineEvent *events, int *eventCount)
+{
+  TimelineEvent *event = &events[*eventCount % MAX_EVENTS];
+  snprintf(event->pid, COMMON_MAX_LEN, "%s", process->pid);
+  event->startCycle = currentTime;
+  event->endCycle = currentTime + 1;
+  event->state = state;
+
+  if (!outputMuted)
+  {
+    char line[192];
+    snprintf(line, sizeof(line), "{\"pid\": \"%s\", \"startCycle\": %d, \"endCycle\": %d, \"state\": \"%s\", \"device\": \"%s\"}",
+             event->pid, event->startCycle, event->endCycle, getProcessStateName(state), device);
+    emitEventLine(line, event->startCycle);
+    traceProcessEvent(process, currentTime, state, ACTION_NONE);
+    telemetryProcessEvent(process, currentTime, state, ACTION_NONE);
+  }
   (*eventCount)++;
 }
 
 void printEventForSyncProcess(Process *process, int currentTime, ProcessState state, TimelineEvent *events, int *eventCount, ActionType action)
 {
-  snprintf(events[*eventCount].pid, COMMON_MAX_LEN, "%s", process->pid);
-  events[*eventCount].startCycle = currentTime;
-  events[*eventCount].endCycle = currentTime + 1;
-  events[*eventCount].state = state;
-
-  exportSyncEventRealtime(&events[*eventCount], action);
+  TimelineEvent *event = &events[*eventCount % MAX_EVENTS];
+  snprintf(event->pid, COMMON_MAX_LEN, "%s", process->pid);
+  event->startCycle = currentTime;
+  event->endCycle = currentTime + 1;
+  event->state = state;
+
+  exportSyncEventRealtime(event, action);
+  if (!outputMuted)
+  {
+    traceProcessEvent(process, currentTime, state, action);
+    telemetryProcessEvent(process, currentTime, state, action);
+  }
   (*eventCount)++;
 }
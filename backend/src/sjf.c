@@ -1,4 +1,7 @@
 #include "simulator.h"
+#include "checkpoint.h"
+#include "dag.h"
+#include "selection.h"
 #include <stdio.h>
 #include <string.h>
 #include <unistd.h>
@@ -37,6 +40,7 @@ void simulateSJF(Process *processes, int processCount,
   int completed = 0;
   *eventCount = 0;
   bool newPrinted[MAX_PROCESSES] = {false};
+  int dependent = beginDependencies(processes, processCount);
 
   // NEW si llegaron en tiempo 0
   for (int i = 0; i < processCount; i++)
@@ -47,82 +51,115 @@ void simulateSJF(Process *processes, int processCount,
       newPrinted[i] = true;
     }
   }
+
+  int runningIdx = -1; // Proceso en ejecución hasta completar su ráfaga
+  int ranCycles = 0;   // Ciclos ejecutados por runningIdx
+
+  // Estado del bucle principal para los snapshots (seek)
+  CheckpointRegion loopRegions[] = {
+      {&currentTime, sizeof(currentTime)},
+      {&completed, sizeof(completed)},
+      {&runningIdx, sizeof(runningIdx)},
+      {&ranCycles, sizeof(ranCycles)},
+      {newPrinted, sizeof(bool) * processCount},
+      {processes, sizeof(Process) * processCount},
+  };
+  CheckpointRegion regions[CHECKPOINT_REGION_COUNT(loopRegions) + CHECKPOINT_OPTIONAL_REGIONS];
+  int regionCount = CHECKPOINT_REGION_COUNT(loopRegions);
+  memcpy(regions, loopRegions, sizeof(loopRegions));
+  if (dependent)
+    regions[regionCount++] = dependencyRegion();
+  restoreCheckpoint(regions, regionCount);
+
+  // Llegada, ráfaga y procesos terminados que recorre la selección (se arman después de reanudar)
+  ProcessColumns columns;
+  loadProcessColumns(&columns, processes, processCount);
+
   while (completed < processCount)
   {
-    // Registrar procesos que llegan justo en este ciclo
-    for (int i = 0; i < processCount; i++)
-    {
-      if (processes[i].arrivalTime == currentTime && !newPrinted[i])
-      {
-        printEventForProcess(&processes[i], currentTime, STATE_NEW, events, eventCount);
-        newPrinted[i] = true;
-      }
-    }
+    checkpointCycle(currentTime, regions, regionCount, processes, processCount);
 
-    int shortestIdx = -1;
-
-    // Buscar proceso con menor burst que ya haya llegado y no haya terminado
-    for (int i = 0; i < processCount; i++)
+    // Registrar procesos que llegan justo después del ciclo ejecutado
+    if (runningIdx != -1 && ranCycles > 0)
     {
-      if (processes[i].arrivalTime <= currentTime &&
-          processes[i].state != STATE_TERMINATED)
+      for (int i = 0; i < processCount; i++)
       {
-        if (shortestIdx == -1 ||
-            processes[i].burstTime < processes[shortestIdx].burstTime ||
-            (processes[i].burstTime == processes[shortestIdx].burstTime &&
-             processes[i].arrivalTime < processes[shortestIdx].arrivalTime))
+        if (processes[i].arrivalTime == currentTime)
         {
-          shortestIdx = i;
+          printEventForProcess(&processes[i], currentTime, STATE_NEW, events, eventCount);
         }
       }
     }
 
-    // No hay procesos listos aún
-    if (shortestIdx == -1)
+    // Termina el proceso
+    if (runningIdx != -1 && ranCycles == processes[runningIdx].burstTime)
     {
-      currentTime++;
-      usleep(SIMULATION_DELAY_US);
-      continue;
+      Process *done = &processes[runningIdx];
+      done->state = STATE_TERMINATED;
+      columns.remaining[runningIdx] = -1;
+      printEventForProcess(done, currentTime - 1, STATE_TERMINATED, events, eventCount);
+      exportProcessMetric(done);
+      releaseDependents(processes, runningIdx, currentTime, columns.arrival);
+      completed++;
+      runningIdx = -1;
+      if (completed == processCount)
+        break;
     }
 
-    Process *p = &processes[shortestIdx];
-    p->startTime = currentTime;
-    p->finishTime = currentTime + p->burstTime;
-    p->waitingTime = p->startTime - p->arrivalTime;
-
-    // Ejecutar el proceso ciclo por ciclo
-    for (int c = 0; c < p->burstTime; c++)
+    if (runningIdx == -1)
     {
-      // Registrar procesos en WAITING
+      // Registrar procesos que llegan justo en este ciclo
       for (int i = 0; i < processCount; i++)
       {
-        if (i != shortestIdx &&
-            processes[i].arrivalTime <= currentTime &&
-            processes[i].state != STATE_TERMINATED)
+        if (processes[i].arrivalTime == currentTime && !newPrinted[i])
         {
-          printEventForProcess(&processes[i], currentTime, STATE_WAITING, events, eventCount);
+          printEventForProcess(&processes[i], currentTime, STATE_NEW, events, eventCount);
+          newPrinted[i] = true;
         }
       }
 
-      // Ejecutar proceso actual
-      printEventForProcess(p, currentTime, STATE_ACCESSED, events, eventCount);
-      currentTime++;
-      usleep(SIMULATION_DELAY_US);
+      // Buscar proceso con menor burst que ya haya llegado y no haya terminado
+      int shortestIdx = selectShortestJob(&columns, processCount, currentTime);
 
-      // Registrar procesos que llegan justo ahora
-      for (int i = 0; i < processCount; i++)
+      // No hay procesos listos aún
+      if (shortestIdx == -1)
       {
-        if (processes[i].arrivalTime == currentTime)
-        {
-          printEventForProcess(&processes[i], currentTime, STATE_NEW, events, eventCount);
-        }
+        currentTime++;
+        endSimulationCycle();
+        continue;
       }
+
+      Process *p = &processes[shortestIdx];
+      p->startTime = currentTime;
+      p->finishTime = currentTime + p->burstTime;
+      p->waitingTime = p->startTime - p->arrivalTime;
+
+      runningIdx = shortestIdx;
+      ranCycles = 0;
+
+      // Sin ciclos que ejecutar: termina en la próxima iteración
+      if (p->burstTime == 0)
+        continue;
     }
 
-    // Termina el proceso
-    p->state = STATE_TERMINATED;
-    printEventForProcess(p, currentTime - 1, STATE_TERMINATED, events, eventCount);
-    exportProcessMetric(p);
-    completed++;
+    // Ejecutar el proceso ciclo por ciclo
+
+    // Registrar procesos en WAITING
+    for (int i = 0; i < processCount; i++)
+    {
+      if (i != runningIdx &&
+          columns.arrival[i] <= currentTime &&
+          columns.remaining[i] >= 0)
+      {
+        printEventForProcess(&processes[i], currentTime, STATE_WAITING, events, eventCount);
+      }
+    }
+
+    // Ejecutar proceso actual
+    printEventForProcess(&processes[runningIdx], currentTime, STATE_ACCESSED, events, eventCount);
+    currentTime++;
+    ranCycles++;
+    endSimulationCycle();
   }
-}
\ No newline at end of file
+  finishCheckpoints(currentTime);
+}
@@ -1,8 +1,11 @@
 #include "srt.h"
+#include "checkpoint.h"
+#include "dag.h"
+#include "selection.h"
+#include "switching.h"
 #include <stdio.h>
 #include <string.h>
 #include <unistd.h>
-#include <limits.h>
 #include <stdbool.h>
 
 /**
@@ -37,14 +40,15 @@ void simulateSRT(Process *processes, int processCount,
 {
   int currentTime = 0;
   int completed = 0;
-  int remainingTime[MAX_PROCESSES];
+  ProcessColumns columns; // Llegada, prioridad y ráfaga pendiente que recorre la selección
   *eventCount = 0;
   bool newPrinted[MAX_PROCESSES] = {false};
   int lastExecutedIdx = -1;
+  int dependent = beginDependencies(processes, processCount);
 
+  loadProcessColumns(&columns, processes, processCount);
   for (int i = 0; i < processCount; i++)
   {
-    remainingTime[i] = processes[i].burstTime;
     processes[i].startTime = -1;
 
     if (processes[i].arrivalTime == 0)
@@ -54,8 +58,49 @@ void simulateSRT(Process *processes, int processCount,
     }
   }
 
+  // Estado del bucle principal para los snapshots (seek)
+  CheckpointRegion loopRegions[] = {
+      {&currentTime, sizeof(currentTime)},
+      {&completed, sizeof(completed)},
+      {&lastExecutedIdx, sizeof(lastExecutedIdx)},
+      {newPrinted, sizeof(bool) * processCount},
+      {columns.remaining, sizeof(int) * processCount},
+      {processes, sizeof(Process) * processCount},
+  };
+  CheckpointRegion regions[CHECKPOINT_REGION_COUNT(loopRegions) + CHECKPOINT_OPTIONAL_REGIONS];
+  int regionCount = CHECKPOINT_REGION_COUNT(loopRegions);
+  memcpy(regions, loopRegions, sizeof(loopRegions));
+  if (dependent)
+    regions[regionCount++] = dependencyRegion();
+  if (beginSwitchModel(&control->config))
+    regions[regionCount++] = switchModelRegion();
+  restoreCheckpoint(regions, regionCount);
+
+  // Al reanudar, las llegadas de los procesos ya liberados vienen del snapshot
+  for (int i = 0; dependent && i < processCount; i++)
+    columns.arrival[i] = processes[i].arrivalTime;
+
   while (completed < processCount)
   {
+    checkpointCycle(currentTime, regions, regionCount, processes, processCount);
+
+    // Si el proceso ejecutado en el ciclo anterior terminó
+    if (lastExecutedIdx != -1 &&
+        columns.remaining[lastExecutedIdx] == 0 &&
+        processes[lastExecutedIdx].state != STATE_TERMINATED)
+    {
+      Process *last = &processes[lastExecutedIdx];
+      last->finishTime = currentTime;
+      last->waitingTime = last->finishTime - last->arrivalTime - last->burstTime;
+      last->state = STATE_TERMINATED;
+      printEventForProcess(last, currentTime - 1, STATE_TERMINATED, events, eventCount);
+      exportProcessMetric(last);
+      releaseDependents(processes, lastExecutedIdx, currentTime, columns.arrival);
+      completed++;
+      if (completed == processCount)
+        break;
+    }
+
     // Registrar procesos que acaban de llegar
     for (int i = 0; i < processCount; i++)
     {
@@ -66,41 +111,14 @@ void simulateSRT(Process *processes, int processCount,
       }
     }
 
-    int shortestIdx = -1;
-    int minRemaining = INT_MAX;
-
-    // Escoger el proceso con menor bt a ejecutar
-    for (int i = 0; i < processCount; i++)
-    {
-      if (processes[i].arrivalTime <= currentTime &&
-          processes[i].state != STATE_TERMINATED &&
-          remainingTime[i] > 0)
-      {
-        if (remainingTime[i] < minRemaining)
-        {
-          minRemaining = remainingTime[i];
-          shortestIdx = i;
-        }
-        else if (remainingTime[i] == minRemaining) // empate bt
-        {
-          // continuar con el proceso que ya estaba ejecutando
-          if (i == lastExecutedIdx)
-          {
-            shortestIdx = i;
-          }
-          // Si ninguno estaba ejecutando, elegimos el de mayor prioridad (menor valor)
-          else if (shortestIdx != lastExecutedIdx && processes[i].priority < processes[shortestIdx].priority)
-          {
-            shortestIdx = i;
-          }
-        }
-      }
-    }
+    // Escoger el proceso con menor bt a ejecutar (en empate sigue el que ya ejecutaba; si no, el de
+    // mayor prioridad)
+    int shortestIdx = selectShortestRemaining(&columns, processCount, currentTime, lastExecutedIdx);
 
     if (shortestIdx == -1)
     {
       currentTime++;
-      usleep(SIMULATION_DELAY_US);
+      endSimulationCycle();
       continue;
     }
 
@@ -108,9 +126,8 @@ void simulateSRT(Process *processes, int processCount,
     for (int i = 0; i < processCount; i++)
     {
       if (i != shortestIdx &&
-          processes[i].arrivalTime <= currentTime &&
-          processes[i].state != STATE_TERMINATED &&
-          remainingTime[i] > 0)
+          columns.arrival[i] <= currentTime &&
+          columns.remaining[i] > 0)
       {
         printEventForProcess(&processes[i], currentTime, STATE_WAITING, events, eventCount);
       }
@@ -121,22 +138,21 @@ void simulateSRT(Process *processes, int processCount,
     if (p->startTime == -1)
       p->startTime = currentTime;
 
+    // Cambio de contexto: ocupa la CPU sin avanzar la ráfaga
+    if (switchingCycle(shortestIdx, currentTime))
+    {
+      printEventForProcess(p, currentTime, STATE_SWITCHING, events, eventCount);
+      currentTime++;
+      endSimulationCycle();
+      continue;
+    }
+
     // Ejecutar 1 ciclo
     printEventForProcess(p, currentTime, STATE_ACCESSED, events, eventCount);
     currentTime++;
-    remainingTime[shortestIdx]--;
+    columns.remaining[shortestIdx]--;
     lastExecutedIdx = shortestIdx;
-    usleep(SIMULATION_DELAY_US);
-
-    // Si termina
-    if (remainingTime[shortestIdx] == 0)
-    {
-      p->finishTime = currentTime;
-      p->waitingTime = p->finishTime - p->arrivalTime - p->burstTime;
-      p->state = STATE_TERMINATED;
-      printEventForProcess(p, currentTime - 1, STATE_TERMINATED, events, eventCount);
-      exportProcessMetric(p);
-      completed++;
-    }
+    endSimulationCycle();
   }
+  finishCheckpoints(currentTime);
 }
\ No newline at end of file
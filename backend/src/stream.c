@@ -0,0 +1,235 @@
+#include "stream.h"
+#include "ready_queue.h"
+#include "selection.h"
+#include "switching.h"
+#include <stdio.h>
+#include <string.h>
+#include <stdbool.h>
+
+static StreamStats stats;
+
+/**
+ * Entrada en línea: el próximo proceso leído y todavía no admitido, y el ciclo antes del cual se sabe
+ * que no llega nada más.
+ */
+typedef struct
+{
+  FILE *in;
+  Process pending;
+  bool hasPending;
+  int watermark;
+  bool closed;
+} StreamInput;
+
+// Lee una línea de la entrada: un proceso queda pendiente, una marca "@N" adelanta `watermark`
+static void readStreamLine(StreamInput *input)
+{
+  char line[512];
+  if (!fgets(line, sizeof(line), input->in))
+  {
+    input->closed = true;
+    return;
+  }
+  line[strcspn(line, "\r\n")] = '\0';
+
+  int cycle;
+  if (strcmp(line, STREAM_END_MARK) == 0)
+  {
+    input->closed = true;
+  }
+  else if (line[0] == '@' && sscanf(line + 1, "%d", &cycle) == 1)
+  {
+    if (cycle > input->watermark)
+      input->watermark = cycle;
+  }
+  else if (line[strspn(line, " \t")] != '\0')
+  {
+    Process *p = &input->pending;
+    if (!parseProcessLine(line, p) || p->burstTime <= 0 || p->arrivalTime < 0)
+    {
+      fprintf(stderr, "Stream: se descarta la línea \"%s\".\n", line);
+      stats.rejected++;
+      return;
+    }
+    input->hasPending = true;
+
+    // Los procesos llegan en orden: ninguno posterior llega antes que este
+    if (p->arrivalTime > input->watermark)
+      input->watermark = p->arrivalTime;
+  }
+}
+
+// Primer lugar libre de la tabla de procesos vivos (-1 si está llena)
+static int freeSlot(const bool *live)
+{
+  for (int i = 0; i < STREAM_MAX_LIVE; i++)
+  {
+    if (!live[i])
+      return i;
+  }
+  return -1;
+}
+
+int simulateStream(FILE *in, Process *slots,
+                   TimelineEvent *events, int *eventCount,
+                   SimulationControl *control)
+{
+  SchedulingAlgorithm algorithm = control->config.algorithm;
+  if (algorithm != ALGO_FIFO && algorithm != ALGO_SJF && algorithm != ALGO_RR &&
+      algorithm != ALGO_PRIORITY && algorithm != ALGO_SRT)
+    return -1;
+
+  StreamInput input = {in, {{0}}, false, 0, false};
+  bool live[STREAM_MAX_LIVE] = {false};
+  int remaining[STREAM_MAX_LIVE];
+  int admission[STREAM_MAX_LIVE]; // Lugares vivos en orden de admisión
+  ProcessColumns columns;         // Búsqueda de los algoritmos salvo RR, en orden de admisión
+  ReadyQueue rrQueue = {{0}, 0, 0};
+  int liveCount = 0;
+  int currentTime = 0;
+  int current = -1; // proceso en CPU
+  int quantumCounter = 0;
+  bool isRR = algorithm == ALGO_RR;
+
+  memset(&stats, 0, sizeof(stats));
+  beginSwitchModel(&control->config);
+  *eventCount = 0;
+
+  for (;;)
+  {
+    // Llegadas del ciclo: se lee la entrada hasta saber que no llega nada más en él
+    for (;;)
+    {
+      if (!input.hasPending)
+      {
+        if (input.closed || input.watermark > currentTime)
+          break;
+        readStreamLine(&input);
+        continue;
+      }
+      if (input.pending.arrivalTime > currentTime)
+        break;
+      int slot = freeSlot(live);
+      if (slot < 0)
+        break; // Tabla llena: se admite cuando termine algún proceso
+
+      Process *p = &slots[slot];
+      *p = input.pending;
+      input.hasPending = false;
+      if (p->arrivalTime < currentTime)
+      {
+        p->arrivalTime = currentTime;
+        stats.delayed++;
+      }
+
+      live[slot] = true;
+      remaining[slot] = p->burstTime;
+      admission[liveCount] = slot;
+      forgetSwitchProcess(slot); // El lugar puede haber sido de otro proceso
+      if (++liveCount > stats.maxLive)
+        stats.maxLive = liveCount;
+
+      printEventForProcess(p, currentTime, STATE_NEW, events, eventCount);
+      p->state = STATE_WAITING;
+      if (isRR)
+        enqueueReady(&rrQueue, slot);
+    }
+
+    if (liveCount == 0 && !input.hasPending && input.closed)
+      break;
+
+    // CPU
+    if (isRR)
+    {
+      if (current == -1 ||
+          quantumCounter >= getQuantumForPriority(&control->config, slots[current].priority))
+      {
+        if (current != -1)
+          enqueueReady(&rrQueue, current); // reencolar el proceso actual
+        current = dequeueReady(&rrQueue);
+        quantumCounter = 0;
+      }
+    }
+    else
+    {
+      // Cada proceso se admite en su ciclo de llegada, así que el orden de admisión también ordena las
+      // llegadas y el menor índice desempata a favor del admitido primero
+      int currentPos = -1;
+      for (int k = 0; k < liveCount; k++)
+      {
+        int slot = admission[k];
+        columns.arrival[k] = slots[slot].arrivalTime;
+        columns.burst[k] = remaining[slot];
+        columns.priority[k] = slots[slot].priority;
+        columns.remaining[k] = slots[slot].state == STATE_WAITING ? remaining[slot] : -1;
+        if (slot == current)
+          currentPos = k;
+      }
+      int chosen = selectReadyProcess(&columns, liveCount, currentTime, &control->config, currentPos);
+      current = chosen == -1 ? -1 : admission[chosen];
+    }
+
+    if (current != -1 && slots[current].startTime == -1)
+      slots[current].startTime = currentTime;
+
+    // Procesos listos que no tienen la CPU
+    for (int i = 0; i < STREAM_MAX_LIVE; i++)
+    {
+      if (live[i] && i != current && slots[i].state == STATE_WAITING)
+      {
+        printEventForProcess(&slots[i], currentTime, STATE_WAITING, events, eventCount);
+        slots[i].waitingTime++;
+      }
+    }
+
+    if (current != -1 && switchingCycle(current, currentTime))
+    {
+      // Cambio de contexto: ocupa la CPU sin avanzar la ráfaga ni el quantum
+      printEventForProcess(&slots[current], currentTime, STATE_SWITCHING, events, eventCount);
+      stats.cpuBusyCycles++;
+    }
+    else if (current != -1)
+    {
+      Process *p = &slots[current];
+      printEventForProcess(p, currentTime, STATE_ACCESSED, events, eventCount);
+      stats.cpuBusyCycles++;
+      quantumCounter++;
+
+      if (--remaining[current] == 0)
+      {
+        // Terminado: se emiten sus métricas, se acumulan y se libera su lugar
+        p->finishTime = currentTime + 1;
+        p->state = STATE_TERMINATED;
+        printEventForProcess(p, currentTime, STATE_TERMINATED, events, eventCount);
+        exportProcessMetric(p);
+        stats.completed++;
+        stats.waitingTime += p->waitingTime;
+        stats.turnaroundTime += p->finishTime - p->arrivalTime;
+
+        live[current] = false;
+        liveCount--;
+        for (int k = 0; k < liveCount; k++)
+        {
+          if (admission[k] == current)
+          {
+            memmove(admission + k, admission + k + 1, sizeof(int) * (liveCount - k));
+            break;
+          }
+        }
+        current = -1;
+        quantumCounter = 0;
+      }
+    }
+
+    currentTime++;
+    endSimulationCycle();
+  }
+
+  stats.cycles = currentTime;
+  return 0;
+}
+
+StreamStats getStreamStats(void)
+{
+  return stats;
+}
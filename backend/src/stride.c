@@ -0,0 +1,223 @@
+#include "stride.h"
+#include "checkpoint.h"
+#include "dag.h"
+#include "share.h"
+#include "switching.h"
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+/**
+ * Montículo de mínimos de los procesos listos que no ejecutan, ordenado por `pass`. Cada proceso
+ * está a lo sumo una vez, así que MAX_PROCESSES posiciones alcanzan.
+ */
+typedef struct
+{
+  int items[MAX_PROCESSES];
+  int size;
+} PassHeap;
+
+// Orden del montículo: menor pass, luego llegada más temprana, luego menor índice
+static int passBefore(const long long *pass, const Process *processes, int a, int b)
+{
+  if (pass[a] != pass[b])
+    return pass[a] < pass[b];
+  if (processes[a].arrivalTime != processes[b].arrivalTime)
+    return processes[a].arrivalTime < processes[b].arrivalTime;
+  return a < b;
+}
+
+static void pushPass(PassHeap *heap, const long long *pass, const Process *processes, int processIdx)
+{
+  int child = heap->size++;
+  while (child > 0)
+  {
+    int parent = (child - 1) / 2;
+    if (!passBefore(pass, processes, processIdx, heap->items[parent]))
+      break;
+    heap->items[child] = heap->items[parent];
+    child = parent;
+  }
+  heap->items[child] = processIdx;
+}
+
+// Saca el proceso con menor pass (-1 si el montículo está vacío)
+static int popPass(PassHeap *heap, const long long *pass, const Process *processes)
+{
+  if (heap->size == 0)
+    return -1;
+  int top = heap->items[0];
+  int last = heap->items[--heap->size];
+  int parent = 0;
+  for (;;)
+  {
+    int child = 2 * parent + 1;
+    if (child >= heap->size)
+      break;
+    if (child + 1 < heap->size && passBefore(pass, processes, heap->items[child + 1], heap->items[child]))
+      child++;
+    if (!passBefore(pass, processes, heap->items[child], last))
+      break;
+    heap->items[parent] = heap->items[child];
+    parent = child;
+  }
+  if (heap->size > 0)
+    heap->items[parent] = last;
+  return top;
+}
+
+/**
+ * Simula la planificación por pasos (Stride Scheduling) para un conjunto de procesos.
+ *
+ * @param processes    Arreglo de procesos a simular.
+ * @param processCount Número de procesos en el arreglo.
+ * @param events       Arreglo para registrar eventos de ejecución (TimelineEvent).
+ * @param eventCount   Puntero a entero donde se actualizará el conteo de eventos generados.
+ * @param control      Puntero a estructura de control de simulación con el quantum y los boletos.
+ *
+ * Es la versión determinista de LOTTERY: cada proceso tiene un paso (stride) inversamente
+ * proporcional a sus boletos y un contador `pass` que avanza un paso por cada ciclo que ejecuta. Al
+ * empezar cada quantum ejecuta el proceso listo con menor `pass` (en empate, el que llegó antes), así
+ * que la parte de CPU de cada proceso se mantiene cerca de la proporción de sus boletos en todo
+ * momento y no solo en promedio.
+ *
+ * Un proceso que llega toma el `pass` global, que avanza STRIDE_ONE / (boletos de los listos) por
+ * ciclo ejecutado: entra al mismo nivel que los demás en lugar de acumular ventaja por haber llegado
+ * tarde. Los listos que no ejecutan están en un montículo ordenado por `pass`.
+ *
+ * En cada ciclo de reloj se registran NEW, WAITING y ACCESSED (o SWITCHING durante un cambio de
+ * contexto) igual que en RR, y se acumula la parte de CPU recibida frente a la que correspondía
+ * (eventos SHARE y SHARE_METRIC).
+ */
+void simulateStride(Process *processes, int processCount,
+                    TimelineEvent *events, int *eventCount,
+                    SimulationControl *control)
+{
+  int currentTime = 0;
+  int completed = 0;
+  int remainingBurst[MAX_PROCESSES];
+  long long stride[MAX_PROCESSES];
+  long long pass[MAX_PROCESSES];
+  long long tickets[MAX_PROCESSES];
+  long long globalPass = 0;
+  PassHeap heap = {{0}, 0};
+  int quantumCounter = 0;
+  int currentProcess = -1;
+  *eventCount = 0;
+
+  for (int i = 0; i < processCount; i++)
+  {
+    remainingBurst[i] = processes[i].burstTime;
+    tickets[i] = getProcessTickets(&control->config, &processes[i]);
+    stride[i] = STRIDE_ONE / tickets[i];
+    pass[i] = 0;
+  }
+
+  // Estado del bucle principal para los snapshots (seek)
+  CheckpointRegion loopRegions[] = {
+      {&currentTime, sizeof(currentTime)},
+      {&completed, sizeof(completed)},
+      {&currentProcess, sizeof(currentProcess)},
+      {&quantumCounter, sizeof(quantumCounter)},
+      {&globalPass, sizeof(globalPass)},
+      {&heap, sizeof(heap)},
+      {pass, sizeof(long long) * processCount},
+      {remainingBurst, sizeof(int) * processCount},
+      {processes, sizeof(Process) * processCount},
+  };
+  CheckpointRegion regions[CHECKPOINT_REGION_COUNT(loopRegions) + CHECKPOINT_OPTIONAL_REGIONS];
+  int regionCount = CHECKPOINT_REGION_COUNT(loopRegions);
+  memcpy(regions, loopRegions, sizeof(loopRegions));
+  beginShareReport(&control->config, processes, processCount);
+  regions[regionCount++] = shareReportRegion();
+  if (beginDependencies(processes, processCount))
+    regions[regionCount++] = dependencyRegion();
+  if (beginSwitchModel(&control->config))
+    regions[regionCount++] = switchModelRegion();
+  restoreCheckpoint(regions, regionCount);
+
+  while (completed < processCount)
+  {
+    checkpointCycle(currentTime, regions, regionCount, processes, processCount);
+
+    // Registrar NEW: el proceso entra al montículo con el pass global
+    for (int i = 0; i < processCount; i++)
+    {
+      if (processes[i].arrivalTime == currentTime && processes[i].state == STATE_NEW)
+      {
+        printEventForProcess(&processes[i], currentTime, STATE_NEW, events, eventCount);
+        processes[i].state = STATE_WAITING;
+        pass[i] = globalPass;
+        pushPass(&heap, pass, processes, i);
+      }
+    }
+
+    // Sin proceso en turno o con el quantum agotado ejecuta el de menor pass (el actual también compite)
+    if (currentProcess == -1 ||
+        quantumCounter >= getQuantumForPriority(&control->config, processes[currentProcess].priority))
+    {
+      if (currentProcess != -1)
+        pushPass(&heap, pass, processes, currentProcess);
+
+      currentProcess = popPass(&heap, pass, processes);
+      quantumCounter = 0;
+      if (currentProcess != -1 && processes[currentProcess].startTime == -1)
+      {
+        processes[currentProcess].startTime = currentTime;
+      }
+    }
+
+    // Registrar WAITING (una vez por ciclo) para los procesos listos que no se ejecutan
+    for (int i = 0; i < processCount; i++)
+    {
+      if (i != currentProcess && processes[i].state == STATE_WAITING)
+      {
+        printEventForProcess(&processes[i], currentTime, STATE_WAITING, events, eventCount);
+      }
+    }
+
+    int executed = -1;
+    if (currentProcess != -1 && switchingCycle(currentProcess, currentTime))
+    {
+      // Cambio de contexto: ocupa la CPU sin avanzar la ráfaga, el quantum ni el pass
+      printEventForProcess(&processes[currentProcess], currentTime, STATE_SWITCHING, events, eventCount);
+    }
+    else if (currentProcess != -1)
+    {
+      printEventForProcess(&processes[currentProcess], currentTime, STATE_ACCESSED, events, eventCount);
+      remainingBurst[currentProcess]--;
+      quantumCounter++;
+      executed = currentProcess;
+
+      // El pass global avanza según los boletos de todos los listos (incluido el que ejecuta)
+      long long readyTickets = 0;
+      for (int i = 0; i < processCount; i++)
+      {
+        if (processes[i].state == STATE_WAITING)
+          readyTickets += tickets[i];
+      }
+      globalPass += STRIDE_ONE / readyTickets;
+      pass[currentProcess] += stride[currentProcess];
+
+      if (remainingBurst[currentProcess] == 0)
+      {
+        Process *done = &processes[currentProcess];
+        done->finishTime = currentTime + 1;
+        done->waitingTime = done->finishTime - done->arrivalTime - done->burstTime;
+        done->state = STATE_TERMINATED;
+        printEventForProcess(done, currentTime, STATE_TERMINATED, events, eventCount);
+        exportProcessMetric(done);
+        releaseDependents(processes, currentProcess, done->finishTime, NULL);
+        completed++;
+        currentProcess = -1;
+        quantumCounter = 0;
+      }
+    }
+    recordShareCycle(processes, processCount, executed, currentTime);
+
+    currentTime++;
+    endSimulationCycle();
+  }
+  finishShareReport(processes, processCount, currentTime);
+  finishCheckpoints(currentTime);
+}
@@ -0,0 +1,109 @@
+#include "switching.h"
+#include <string.h>
+
+static struct
+{
+  SwitchCostConfig cost;
+  int active;
+
+  // Estado que cambia durante la simulación (región de los snapshots)
+  struct
+  {
+    int lastProcess; // Último proceso que avanzó su ráfaga (-1: ninguno, -2: uno que ya terminó)
+    int incoming;    // Proceso que tiene la CPU en el cambio en curso (-1: ninguno)
+    int pending;     // Ciclos de cambio que le faltan a `incoming`
+    int lastRun[MAX_PROCESSES]; // Último ciclo en que ejecutó cada proceso (-1: nunca)
+    SwitchStats stats;
+  } state;
+} model;
+
+int switchCostEnabled(const SimulationConfig *config)
+{
+  int preemptive = config->algorithm == ALGO_RR || config->algorithm == ALGO_SRT ||
+                   config->algorithm == ALGO_LOTTERY || config->algorithm == ALGO_STRIDE ||
+                   (config->algorithm == ALGO_PRIORITY && config->isPreemptive);
+  return preemptive && (config->switchCost.contextSwitch > 0 || config->switchCost.warmup > 0);
+}
+
+int beginSwitchModel(const SimulationConfig *config)
+{
+  memset(&model, 0, sizeof(model));
+  model.cost = config->switchCost;
+  model.active = switchCostEnabled(config);
+  model.state.lastProcess = -1;
+  model.state.incoming = -1;
+  for (int i = 0; i < MAX_PROCESSES; i++)
+    model.state.lastRun[i] = -1;
+  return model.active;
+}
+
+CheckpointRegion switchModelRegion(void)
+{
+  CheckpointRegion region = {&model.state, sizeof(model.state)};
+  return region;
+}
+
+// Ciclos que cuesta darle la CPU a `processIdx` en `cycle` si antes la tenía otro proceso
+static int switchCost(int processIdx, int cycle)
+{
+  int cost = model.state.lastProcess != -1 ? model.cost.contextSwitch : 0;
+
+  int lastRun = model.state.lastRun[processIdx];
+  int window = model.cost.warmupWindow;
+  if (lastRun == -1 || window <= 0)
+    return cost + model.cost.warmup; // Caché fría
+
+  // La caché se enfría en proporción a los ciclos sin ejecutar, hasta `warmupWindow`
+  int idle = cycle - lastRun - 1;
+  if (idle > window)
+    idle = window;
+  return cost + (model.cost.warmup * idle + window - 1) / window;
+}
+
+int switchingCycle(int processIdx, int cycle)
+{
+  if (!model.active || processIdx < 0 || processIdx >= MAX_PROCESSES)
+    return 0;
+
+  if (processIdx != model.state.incoming)
+  {
+    // Nuevo cambio; volver al último proceso que ejecutó no cuesta nada
+    model.state.incoming = processIdx;
+    model.state.pending = 0;
+    if (processIdx != model.state.lastProcess)
+    {
+      model.state.pending = switchCost(processIdx, cycle);
+      if (model.state.lastProcess != -1)
+        model.state.stats.switches++;
+    }
+  }
+
+  if (model.state.pending > 0)
+  {
+    model.state.pending--;
+    model.state.stats.overheadCycles++;
+    return 1;
+  }
+
+  model.state.lastProcess = processIdx;
+  model.state.lastRun[processIdx] = cycle;
+  model.state.stats.executedCycles++;
+  return 0;
+}
+
+void forgetSwitchProcess(int processIdx)
+{
+  if (processIdx < 0 || processIdx >= MAX_PROCESSES)
+    return;
+
+  model.state.lastRun[processIdx] = -1;
+  if (model.state.incoming == processIdx)
+    model.state.incoming = -1;
+  if (model.state.lastProcess == processIdx)
+    model.state.lastProcess = -2; // Un proceso que ya no existe: el cambio se cobra igual
+}
+
+SwitchStats getSwitchStats(void)
+{
+  return model.state.stats;
+}
@@ -0,0 +1,178 @@
+#include "sync_shards.h"
+#include <stdio.h>
+#include <pthread.h>
+
+#define MAX_SHARDS 64
+
+/**
+ * Trabajo de un ciclo para un shard: posiciones de `order` cuyas acciones usan sus recursos.
+ */
+typedef struct
+{
+  int count;
+  int items[MAX_PROCESSES];
+} ShardQueue;
+
+/**
+ * Estado compartido entre el hilo principal (shard 0) y los hilos de los demás shards.
+ */
+typedef struct
+{
+  SyncState *state;
+  int shardCount;
+  int stop;
+  pthread_mutex_t lock;
+  pthread_cond_t startCond; // Inicio de un ciclo (o de la detención)
+  pthread_cond_t doneCond;  // Todos los shards terminaron el ciclo
+  long generation;          // Ciclos despachados
+  int pending;              // Shards que aún no terminan el ciclo actual
+
+  const int *order;
+  const int *ready;
+  bool *granted;
+  ShardQueue queues[MAX_SHARDS];
+
+  pthread_t handles[MAX_SHARDS];
+  int ids[MAX_SHARDS];
+} ShardPool;
+
+static ShardPool pool;
+
+// Concede en orden las acciones asignadas a un shard
+static void grantShardQueue(int shard)
+{
+  ShardQueue *q = &pool.queues[shard];
+  for (int n = 0; n < q->count; n++)
+  {
+    int k = q->items[n];
+    int i = pool.order[k];
+    int j = pool.ready[i];
+    int blockingRes;
+    pool.granted[k] = grantResource(pool.state, i, pool.state->actionResource[j], &blockingRes);
+  }
+}
+
+static void *shardThreadMain(void *arg)
+{
+  int shard = *(int *)arg;
+  long seen = 0;
+  while (1)
+  {
+    pthread_mutex_lock(&pool.lock);
+    while (pool.generation == seen && !pool.stop)
+      pthread_cond_wait(&pool.startCond, &pool.lock);
+    seen = pool.generation;
+    int stop = pool.stop;
+    pthread_mutex_unlock(&pool.lock);
+    if (stop)
+      break;
+
+    grantShardQueue(shard);
+
+    pthread_mutex_lock(&pool.lock);
+    if (--pool.pending == 0)
+      pthread_cond_signal(&pool.doneCond);
+    pthread_mutex_unlock(&pool.lock);
+  }
+  return NULL;
+}
+
+int startSyncShards(SyncState *s, int shards)
+{
+  if (shards > s->resourceCount)
+    shards = s->resourceCount;
+  if (shards > MAX_SHARDS)
+    shards = MAX_SHARDS;
+  if (shards <= 1)
+    return 1;
+
+  if (s->processCount < SYNC_SHARD_MIN_PROCESSES)
+  {
+    fprintf(stderr, "Con menos de %d procesos la concesión repartida no compensa; será secuencial.\n",
+            SYNC_SHARD_MIN_PROCESSES);
+    return 1;
+  }
+
+  if (s->config->protocol == PROTOCOL_CEILING)
+  {
+    fprintf(stderr, "El techo de prioridad consulta todos los recursos; la concesión será secuencial.\n");
+    return 1;
+  }
+
+  pool.state = s;
+  pool.stop = 0;
+  pool.generation = 0;
+  pool.pending = 0;
+  pthread_mutex_init(&pool.lock, NULL);
+  pthread_cond_init(&pool.startCond, NULL);
+  pthread_cond_init(&pool.doneCond, NULL);
+
+  // El hilo principal atiende el shard 0; si no se crean todos los hilos se usan menos shards
+  pool.shardCount = 1;
+  for (int t = 1; t < shards; t++)
+  {
+    pool.ids[t] = t;
+    if (pthread_create(&pool.handles[t], NULL, shardThreadMain, &pool.ids[t]) != 0)
+    {
+      fprintf(stderr, "Solo se pudieron crear %d de %d shards.\n", t, shards);
+      break;
+    }
+    pool.shardCount++;
+  }
+
+  if (pool.shardCount == 1)
+  {
+    stopSyncShards();
+    return 1;
+  }
+  return pool.shardCount;
+}
+
+void grantActionsSharded(SyncState *s, const int *order, const int *ready, int orderCount, bool *granted)
+{
+  // Enrutar cada acción al shard dueño de su recurso, conservando el orden de atención
+  for (int t = 0; t < pool.shardCount; t++)
+    pool.queues[t].count = 0;
+
+  for (int k = 0; k < orderCount; k++)
+  {
+    ShardQueue *q = &pool.queues[s->actionResource[ready[order[k]]] % pool.shardCount];
+    q->items[q->count++] = k;
+  }
+
+  pool.order = order;
+  pool.ready = ready;
+  pool.granted = granted;
+
+  pthread_mutex_lock(&pool.lock);
+  pool.pending = pool.shardCount - 1;
+  pool.generation++;
+  pthread_cond_broadcast(&pool.startCond);
+  pthread_mutex_unlock(&pool.lock);
+
+  grantShardQueue(0);
+
+  pthread_mutex_lock(&pool.lock);
+  while (pool.pending > 0)
+    pthread_cond_wait(&pool.doneCond, &pool.lock);
+  pthread_mutex_unlock(&pool.lock);
+}
+
+void stopSyncShards(void)
+{
+  if (pool.shardCount == 0)
+    return;
+
+  pthread_mutex_lock(&pool.lock);
+  pool.stop = 1;
+  pthread_cond_broadcast(&pool.startCond);
+  pthread_mutex_unlock(&pool.lock);
+
+  for (int t = 1; t < pool.shardCount; t++)
+    pthread_join(pool.handles[t], NULL);
+
+  pthread_mutex_destroy(&pool.lock);
+  pthread_cond_destroy(&pool.startCond);
+  pthread_cond_destroy(&pool.doneCond);
+  pool.shardCount = 0;
+}
@@ -0,0 +1,283 @@
+#include "sync_spinlock.h"
+#include "synchronization.h"
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * Fase de un proceso dentro del análisis de locks
+ */
+typedef enum
+{
+  LOCK_PHASE_IDLE,    // Sin acción en curso (esperando el ciclo de su siguiente acción)
+  LOCK_PHASE_WAITING, // Esperando el lock (girando o dormido según el tipo)
+  LOCK_PHASE_HANDOFF, // El lock le fue asignado y está en tránsito
+  LOCK_PHASE_HOLDING, // Ejecutando la sección crítica
+  LOCK_PHASE_DONE
+} LockPhase;
+
+/**
+ * Estado de un proceso en el análisis: acciones propias ordenadas por ciclo y fase actual.
+ */
+typedef struct
+{
+  int actionCount;
+  int cycles[MAX_EVENTS];
+  int resourceIdx[MAX_EVENTS];
+  int next; // Siguiente acción a emitir
+
+  LockPhase phase;
+  int resource;
+  double remaining;   // Trabajo restante (HOLDING) o traspaso restante (HANDOFF)
+  long requestOrder;  // Orden de llegada a la cola del lock
+  double requestTime; // Tick en que pidió el lock
+} LockProcess;
+
+/**
+ * Resultados acumulados de un tipo de lock
+ */
+typedef struct
+{
+  int acquisitions;
+  int contended;
+  double wastedTicks; // CPU consumida girando
+  double totalHandoff;
+  double maxHandoff;
+  double totalWait;
+  double lineTransfers;
+  long contextSwitches;
+  long makespan;
+} LockModelResult;
+
+// Generador congruencial para elegir el ganador de un test-and-set de forma reproducible
+static unsigned int nextRandom(unsigned int *seed)
+{
+  *seed = *seed * 1103515245u + 12345u;
+  return (*seed >> 16) & 0x7fff;
+}
+
+// Indica si el proceso consume CPU en su fase actual
+static int isActive(const LockProcess *lp, LockType type)
+{
+  if (lp->phase == LOCK_PHASE_HOLDING)
+    return 1;
+  if (lp->phase == LOCK_PHASE_WAITING || lp->phase == LOCK_PHASE_HANDOFF)
+    return type != LOCK_BLOCKING;
+  return 0;
+}
+
+/**
+ * Elige el sucesor del lock liberado entre los procesos en espera.
+ * test-and-set elige uno arbitrario; los demás respetan el orden de llegada.
+ *
+ * @param waiters Salida: cantidad de procesos esperando el recurso.
+ * @return Índice del sucesor o -1 si no hay procesos esperando.
+ */
+static int pickSuccessor(const LockProcess *procs, int processCount, int resIdx,
+                         LockType type, unsigned int *seed, int *waiters)
+{
+  int candidates[MAX_PROCESSES];
+  int count = 0;
+  int first = -1;
+
+  for (int i = 0; i < processCount; i++)
+  {
+    if (procs[i].phase != LOCK_PHASE_WAITING || procs[i].resource != resIdx)
+      continue;
+    candidates[count++] = i;
+    if (first == -1 || procs[i].requestOrder < procs[first].requestOrder)
+      first = i;
+  }
+
+  *waiters = count;
+  if (count == 0)
+    return -1;
+  if (type == LOCK_TAS)
+    return candidates[nextRandom(seed) % count];
+  return first;
+}
+
+// Costo del traspaso del lock según el tipo y la cantidad de procesos en espera
+static double handoffCost(LockType type, int waiters, const LockCostModel *model)
+{
+  switch (type)
+  {
+  case LOCK_BLOCKING:
+    return model->handoffLatency + model->wakeupLatency;
+  case LOCK_TAS:
+  case LOCK_TICKET:
+    return model->handoffLatency + model->cacheLineTransfer * waiters;
+  case LOCK_MCS:
+  default:
+    return model->handoffLatency + model->cacheLineTransfer;
+  }
+}
+
+/**
+ * Ejecuta la traza completa con un tipo de lock y acumula sus resultados.
+ */
+static LockModelResult runLockModel(LockProcess *procs, int processCount, int resourceCount,
+                                    LockType type, const LockCostModel *model)
+{
+  LockModelResult result;
+  memset(&result, 0, sizeof(result));
+
+  int owner[MAX_PROCESSES];
+  for (int r = 0; r < resourceCount; r++)
+    owner[r] = -1;
+
+  int done = 0;
+  long requestSeq = 0;
+  unsigned int seed = 12345u;
+  double tpc = model->ticksPerCycle;
+
+  for (int i = 0; i < processCount; i++)
+  {
+    procs[i].next = 0;
+    procs[i].phase = procs[i].actionCount > 0 ? LOCK_PHASE_IDLE : LOCK_PHASE_DONE;
+    if (procs[i].phase == LOCK_PHASE_DONE)
+      done++;
+  }
+
+  long tick = 0;
+  while (done < processCount)
+  {
+    // Emitir solicitudes cuyo ciclo ya llegó
+    for (int i = 0; i < processCount; i++)
+    {
+      LockProcess *lp = &procs[i];
+      if (lp->phase != LOCK_PHASE_IDLE || lp->cycles[lp->next] * tpc > tick)
+        continue;
+
+      int r = lp->resourceIdx[lp->next];
+      lp->resource = r;
+      lp->requestTime = tick;
+      lp->requestOrder = requestSeq++;
+
+      if (owner[r] == -1)
+      {
+        // Sin contención: traer la línea del lock y entrar
+        owner[r] = i;
+        lp->phase = LOCK_PHASE_HOLDING;
+        lp->remaining = tpc + model->cacheLineTransfer;
+        result.acquisitions++;
+        result.lineTransfers += 1.0;
+      }
+      else
+      {
+        lp->phase = LOCK_PHASE_WAITING;
+      }
+    }
+
+    // Reparto de CPU cuando hay más hilos activos que núcleos
+    int active = 0;
+    for (int i = 0; i < processCount; i++)
+      active += isActive(&procs[i], type);
+    double rate = (active > model->cores) ? (double)model->cores / active : 1.0;
+
+    for (int i = 0; i < processCount; i++)
+    {
+      LockProcess *lp = &procs[i];
+
+      if (lp->phase == LOCK_PHASE_WAITING && type != LOCK_BLOCKING)
+      {
+        result.wastedTicks += rate;
+        if (type == LOCK_TAS && model->spinCost > 0)
+          result.lineTransfers += rate / model->spinCost;
+      }
+      else if (lp->phase == LOCK_PHASE_HANDOFF)
+      {
+        if (type != LOCK_BLOCKING)
+          result.wastedTicks += rate;
+        lp->remaining -= 1.0;
+        if (lp->remaining <= 0)
+        {
+          lp->phase = LOCK_PHASE_HOLDING;
+          lp->remaining = tpc;
+        }
+      }
+      else if (lp->phase == LOCK_PHASE_HOLDING)
+      {
+        lp->remaining -= rate;
+        if (lp->remaining > 0)
+          continue;
+
+        // Liberar y traspasar al sucesor
+        int r = lp->resource;
+        owner[r] = -1;
+        lp->next++;
+        lp->phase = lp->next < lp->actionCount ? LOCK_PHASE_IDLE : LOCK_PHASE_DONE;
+        if (lp->phase == LOCK_PHASE_DONE)
+          done++;
+
+        int waiters;
+        int successor = pickSuccessor(procs, processCount, r, type, &seed, &waiters);
+        if (successor == -1)
+          continue;
+
+        double handoff = handoffCost(type, waiters, model);
+        if ((type == LOCK_TICKET || type == LOCK_MCS) && active > model->cores)
+          handoff += model->preemptionPenalty * (double)(active - model->cores) / active;
+
+        LockProcess *next = &procs[successor];
+        owner[r] = successor;
+        next->phase = LOCK_PHASE_HANDOFF;
+        next->remaining = handoff;
+
+        result.acquisitions++;
+        result.contended++;
+        result.totalHandoff += handoff;
+        if (handoff > result.maxHandoff)
+          result.maxHandoff = handoff;
+        result.totalWait += tick + handoff - next->requestTime;
+        result.lineTransfers += (type == LOCK_TAS || type == LOCK_TICKET) ? waiters : 1;
+        if (type == LOCK_BLOCKING)
+          result.contextSwitches += 2;
+      }
+    }
+
+    tick++;
+  }
+
+  result.makespan = tick;
+  return result;
+}
+
+void simulateLockModels(const Process *processes, int processCount,
+                        const Resource *resources, int resourceCount,
+                        const Action *actions, int actionCount,
+                        int lockModels, const LockCostModel *model)
+{
+  static LockProcess procs[MAX_PROCESSES];
+  const LockType types[] = {LOCK_BLOCKING, LOCK_TAS, LOCK_TICKET, LOCK_MCS};
+  double tpc = model->ticksPerCycle > 0 ? model->ticksPerCycle : 1;
+
+  // Acciones de cada proceso ordenadas por ciclo (orden estable del archivo)
+  for (int i = 0; i < processCount; i++)
+  {
+    LockProcess *lp = &procs[i];
+    memset(lp, 0, sizeof(LockProcess));
+
+    lp->actionCount = collectProcessActions(processes[i].pid, resources, resourceCount, actions, actionCount,
+                                            lp->cycles, lp->resourceIdx);
+  }
+
+  for (int t = 0; t < 4; t++)
+  {
+    if (!(lockModels & types[t]))
+      continue;
+
+    LockModelResult res = runLockModel(procs, processCount, resourceCount, types[t], model);
+    char line[384];
+    snprintf(line, sizeof(line),
+             "{\"event\": \"LOCK_MODEL_METRIC\", \"lock\": \"%s\", \"cores\": %d, \"acquisitions\": %d, "
+             "\"contended\": %d, \"wastedCycles\": %.2f, \"avgHandoffCycles\": %.3f, \"maxHandoffCycles\": %.3f, "
+             "\"avgWaitCycles\": %.3f, \"lineTransfers\": %.0f, \"contextSwitches\": %ld, \"makespanCycles\": %.2f}",
+             getLockTypeName(types[t]), model->cores, res.acquisitions, res.contended,
+             res.wastedTicks / tpc,
+             res.contended > 0 ? res.totalHandoff / res.contended / tpc : 0.0,
+             res.maxHandoff / tpc,
+             res.contended > 0 ? res.totalWait / res.contended / tpc : 0.0,
+             res.lineTransfers, res.contextSwitches, res.makespan / tpc);
+    emitEventLine(line, -1);
+  }
+}
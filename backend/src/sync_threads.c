@@ -0,0 +1,271 @@
+#define _GNU_SOURCE
+#include "sync_threads.h"
+#include "synchronization.h"
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <sys/resource.h>
+
+/**
+ * Primitivas reales compartidas por todos los hilos de la reproducción.
+ */
+typedef struct
+{
+  int useMutex;
+  int cycleUs;
+  int timeoutMs;
+  int holdAcrossCycles; // Con colas o protocolo, las acciones consecutivas retienen el recurso
+  pthread_mutex_t mutexes[MAX_PROCESSES];
+  sem_t semaphores[MAX_PROCESSES];
+  struct timespec start; // Instante real que corresponde al ciclo 0
+} ThreadedScenario;
+
+/**
+ * Datos de un hilo: acciones propias ordenadas por ciclo y métricas medidas.
+ */
+typedef struct
+{
+  ThreadedScenario *scenario;
+  int actionCount;
+  int cycles[MAX_EVENTS];
+  int resourceIdx[MAX_EVENTS];
+
+  int accesses;        // Acciones completadas (incluye accesos reentrantes)
+  int acquisitions;    // Adquisiciones reales de la primitiva
+  int timeouts;        // Acciones descartadas por superar timeoutMs
+  double totalAcquireUs;
+  double maxAcquireUs;
+  long voluntarySwitches;
+  long involuntarySwitches;
+} ProcessThread;
+
+// Suma microsegundos a un instante
+static struct timespec addMicroseconds(struct timespec t, long us)
+{
+  t.tv_sec += us / 1000000;
+  t.tv_nsec += (us % 1000000) * 1000;
+  if (t.tv_nsec >= 1000000000L)
+  {
+    t.tv_sec++;
+    t.tv_nsec -= 1000000000L;
+  }
+  return t;
+}
+
+// Diferencia en microsegundos entre dos instantes
+static double elapsedMicroseconds(struct timespec from, struct timespec to)
+{
+  return (to.tv_sec - from.tv_sec) * 1e6 + (to.tv_nsec - from.tv_nsec) / 1e3;
+}
+
+// Duerme hasta un instante absoluto de CLOCK_MONOTONIC (retorna de inmediato si ya pasó)
+static void sleepUntil(struct timespec target)
+{
+  while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &target, NULL) == EINTR)
+    ;
+}
+
+// Adquiere la primitiva del recurso con límite de tiempo; 1 si se obtuvo, 0 si expiró
+static int acquireReal(ThreadedScenario *sc, int resIdx)
+{
+  struct timespec deadline;
+  clock_gettime(CLOCK_REALTIME, &deadline);
+  deadline = addMicroseconds(deadline, (long)sc->timeoutMs * 1000);
+
+  int rc;
+  if (sc->useMutex)
+  {
+    rc = pthread_mutex_timedlock(&sc->mutexes[resIdx], &deadline);
+  }
+  else
+  {
+    while ((rc = sem_timedwait(&sc->semaphores[resIdx], &deadline)) == -1 && errno == EINTR)
+      ;
+  }
+  return rc == 0;
+}
+
+static void releaseReal(ThreadedScenario *sc, int resIdx)
+{
+  if (sc->useMutex)
+    pthread_mutex_unlock(&sc->mutexes[resIdx]);
+  else
+    sem_post(&sc->semaphores[resIdx]);
+}
+
+/**
+ * Cuerpo de cada hilo: replica las acciones del proceso en tiempo real, midiendo la latencia
+ * de adquisición y los cambios de contexto del propio hilo.
+ */
+static void *processThreadMain(void *arg)
+{
+  ProcessThread *pt = (ProcessThread *)arg;
+  ThreadedScenario *sc = pt->scenario;
+  int held[MAX_PROCESSES] = {0};
+  struct rusage before, after;
+
+  getrusage(RUSAGE_THREAD, &before);
+
+  for (int k = 0; k < pt->actionCount; k++)
+  {
+    int r = pt->resourceIdx[k];
+    sleepUntil(addMicroseconds(sc->start, (long)pt->cycles[k] * sc->cycleUs));
+
+    struct timespec t0, t1;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    t1 = t0;
+
+    if (!held[r])
+    {
+      if (!acquireReal(sc, r))
+      {
+        pt->timeouts++;
+        continue;
+      }
+      clock_gettime(CLOCK_MONOTONIC, &t1);
+      held[r] = 1;
+
+      double latency = elapsedMicroseconds(t0, t1);
+      pt->totalAcquireUs += latency;
+      if (latency > pt->maxAcquireUs)
+        pt->maxAcquireUs = latency;
+      pt->acquisitions++;
+    }
+
+    // La sección crítica dura un ciclo
+    sleepUntil(addMicroseconds(t1, sc->cycleUs));
+    pt->accesses++;
+
+    // Liberar si la siguiente acción no es en el ciclo consecutivo (sin colas ni protocolo, siempre)
+    if (!sc->holdAcrossCycles || k + 1 >= pt->actionCount || pt->cycles[k + 1] != pt->cycles[k] + 1)
+    {
+      for (int res = 0; res < MAX_PROCESSES; res++)
+      {
+        if (held[res])
+        {
+          releaseReal(sc, res);
+          held[res] = 0;
+        }
+      }
+    }
+  }
+
+  for (int res = 0; res < MAX_PROCESSES; res++)
+  {
+    if (held[res])
+      releaseReal(sc, res);
+  }
+
+  getrusage(RUSAGE_THREAD, &after);
+  pt->voluntarySwitches = after.ru_nvcsw - before.ru_nvcsw;
+  pt->involuntarySwitches = after.ru_nivcsw - before.ru_nivcsw;
+  return NULL;
+}
+
+int runThreadedSynchronization(const Process *processes, int processCount,
+                               const Resource *resources, int resourceCount,
+                               const Action *actions, int actionCount,
+                               const SyncConfig *config, const Process *simulated)
+{
+  static ThreadedScenario scenario;
+  static ProcessThread threads[MAX_PROCESSES];
+  pthread_t handles[MAX_PROCESSES];
+  int created = 0;
+
+  scenario.useMutex = config->useMutex;
+  scenario.cycleUs = config->cycleUs > 0 ? config->cycleUs : 1000;
+  scenario.timeoutMs = config->timeoutMs > 0 ? config->timeoutMs : 2000;
+  scenario.holdAcrossCycles = config->priorityQueue || config->protocol != PROTOCOL_NONE;
+
+  for (int r = 0; r < resourceCount; r++)
+  {
+    if (config->useMutex)
+      pthread_mutex_init(&scenario.mutexes[r], NULL);
+    else if (sem_init(&scenario.semaphores[r], 0, resources[r].counter > 0 ? resources[r].counter : 0) != 0)
+      return -1;
+  }
+
+  // Repartir las acciones de cada proceso ordenadas por ciclo (orden estable del archivo)
+  for (int i = 0; i < processCount; i++)
+  {
+    ProcessThread *pt = &threads[i];
+    memset(pt, 0, sizeof(ProcessThread));
+    pt->scenario = &scenario;
+
+    pt->actionCount = collectProcessActions(processes[i].pid, resources, resourceCount, actions, actionCount,
+                                            pt->cycles, pt->resourceIdx);
+  }
+
+  // Dar margen para crear todos los hilos antes del ciclo 0
+  clock_gettime(CLOCK_MONOTONIC, &scenario.start);
+  scenario.start = addMicroseconds(scenario.start, 10000);
+
+  for (int i = 0; i < processCount; i++)
+  {
+    if (pthread_create(&handles[i], NULL, processThreadMain, &threads[i]) != 0)
+      break;
+    created++;
+  }
+
+  for (int i = 0; i < created; i++)
+    pthread_join(handles[i], NULL);
+
+  struct timespec end;
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  double elapsedUs = elapsedMicroseconds(scenario.start, end);
+
+  for (int r = 0; r < resourceCount; r++)
+  {
+    if (config->useMutex)
+      pthread_mutex_destroy(&scenario.mutexes[r]);
+    else
+      sem_destroy(&scenario.semaphores[r]);
+  }
+
+  if (created < processCount)
+  {
+    fprintf(stderr, "No se pudieron crear los hilos de la reproducción (%d/%d).\n", created, processCount);
+    return -1;
+  }
+
+  // Métricas por hilo junto al tiempo de espera simulado del mismo proceso
+  int totalAccesses = 0, totalAcquisitions = 0, totalTimeouts = 0;
+  long totalSwitches = 0;
+  double totalAcquireUs = 0.0;
+  for (int i = 0; i < processCount; i++)
+  {
+    ProcessThread *pt = &threads[i];
+    totalAccesses += pt->accesses;
+    totalAcquisitions += pt->acquisitions;
+    totalTimeouts += pt->timeouts;
+    totalAcquireUs += pt->totalAcquireUs;
+    totalSwitches += pt->voluntarySwitches + pt->involuntarySwitches;
+
+    char line[320];
+    snprintf(line, sizeof(line),
+             "{\"event\": \"THREAD_METRIC\", \"pid\": \"%s\", \"accesses\": %d, \"timeouts\": %d, "
+             "\"avgAcquireUs\": %.2f, \"maxAcquireUs\": %.2f, \"voluntarySwitches\": %ld, "
+             "\"involuntarySwitches\": %ld, \"simulatedWaitingTime\": %d}",
+             processes[i].pid, pt->accesses, pt->timeouts,
+             pt->acquisitions > 0 ? pt->totalAcquireUs / pt->acquisitions : 0.0,
+             pt->maxAcquireUs, pt->voluntarySwitches, pt->involuntarySwitches,
+             simulated ? simulated[i].waitingTime : -1);
+    emitEventLine(line, -1);
+  }
+
+  char summary[320];
+  snprintf(summary, sizeof(summary),
+           "{\"type\": \"threads_metrics\", \"mechanism\": \"%s\", \"threads\": %d, \"cycleUs\": %d, "
+           "\"elapsedMs\": %.2f, \"throughput\": %.2f, \"avgAcquireUs\": %.2f, \"timeouts\": %d, "
+           "\"contextSwitches\": %ld}",
+           config->useMutex ? "mutex" : "semaphore", processCount, scenario.cycleUs,
+           elapsedUs / 1000.0, elapsedUs > 0 ? totalAccesses / (elapsedUs / 1e6) : 0.0,
+           totalAcquisitions > 0 ? totalAcquireUs / totalAcquisitions : 0.0,
+           totalTimeouts, totalSwitches);
+  flushCycleFrame();
+  printSummaryLine(summary);
+  return 0;
+}
@@ -1,10 +1,13 @@
 #include "synchronization.h"
 #include "sync_mutex.h"
 #include "sync_semaphore.h"
+#include "sync_shards.h"
+#include "telemetry.h"
 #include <string.h>
 #include <stdio.h>
 #include <stdbool.h>
 #include <unistd.h>
+#include <limits.h>
 
 // Inicializa recursos con valores desbloqueados
 void initializeResources(Resource *resources, int resourceCount)
@@ -15,13 +18,320 @@ void initializeResources(Resource *resources, int resourceCount)
   }
 }
 
+// Busca el índice de un recurso por nombre (-1 si no existe)
+static int findResourceIndex(const Resource *resources, int resourceCount, const char *name)
+{
+  for (int k = 0; k < resourceCount; k++)
+  {
+    if (strcmp(resources[k].name, name) == 0)
+      return k;
+  }
+  return -1;
+}
+
+int collectProcessActions(const char *pid, const Resource *resources, int resourceCount,
+                          const Action *actions, int actionCount, int *cycles, int *resourceIdx)
+{
+  int count = 0;
+  for (int j = 0; j < actionCount && count < MAX_EVENTS; j++)
+  {
+    if (strcmp(actions[j].pid, pid) != 0)
+      continue;
+
+    int resIdx = findResourceIndex(resources, resourceCount, actions[j].resourceName);
+    if (resIdx == -1)
+      continue;
+
+    // Inserción estable: las acciones del mismo ciclo conservan el orden del archivo
+    int pos = count++;
+    while (pos > 0 && cycles[pos - 1] > actions[j].cycle)
+    {
+      cycles[pos] = cycles[pos - 1];
+      resourceIdx[pos] = resourceIdx[pos - 1];
+      pos--;
+    }
+    cycles[pos] = actions[j].cycle;
+    resourceIdx[pos] = resIdx;
+  }
+  return count;
+}
+
+// Busca el índice de un proceso por PID (-1 si no existe)
+static int findProcessIndex(Process *processes, int processCount, const char *pid)
+{
+  for (int i = 0; i < processCount; i++)
+  {
+    if (strcmp(processes[i].pid, pid) == 0)
+      return i;
+  }
+  return -1;
+}
+
+/**
+ * Inicializa el estado compartido de sincronización: resuelve el proceso y recurso de cada
+ * acción (las que no tienen proceso o recurso válido se ignoran), calcula el techo de
+ * prioridad de cada recurso y deja todos los recursos libres.
+ */
+void initializeSyncState(SyncState *s, Process *processes, int processCount,
+                         Resource *resources, int resourceCount,
+                         Action *actions, int actionCount,
+                         SyncConfig *config)
+{
+  memset(s, 0, sizeof(SyncState));
+  s->processes = processes;
+  s->processCount = processCount;
+  s->resources = resources;
+  s->resourceCount = resourceCount;
+  s->actions = actions;
+  s->actionCount = actionCount;
+  s->config = config;
+
+  for (int i = 0; i < processCount; i++)
+  {
+    s->blockedOn[i] = -1;
+    s->effectivePriority[i] = processes[i].priority;
+  }
+
+  for (int r = 0; r < resourceCount; r++)
+    s->resourceCeiling[r] = INT_MAX;
+
+  for (int j = 0; j < actionCount; j++)
+  {
+    s->actionOwner[j] = findProcessIndex(processes, processCount, actions[j].pid);
+    s->actionResource[j] = findResourceIndex(resources, resourceCount, actions[j].resourceName);
+    if (s->actionOwner[j] == -1 || s->actionResource[j] == -1)
+    {
+      s->actionProcessed[j] = true;
+      continue;
+    }
+
+    int ownerPriority = processes[s->actionOwner[j]].priority;
+    if (ownerPriority < s->resourceCeiling[s->actionResource[j]])
+      s->resourceCeiling[s->actionResource[j]] = ownerPriority;
+  }
+
+  initializeResources(resources, resourceCount);
+}
+
+/**
+ * Busca la siguiente acción del proceso que puede ejecutarse en el ciclo dado.
+ *
+ * Sin colas por prioridad solo se considera la acción programada exactamente en `cycle`
+ * (la primera en orden de archivo). Con colas por prioridad, una acción que no pudo
+ * ejecutarse sigue pendiente, por lo que se toma la más antigua con `cycle` menor o igual.
+ *
+ * @return Índice de la acción o -1 si no hay ninguna lista.
+ */
+int findNextAction(const SyncState *s, int processIdx, int cycle)
+{
+  int next = -1;
+  for (int j = 0; j < s->actionCount; j++)
+  {
+    if (s->actionProcessed[j] || s->actionOwner[j] != processIdx)
+      continue;
+
+    if (!s->config->priorityQueue)
+    {
+      if (s->actions[j].cycle == cycle)
+        return j;
+    }
+    else if (s->actions[j].cycle <= cycle &&
+             (next == -1 || s->actions[j].cycle < s->actions[next].cycle))
+    {
+      next = j;
+    }
+  }
+  return next;
+}
+
+// Indica si el proceso aún tiene acciones sin procesar
+bool hasPendingActions(const SyncState *s, int processIdx)
+{
+  for (int j = 0; j < s->actionCount; j++)
+  {
+    if (!s->actionProcessed[j] && s->actionOwner[j] == processIdx)
+      return true;
+  }
+  return false;
+}
+
+// Libera todos los recursos retenidos por un proceso, devuelve cuántos liberó
+int releaseHeldResources(SyncState *s, int processIdx)
+{
+  int released = 0;
+  for (int r = 0; r < s->resourceCount; r++)
+  {
+    if (s->holds[processIdx][r])
+    {
+      if (s->config->useMutex)
+        releaseMutex(&s->resources[r]);
+      else
+        releaseSemaphore(&s->resources[r]);
+      s->holds[processIdx][r] = false;
+      released++;
+    }
+  }
+  return released;
+}
+
+/**
+ * Devuelve el recurso con el techo de prioridad más alto (valor menor) retenido por
+ * un proceso distinto a `processIdx`, o -1 si ningún otro proceso retiene recursos.
+ */
+static int findSystemCeilingResource(const SyncState *s, int processIdx)
+{
+  int best = -1;
+  for (int r = 0; r < s->resourceCount; r++)
+  {
+    for (int h = 0; h < s->processCount; h++)
+    {
+      if (h != processIdx && s->holds[h][r] &&
+          (best == -1 || s->resourceCeiling[r] < s->resourceCeiling[best]))
+      {
+        best = r;
+        break;
+      }
+    }
+  }
+  return best;
+}
+
+// Indica si algún poseedor del recurso tiene menor prioridad base que el proceso en espera
+bool isPriorityInverted(const SyncState *s, int waiterIdx, int resIdx)
+{
+  for (int h = 0; h < s->processCount; h++)
+  {
+    if (h != waiterIdx && s->holds[h][resIdx] &&
+        s->processes[h].priority > s->processes[waiterIdx].priority)
+      return true;
+  }
+  return false;
+}
+
+/**
+ * Recalcula las prioridades efectivas según el protocolo configurado.
+ * Cada poseedor de un recurso hereda la prioridad del proceso más prioritario que lo espera,
+ * de forma transitiva para cadenas de bloqueo.
+ */
+void updateEffectivePriorities(SyncState *s)
+{
+  for (int i = 0; i < s->processCount; i++)
+    s->effectivePriority[i] = s->processes[i].priority;
+
+  if (s->config->protocol == PROTOCOL_NONE)
+    return;
+
+  bool changed = true;
+  for (int round = 0; changed && round < s->processCount; round++)
+  {
+    changed = false;
+    for (int w = 0; w < s->processCount; w++)
+    {
+      int r = s->blockedOn[w];
+      if (r == -1)
+        continue;
+
+      for (int h = 0; h < s->processCount; h++)
+      {
+        if (h != w && s->holds[h][r] && s->effectivePriority[w] < s->effectivePriority[h])
+        {
+          s->effectivePriority[h] = s->effectivePriority[w];
+          changed = true;
+        }
+      }
+    }
+  }
+}
+
+/**
+ * Intenta conceder el recurso de una acción al proceso.
+ * Si el proceso ya retiene el recurso, el acceso es reentrante. Con el protocolo de techo,
+ * el proceso solo puede tomar un recurso libre si su prioridad supera el techo del sistema.
+ *
+ * @param blockingRes Recurso que bloquea al proceso si no se concede el acceso.
+ * @return 1 si se concedió el acceso, 0 en caso contrario.
+ */
+int grantResource(SyncState *s, int processIdx, int resIdx, int *blockingRes)
+{
+  *blockingRes = resIdx;
+
+  if (s->holds[processIdx][resIdx])
+    return 1;
+
+  if (s->config->protocol == PROTOCOL_CEILING)
+  {
+    int ceilingRes = findSystemCeilingResource(s, processIdx);
+    if (ceilingRes != -1 && s->effectivePriority[processIdx] >= s->resourceCeiling[ceilingRes])
+    {
+      *blockingRes = ceilingRes;
+      return 0;
+    }
+  }
+
+  Resource *r = &s->resources[resIdx];
+  int acquired = s->config->useMutex ? acquireMutex(r) : acquireSemaphore(r);
+  if (acquired)
+    s->holds[processIdx][resIdx] = true;
+  return acquired;
+}
+
+void sampleResourceTelemetry(const SyncState *s, const int *waitingOn, int cycle)
+{
+  if (!telemetryActive() || isOutputMuted())
+    return;
+
+  for (int r = 0; r < s->resourceCount; r++)
+  {
+    int holders = 0, waiters = 0;
+    for (int p = 0; p < s->processCount; p++)
+    {
+      holders += s->holds[p][r];
+      waiters += waitingOn[p] == r;
+    }
+    telemetryResourceSample(cycle, r, holders, waiters);
+  }
+}
+
+// Exporta las métricas del proceso finalizado (y de inversión si se usan colas por prioridad)
+static void exportSyncProcessMetrics(const SyncState *s, int processIdx, int originalBT)
+{
+  exportProcessMetricWithOriginalBT(&s->processes[processIdx], originalBT);
+  if (s->config->priorityQueue)
+  {
+    exportInversionMetric(&s->processes[processIdx],
+                          s->inversionTime[processIdx],
+                          s->longestInversion[processIdx]);
+  }
+}
+
+int addSyncStateRegions(SyncState *s, CheckpointRegion *regions)
+{
+  // Los punteros y los arreglos derivados de la carga (dueño y recurso de cada acción, techos)
+  // no cambian durante la simulación
+  int n = 0;
+  regions[n++] = (CheckpointRegion){s->actionProcessed, sizeof(bool) * s->actionCount};
+  regions[n++] = (CheckpointRegion){s->holds, sizeof(s->holds)};
+  regions[n++] = (CheckpointRegion){s->blockedOn, sizeof(int) * s->processCount};
+  regions[n++] = (CheckpointRegion){s->effectivePriority, sizeof(int) * s->processCount};
+  regions[n++] = (CheckpointRegion){s->inversionTime, sizeof(int) * s->processCount};
+  regions[n++] = (CheckpointRegion){s->inversionStreak, sizeof(int) * s->processCount};
+  regions[n++] = (CheckpointRegion){s->longestInversion, sizeof(int) * s->processCount};
+  regions[n++] = (CheckpointRegion){s->resources, sizeof(Resource) * s->resourceCount};
+  regions[n++] = (CheckpointRegion){s->processes, sizeof(Process) * s->processCount};
+  return n;
+}
+
 // Función principal que simula la sincronización con mutex o semáforo
 void simulateSynchronization(Process *processes, int processCount,
                              Resource *resources, int resourceCount,
                              Action *actions, int actionCount,
                              TimelineEvent *events, int *eventCount,
-                             int useMutex)
+                             SyncConfig *config)
 {
+  static SyncState state;
+  SyncState *s = &state;
+  initializeSyncState(s, processes, processCount, resources, resourceCount, actions, actionCount, config);
+
   int currentCycle = 0;
   int completed = 0;
   *eventCount = 0;
@@ -32,9 +342,13 @@ void simulateSynchronization(Process *processes, int processCount,
   int firstActionCycle[MAX_PROCESSES];   // Primer ciclo donde proceso realizó acción
   int lastActionCycle[MAX_PROCESSES];    // Último ciclo con acción realizada
   bool started[MAX_PROCESSES] = {false}; // Marca si proceso inició ejecución
-  bool resourceUsedThisCycle[COMMON_MAX_LEN] = {false};
   int originalBurstTimes[MAX_PROCESSES];
-  bool actionProcessed[COMMON_MAX_LEN] = {false};
+  int order[MAX_PROCESSES]; // Orden de atención de los procesos en el ciclo
+  int ready[MAX_PROCESSES]; // Acción lista de cada proceso en el ciclo (-1 si no tiene)
+  bool granted[MAX_PROCESSES]; // Resultado de la concesión repartida en shards
+
+  // Con varios shards, los recursos se reparten entre hilos al conceder accesos
+  int shardCount = startSyncShards(s, config->shards);
 
   // Inicializar arrays para control de ciclos y burst times originales
   for (int i = 0; i < processCount; i++)
@@ -44,13 +358,32 @@ void simulateSynchronization(Process *processes, int processCount,
     originalBurstTimes[i] = processes[i].burstTime;
   }
 
-  // Inicializar estado de los recursos
-  initializeResources(resources, resourceCount);
+  // Estado del bucle principal para los snapshots (seek)
+  CheckpointRegion loopRegions[] = {
+      {&currentCycle, sizeof(currentCycle)},
+      {&completed, sizeof(completed)},
+      {newPrinted, sizeof(bool) * processCount},
+      {waitingCounters, sizeof(int) * processCount},
+      {firstActionCycle, sizeof(int) * processCount},
+      {lastActionCycle, sizeof(int) * processCount},
+      {started, sizeof(bool) * processCount},
+  };
+  CheckpointRegion regions[CHECKPOINT_REGION_COUNT(loopRegions) + SYNC_STATE_REGIONS];
+  int regionCount = CHECKPOINT_REGION_COUNT(loopRegions);
+  memcpy(regions, loopRegions, sizeof(loopRegions));
+  regionCount += addSyncStateRegions(s, regions + regionCount);
+  restoreCheckpoint(regions, regionCount);
 
   // Bucle principal de simulación, avanza ciclo por ciclo hasta completar todos los procesos
   while (completed < processCount)
   {
+    checkpointCycle(currentCycle, regions, regionCount, processes, processCount);
+
     int progressMade = 0; // Marca si se hizo progreso en este ciclo
+    bool invertedThisCycle[MAX_PROCESSES] = {false};
+    int waitingOn[MAX_PROCESSES]; // Recurso por el que esperó cada proceso en este ciclo (-1: ninguno)
+    for (int i = 0; i < processCount; i++)
+      waitingOn[i] = -1;
 
     // Detectar procesos que llegan en el ciclo actual y mostrar estado NEW
     for (int i = 0; i < processCount; i++)
@@ -62,83 +395,116 @@ void simulateSynchronization(Process *processes, int processCount,
       }
     }
 
-    // Resetear marcas de recursos usados en este ciclo
-    memset(resourceUsedThisCycle, 0, sizeof(bool) * resourceCount);
-
+    // Determinar el orden de atención: orden del arreglo o por prioridad efectiva (estable)
+    int orderCount = 0;
     for (int i = 0; i < processCount; i++)
     {
-      // Saltar procesos terminados o que aún no llegaron
-      if (processes[i].state == STATE_TERMINATED || processes[i].arrivalTime > currentCycle)
+      // Saltar procesos terminados, omitidos o que aún no llegaron
+      ready[i] = -1;
+      if (processes[i].state == STATE_TERMINATED || processes[i].state == STATE_OMITED ||
+          processes[i].arrivalTime > currentCycle)
         continue;
 
-      for (int j = 0; j < actionCount; j++)
+      ready[i] = findNextAction(s, i, currentCycle);
+      if (ready[i] == -1)
+        continue;
+
+      int pos = orderCount++;
+      while (config->priorityQueue && pos > 0 &&
+             s->effectivePriority[order[pos - 1]] > s->effectivePriority[i])
       {
-        Action *a = &actions[j];
+        order[pos] = order[pos - 1];
+        pos--;
+      }
+      order[pos] = i;
+    }
+
+    if (shardCount > 1)
+      grantActionsSharded(s, order, ready, orderCount, granted);
+
+    // Registrar los resultados en el orden de atención (idéntico al modo secuencial)
+    for (int k = 0; k < orderCount; k++)
+    {
+      int i = order[k];
+      int j = ready[i];
+      Action *a = &actions[j];
+      int blockingRes = s->actionResource[j];
+      bool ok = shardCount > 1 ? granted[k] : grantResource(s, i, s->actionResource[j], &blockingRes);
 
-        // Saltar acciones ya procesadas o que no corresponden al proceso o ciclo actual
-        if (actionProcessed[j] || strcmp(a->pid, processes[i].pid) != 0 || a->cycle != currentCycle)
-          continue;
+      if (ok)
+      {
+        // registrar evento de acceso
+        printEventForSyncProcess(&processes[i], currentCycle, STATE_ACCESSED, events, eventCount, a->action);
+        processes[i].burstTime--;
+        progressMade++;
+        s->blockedOn[i] = -1;
 
-        int resIndex = -1;
-        for (int k = 0; k < resourceCount; k++)
+        // Registrar primer ciclo y último ciclo de acción para métricas
+        if (!started[i])
         {
-          if (strcmp(resources[k].name, a->resourceName) == 0)
-          {
-            resIndex = k;
-            break;
-          }
+          firstActionCycle[i] = currentCycle;
+          started[i] = true;
         }
-        if (resIndex == -1)
-          continue;
+        lastActionCycle[i] = currentCycle;
 
-        Resource *r = &resources[resIndex];
-        int sync_mth = useMutex ? acquireMutex(r) : acquireSemaphore(r);
+        s->actionProcessed[j] = true;
+      }
+      else
+      {
+        // No pudo adquirir recurso = WAITING
+        waitingCounters[i]++;
+        waitingOn[i] = blockingRes;
+        printEventForSyncProcess(&processes[i], currentCycle, STATE_WAITING, events, eventCount, a->action);
 
-        if (sync_mth)
+        if (config->priorityQueue)
         {
-          // marcar uso y registrar evento
-          resourceUsedThisCycle[resIndex] = true;
-          printEventForSyncProcess(&processes[i], currentCycle, STATE_ACCESSED, events, eventCount, a->action);
-          processes[i].burstTime--;
-          progressMade++;
-
-          // Registrar primer ciclo y último ciclo de acción para métricas
-          if (!started[i])
-          {
-            firstActionCycle[i] = currentCycle;
-            started[i] = true;
-          }
-          lastActionCycle[i] = currentCycle;
+          // La acción permanece en la cola de espera del recurso
+          s->blockedOn[i] = blockingRes;
+          invertedThisCycle[i] = isPriorityInverted(s, i, blockingRes);
         }
         else
         {
-          // No pudo adquirir recurso = WAITING
-          waitingCounters[i]++;
-          printEventForSyncProcess(&processes[i], currentCycle, STATE_WAITING, events, eventCount, a->action);
+          // Sin colas de espera la acción fallida se descarta
+          s->actionProcessed[j] = true;
         }
-
-        // Marcar acción como procesada
-        actionProcessed[j] = true;
-        break;
       }
     }
 
-    // Liberar recursos usados en este ciclo
-    for (int i = 0; i < resourceCount; i++)
+    // Actualizar métricas de inversión y prioridades efectivas
+    for (int i = 0; i < processCount; i++)
     {
-      if (resourceUsedThisCycle[i])
+      if (invertedThisCycle[i])
       {
-        if (useMutex)
-          releaseMutex(&resources[i]);
-        else
-          releaseSemaphore(&resources[i]);
+        s->inversionTime[i]++;
+        s->inversionStreak[i]++;
+        if (s->inversionStreak[i] > s->longestInversion[i])
+          s->longestInversion[i] = s->inversionStreak[i];
+      }
+      else
+      {
+        s->inversionStreak[i] = 0;
       }
     }
+    updateEffectivePriorities(s);
+    sampleResourceTelemetry(s, waitingOn, currentCycle);
+
+    // Liberar recursos de procesos que no continúan su sección crítica en el siguiente ciclo. Sin
+    // colas ni protocolo los recursos se liberan todos los ciclos, como en el modo original.
+    bool holdAcrossCycles = config->priorityQueue || config->protocol != PROTOCOL_NONE;
+    int releasedCount = 0;
+    for (int i = 0; i < processCount; i++)
+    {
+      bool continues = holdAcrossCycles && processes[i].burstTime > 0 &&
+                       (s->blockedOn[i] != -1 || findNextAction(s, i, currentCycle + 1) != -1);
+      if (!continues)
+        releasedCount += releaseHeldResources(s, i);
+    }
 
     // Verificar procesos terminados (burstTime == 0)
     for (int i = 0; i < processCount; i++)
     {
-      if (processes[i].state != STATE_TERMINATED && processes[i].burstTime == 0)
+      if (processes[i].state != STATE_TERMINATED && processes[i].state != STATE_OMITED &&
+          processes[i].burstTime == 0)
       {
         processes[i].state = STATE_TERMINATED;
         processes[i].waitingTime = waitingCounters[i];
@@ -146,22 +512,29 @@ void simulateSynchronization(Process *processes, int processCount,
         processes[i].finishTime = lastActionCycle[i] + 1;
 
         printEventForSyncProcess(&processes[i], currentCycle, STATE_TERMINATED, events, eventCount, ACTION_NONE);
-        exportProcessMetricWithOriginalBT(&processes[i], originalBurstTimes[i]);
+        exportSyncProcessMetrics(s, i, originalBurstTimes[i]);
         completed++;
       }
     }
 
     // no hay progreso y hay procesos esperando
     bool waitingFound = false;
+    bool runnablePending = false;
     for (int i = 0; i < processCount; i++)
     {
-      if (processes[i].state != STATE_TERMINATED && waitingCounters[i] > 0)
-      {
+      if (processes[i].state == STATE_TERMINATED || processes[i].state == STATE_OMITED)
+        continue;
+
+      if (config->priorityQueue ? s->blockedOn[i] != -1 : waitingCounters[i] > 0)
         waitingFound = true;
-        break;
-      }
+      else if (config->priorityQueue && hasPendingActions(s, i))
+        runnablePending = true;
     }
 
+    // Con colas de espera solo hay bloqueo si nadie más puede liberar los recursos retenidos
+    if (config->priorityQueue && (runnablePending || releasedCount > 0))
+      waitingFound = false;
+
     if (waitingFound && progressMade == 0)
     {
       fprintf(stderr, "\nDeadlock o bloqueo detectado: procesos en WAITING sin progreso. Omitiendo procesos bloqueados.\n");
@@ -169,7 +542,8 @@ void simulateSynchronization(Process *processes, int processCount,
       // Finalizar procesos bloqueados con estado OMITED
       for (int i = 0; i < processCount; i++)
       {
-        if (processes[i].state != STATE_TERMINATED && waitingCounters[i] > 0)
+        bool blocked = config->priorityQueue ? s->blockedOn[i] != -1 : waitingCounters[i] > 0;
+        if (processes[i].state != STATE_TERMINATED && processes[i].state != STATE_OMITED && blocked)
         {
           if (processes[i].burstTime > 0)
           {
@@ -182,9 +556,11 @@ void simulateSynchronization(Process *processes, int processCount,
           processes[i].waitingTime = waitingCounters[i];
           processes[i].startTime = started[i] ? firstActionCycle[i] : -1;
           processes[i].finishTime = currentCycle;
+          s->blockedOn[i] = -1;
+          releaseHeldResources(s, i);
 
           printEventForSyncProcess(&processes[i], currentCycle, processes[i].state, events, eventCount, ACTION_NONE);
-          exportProcessMetricWithOriginalBT(&processes[i], originalBurstTimes[i]);
+          exportSyncProcessMetrics(s, i, originalBurstTimes[i]);
           completed++;
         }
       }
@@ -196,27 +572,17 @@ void simulateSynchronization(Process *processes, int processCount,
     {
       if (processes[i].state != STATE_TERMINATED && processes[i].state != STATE_OMITED)
       {
-        // Revisar si el proceso tiene acciones pendientes
-        bool hasPendingAction = false;
-        for (int j = 0; j < actionCount; j++)
-        {
-          if (!actionProcessed[j] && strcmp(actions[j].pid, processes[i].pid) == 0)
-          {
-            hasPendingAction = true;
-            break;
-          }
-        }
-
         // Si no hay acciones pendientes y el proceso aún no terminó, omitirlo
-        if (!hasPendingAction)
+        if (!hasPendingActions(s, i))
         {
           processes[i].state = STATE_OMITED;
           processes[i].waitingTime = waitingCounters[i];
           processes[i].startTime = started[i] ? firstActionCycle[i] : -1;
           processes[i].finishTime = currentCycle;
+          releaseHeldResources(s, i);
 
           printEventForSyncProcess(&processes[i], currentCycle, processes[i].state, events, eventCount, ACTION_NONE);
-          exportProcessMetricWithOriginalBT(&processes[i], originalBurstTimes[i]);
+          exportSyncProcessMetrics(s, i, originalBurstTimes[i]);
           completed++;
         }
       }
@@ -235,25 +601,40 @@ void simulateSynchronization(Process *processes, int processCount,
     bool pendingActions = false;
     for (int j = 0; j < actionCount; j++)
     {
-      if (!actionProcessed[j])
+      if (!s->actionProcessed[j])
       {
         pendingActions = true;
         break;
       }
     }
 
+    // Todos los procesos terminados u omitidos y sin acciones pendientes
     if (allDone && !pendingActions)
-    {
-      fprintf(stderr, "[DEBUG] Todos los procesos terminados u omitidos y sin acciones pendientes. Finalizando simulación.\n");
       break;
-    }
 
     currentCycle++;
-    usleep(SIMULATION_DELAY_US);
+    endSimulationCycle();
   }
 
+  finishCheckpoints(currentCycle);
+  stopSyncShards();
+  flushCycleFrame();
+
   // Calcular métricas de la simulación
   SimulationMetrics metrics = calculateMetrics(processes, processCount);
-  printf("{\"type\": \"metrics\", \"Average Waiting Time\": %.2f}\n", metrics.avgWaitingTime);
-  exportSimulationEnd();
+  char line[160];
+  if (config->priorityQueue)
+  {
+    int totalInversion = 0;
+    for (int i = 0; i < processCount; i++)
+      totalInversion += s->inversionTime[i];
+
+    snprintf(line, sizeof(line), "{\"type\": \"metrics\", \"Average Waiting Time\": %.2f, \"Average Inversion Time\": %.2f}",
+             metrics.avgWaitingTime, processCount > 0 ? (float)totalInversion / processCount : 0.0f);
+  }
+  else
+  {
+    snprintf(line, sizeof(line), "{\"type\": \"metrics\", \"Average Waiting Time\": %.2f}", metrics.avgWaitingTime);
+  }
+  printSummaryLine(line);
 }
@@ -0,0 +1,209 @@
+#include "telemetry.h"
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * Acumulado de un recurso en la ventana en curso
+ */
+typedef struct
+{
+  long holders; // Suma por ciclo de procesos que lo retienen
+  int busy;     // Ciclos retenido por al menos un proceso
+  long waiters; // Suma por ciclo de procesos que esperan por él
+} ResourceWindow;
+
+static struct
+{
+  int window;
+  const Process *processes;
+  int processCount;
+  const Resource *resources;
+  int resourceCount;
+
+  // Último estado registrado de cada proceso y el ciclo al que corresponde
+  int stateCycle[MAX_PROCESSES];
+  ProcessState state[MAX_PROCESSES];
+  ActionType action[MAX_PROCESSES];
+
+  int cycle; // Ciclo en curso (-1 antes del primer evento)
+  int windowStart;
+
+  // Acumulados de la ventana en curso
+  long ready;
+  long running;
+  long blocked;
+  int readyMax;
+  int busyCycles;
+  int arrivals;
+  int completions;
+  ResourceWindow resourceWindow[MAX_PROCESSES];
+} telemetry;
+
+void configureTelemetry(int window, const Process *processes, int processCount,
+                        const Resource *resources, int resourceCount)
+{
+  memset(&telemetry, 0, sizeof(telemetry));
+  telemetry.window = window > 0 ? window : 0;
+  telemetry.processes = processes;
+  telemetry.processCount = processCount;
+  telemetry.resources = resources;
+  telemetry.resourceCount = resources ? resourceCount : 0;
+  telemetry.cycle = -1;
+  for (int i = 0; i < processCount; i++)
+    telemetry.stateCycle[i] = -1;
+}
+
+int telemetryActive(void)
+{
+  return telemetry.window > 0;
+}
+
+// Suma a la ventana el estado de los procesos en el ciclo en curso
+static void closeCycle(void)
+{
+  int ready = 0, running = 0, blocked = 0;
+  for (int i = 0; i < telemetry.processCount; i++)
+  {
+    if (telemetry.stateCycle[i] != telemetry.cycle)
+      continue;
+
+    if (telemetry.state[i] == STATE_ACCESSED || telemetry.state[i] == STATE_SWITCHING)
+      running++; // El cambio de contexto también ocupa la CPU
+    else if (telemetry.state[i] == STATE_IO || telemetry.state[i] == STATE_IO_WAITING)
+      blocked++; // En un dispositivo o en su cola
+    else if (telemetry.action[i] == ACTION_NONE)
+      ready++; // Espera por CPU
+    else
+      blocked++; // Espera por un recurso
+  }
+
+  telemetry.ready += ready;
+  telemetry.running += running;
+  telemetry.blocked += blocked;
+  if (ready > telemetry.readyMax)
+    telemetry.readyMax = ready;
+  if (running > 0)
+    telemetry.busyCycles++;
+}
+
+// Emite la ventana [start, end) y reinicia los acumulados
+static void emitWindow(int start, int end)
+{
+  static char line[256 + MAX_PROCESSES * 112];
+  double length = end - start;
+  int n = snprintf(line, sizeof(line),
+                   "{\"event\": \"TELEMETRY\", \"startCycle\": %d, \"endCycle\": %d, "
+                   "\"readyQueue\": %.2f, \"readyQueueMax\": %d, \"running\": %.2f, \"waiting\": %.2f, "
+                   "\"cpuBusy\": %.2f, \"arrivals\": %d, \"completions\": %d",
+                   start, end,
+                   telemetry.ready / length, telemetry.readyMax, telemetry.running / length,
+                   (telemetry.ready + telemetry.blocked) / length,
+                   telemetry.busyCycles / length, telemetry.arrivals, telemetry.completions);
+
+  if (telemetry.resourceCount > 0)
+  {
+    n += snprintf(line + n, sizeof(line) - n, ", \"blocked\": %.2f, \"resources\": [", telemetry.blocked / length);
+    for (int r = 0; r < telemetry.resourceCount; r++)
+    {
+      const ResourceWindow *w = &telemetry.resourceWindow[r];
+      n += snprintf(line + n, sizeof(line) - n,
+                    "%s{\"name\": \"%s\", \"occupancy\": %.2f, \"busy\": %.2f, \"waiters\": %.2f}",
+                    r ? ", " : "", telemetry.resources[r].name,
+                    w->holders / length, w->busy / length, w->waiters / length);
+    }
+    n += snprintf(line + n, sizeof(line) - n, "]");
+  }
+  snprintf(line + n, sizeof(line) - n, "}");
+  emitEventLine(line, -1);
+
+  telemetry.ready = telemetry.running = telemetry.blocked = 0;
+  telemetry.readyMax = telemetry.busyCycles = 0;
+  telemetry.arrivals = telemetry.completions = 0;
+  memset(telemetry.resourceWindow, 0, sizeof(telemetry.resourceWindow));
+}
+
+// Cierra el ciclo en curso y emite las ventanas que terminan antes de `cycle`
+static void advanceTo(int cycle)
+{
+  if (telemetry.cycle < 0)
+  {
+    // Las ventanas se alinean a múltiplos de `window` (con seek la primera queda incompleta)
+    telemetry.windowStart = cycle - cycle % telemetry.window;
+    telemetry.cycle = cycle;
+    return;
+  }
+
+  closeCycle();
+  while (cycle >= telemetry.windowStart + telemetry.window)
+  {
+    emitWindow(telemetry.windowStart, telemetry.windowStart + telemetry.window);
+    telemetry.windowStart += telemetry.window;
+  }
+  telemetry.cycle = cycle;
+}
+
+void telemetryProcessEvent(const Process *process, int cycle, ProcessState state, ActionType action)
+{
+  if (!telemetry.window || process < telemetry.processes ||
+      process >= telemetry.processes + telemetry.processCount)
+    return;
+
+  if (cycle > telemetry.cycle)
+    advanceTo(cycle);
+
+  int i = (int)(process - telemetry.processes);
+  switch (state)
+  {
+  case STATE_NEW:
+    telemetry.arrivals++;
+    break;
+  case STATE_TERMINATED:
+    telemetry.completions++;
+    break;
+  case STATE_WAITING:
+  case STATE_ACCESSED:
+  case STATE_SWITCHING:
+  case STATE_IO:
+  case STATE_IO_WAITING:
+    // En un mismo ciclo prevalece el último estado registrado
+    if (cycle == telemetry.cycle)
+    {
+      telemetry.stateCycle[i] = cycle;
+      telemetry.state[i] = state;
+      telemetry.action[i] = action;
+    }
+    break;
+  default:
+    break;
+  }
+}
+
+void telemetryResourceSample(int cycle, int resource, int holders, int waiters)
+{
+  if (!telemetry.window || resource < 0 || resource >= telemetry.resourceCount)
+    return;
+
+  if (cycle > telemetry.cycle)
+    advanceTo(cycle);
+  if (cycle != telemetry.cycle)
+    return;
+
+  ResourceWindow *w = &telemetry.resourceWindow[resource];
+  w->holders += holders;
+  w->waiters += waiters;
+  if (holders > 0)
+    w->busy++;
+}
+
+void finishTelemetry(void)
+{
+  if (!telemetry.window)
+    return;
+
+  if (telemetry.cycle >= 0)
+  {
+    closeCycle();
+    emitWindow(telemetry.windowStart, telemetry.cycle + 1);
+  }
+  telemetry.window = 0;
+}
@@ -0,0 +1,313 @@
+#include "trace.h"
+#include <stdio.h>
+#include <string.h>
+
+#define TRACE_PID 1
+#define TRACE_BUFFER_SIZE (1 << 16)
+
+/**
+ * Estado de un track: el slice abierto (rango de ciclos consecutivos en el mismo estado) y el flow
+ * pendiente de la acción por la que el proceso espera.
+ */
+typedef struct
+{
+  int state; // -1: sin slice abierto
+  ActionType action;
+  int start;
+  int end;
+  int flowId; // 0: sin flow pendiente
+  ActionType flowAction;
+} TrackState;
+
+static struct
+{
+  FILE *file;
+  char buffer[TRACE_BUFFER_SIZE];
+  int written;
+  const Process *processes;
+  int processCount;
+  TrackState tracks[MAX_PROCESSES];
+  int nextFlowId;
+  int completed;
+
+  // Procesos en espera y en ejecución del ciclo en curso (counter "procesos")
+  int counterCycle;
+  int waiting;
+  int accessed;
+  int lastWaiting;
+  int lastAccessed;
+} trace;
+
+static long long traceTime(int cycle)
+{
+  return (long long)cycle * TRACE_CYCLE_US;
+}
+
+// Inicia un evento de la traza (separador del arreglo incluido)
+static void beginEvent(void)
+{
+  fputs(trace.written++ ? ",\n{" : "\n{", trace.file);
+}
+
+// Escribe una cadena JSON escapada
+static void writeString(const char *text)
+{
+  fputc('"', trace.file);
+  for (const unsigned char *c = (const unsigned char *)text; *c; c++)
+  {
+    if (*c == '"' || *c == '\\')
+      fprintf(trace.file, "\\%c", *c);
+    else if (*c < 0x20)
+      fprintf(trace.file, "\\u%04x", *c);
+    else
+      fputc(*c, trace.file);
+  }
+  fputc('"', trace.file);
+}
+
+static void writeMetadata(const char *name, int tid, const char *key, const char *value, int number)
+{
+  beginEvent();
+  fprintf(trace.file, "\"name\":\"%s\",\"ph\":\"M\",\"pid\":%d,", name, TRACE_PID);
+  if (tid > 0)
+    fprintf(trace.file, "\"tid\":%d,", tid);
+  fprintf(trace.file, "\"args\":{\"%s\":", key);
+  if (value)
+    writeString(value);
+  else
+    fprintf(trace.file, "%d", number);
+  fputs("}}", trace.file);
+}
+
+int openTrace(const char *path, const char *title, const Process *processes, int processCount)
+{
+  closeTrace();
+  trace.file = fopen(path && path[0] ? path : DEFAULT_TRACE_PATH, "w");
+  if (!trace.file)
+  {
+    fprintf(stderr, "No se pudo abrir el archivo de traza %s.\n", path && path[0] ? path : DEFAULT_TRACE_PATH);
+    return -1;
+  }
+  setvbuf(trace.file, trace.buffer, _IOFBF, sizeof(trace.buffer));
+
+  trace.written = 0;
+  trace.processes = processes;
+  trace.processCount = processCount;
+  trace.nextFlowId = 1;
+  trace.completed = 0;
+  trace.counterCycle = -1;
+  trace.waiting = trace.accessed = 0;
+  trace.lastWaiting = trace.lastAccessed = -1;
+
+  // Formato de arreglo: Perfetto también acepta la traza sin el cierre si la simulación se interrumpe
+  fputc('[', trace.file);
+  writeMetadata("process_name", 0, "name", title, 0);
+  for (int i = 0; i < processCount; i++)
+  {
+    trace.tracks[i].state = -1;
+    trace.tracks[i].flowId = 0;
+    writeMetadata("thread_name", i + 1, "name", processes[i].pid, 0);
+    writeMetadata("thread_sort_index", i + 1, "sort_index", NULL, i);
+  }
+  return 0;
+}
+
+// Índice del track de un proceso (-1 si no pertenece a la simulación trazada)
+static int trackIndex(const Process *process)
+{
+  if (!trace.file || process < trace.processes || process >= trace.processes + trace.processCount)
+    return -1;
+  return (int)(process - trace.processes);
+}
+
+// Estados de las ráfagas de I/O: son slices pero no cuentan en el counter de la CPU
+static int isIoState(int state)
+{
+  return state == STATE_IO || state == STATE_IO_WAITING;
+}
+
+// Escribe el slice abierto de un track si cubre al menos un ciclo
+static void writeSlice(int index)
+{
+  TrackState *track = &trace.tracks[index];
+  if (track->state < 0 || track->end <= track->start)
+    return;
+
+  beginEvent();
+  fprintf(trace.file,
+          "\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%lld,\"dur\":%lld,\"pid\":%d,\"tid\":%d",
+          track->action != ACTION_NONE ? getActionTypeName(track->action) : getProcessStateName(track->state),
+          track->state == STATE_WAITING     ? "waiting"
+          : track->state == STATE_SWITCHING ? "switch"
+          : isIoState(track->state)         ? "io"
+                                            : "access",
+          traceTime(track->start), traceTime(track->end - track->start), TRACE_PID, index + 1);
+  if (track->action != ACTION_NONE)
+    fprintf(trace.file, ",\"args\":{\"state\":\"%s\"}", getProcessStateName(track->state));
+  fputc('}', trace.file);
+}
+
+static void writeInstant(int index, int cycle, ProcessState state)
+{
+  beginEvent();
+  fprintf(trace.file, "\"name\":\"%s\",\"cat\":\"lifecycle\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%lld,\"pid\":%d,\"tid\":%d}",
+          getProcessStateName(state), traceTime(cycle), TRACE_PID, index + 1);
+}
+
+static void writeFlow(int index, int cycle, int id, ActionType action, int finish)
+{
+  beginEvent();
+  fprintf(trace.file, "\"name\":\"%s\",\"cat\":\"sync\",\"ph\":\"%s\",%s\"id\":%d,\"ts\":%lld,\"pid\":%d,\"tid\":%d}",
+          getActionTypeName(action), finish ? "f" : "s", finish ? "\"bp\":\"e\"," : "",
+          id, traceTime(cycle), TRACE_PID, index + 1);
+}
+
+// Escribe el counter de procesos del ciclo anterior si cambió
+static void flushCycleCounter(void)
+{
+  if (trace.counterCycle < 0 || (trace.waiting == trace.lastWaiting && trace.accessed == trace.lastAccessed))
+    return;
+
+  beginEvent();
+  fprintf(trace.file, "\"name\":\"procesos\",\"ph\":\"C\",\"ts\":%lld,\"pid\":%d,\"args\":{\"waiting\":%d,\"accessed\":%d}}",
+          traceTime(trace.counterCycle), TRACE_PID, trace.waiting, trace.accessed);
+  trace.lastWaiting = trace.waiting;
+  trace.lastAccessed = trace.accessed;
+}
+
+// Une la espera por una acción con su acceso (un flow por acción que tuvo que esperar)
+static void traceFlow(int index, int cycle, ProcessState state, ActionType action)
+{
+  TrackState *track = &trace.tracks[index];
+
+  if (track->flowId && (track->flowAction != action || state != STATE_WAITING))
+  {
+    if (state == STATE_ACCESSED && track->flowAction == action)
+      writeFlow(index, cycle, track->flowId, action, 1);
+    track->flowId = 0;
+  }
+
+  if (state == STATE_WAITING && action != ACTION_NONE && !track->flowId)
+  {
+    track->flowId = trace.nextFlowId++;
+    track->flowAction = action;
+    writeFlow(index, cycle, track->flowId, action, 0);
+  }
+}
+
+void traceProcessEvent(const Process *process, int cycle, ProcessState state, ActionType action)
+{
+  int index = trackIndex(process);
+  if (index < 0)
+    return;
+
+  TrackState *track = &trace.tracks[index];
+  if (state != STATE_WAITING && state != STATE_ACCESSED && state != STATE_SWITCHING && !isIoState(state))
+  {
+    // NEW, TERMINATED y OMITED son instantáneos; los últimos dos cierran el slice del proceso
+    if (state != STATE_NEW)
+    {
+      writeSlice(index);
+      track->state = -1;
+      track->flowId = 0;
+    }
+    writeInstant(index, cycle, state);
+    return;
+  }
+
+  // Un mismo estado repetido dentro del rango abierto no agrega nada
+  if (track->state == (int)state && track->action == action && cycle >= track->start && cycle < track->end)
+    return;
+
+  if (cycle > trace.counterCycle)
+  {
+    flushCycleCounter();
+
+    // Ciclos sin procesos en espera ni en ejecución
+    if (trace.counterCycle >= 0 && cycle > trace.counterCycle + 1)
+    {
+      trace.counterCycle++;
+      trace.waiting = trace.accessed = 0;
+      flushCycleCounter();
+    }
+    trace.counterCycle = cycle;
+    trace.waiting = trace.accessed = 0;
+  }
+  if (cycle == trace.counterCycle && !isIoState(state))
+  {
+    if (state == STATE_WAITING)
+      trace.waiting++;
+    else
+      trace.accessed++;
+  }
+
+  traceFlow(index, cycle, state, action);
+
+  if (track->state == (int)state && track->action == action && cycle == track->end)
+  {
+    track->end++;
+    return;
+  }
+
+  // Cambio de estado: en un mismo ciclo prevalece el último estado registrado
+  if (track->state >= 0 && cycle < track->end)
+  {
+    if (cycle == trace.counterCycle && !isIoState(track->state))
+    {
+      if (track->state == STATE_WAITING)
+        trace.waiting--;
+      else
+        trace.accessed--;
+    }
+    track->end = cycle;
+  }
+  writeSlice(index);
+  track->state = state;
+  track->action = action;
+  track->start = cycle;
+  track->end = cycle + 1;
+}
+
+void traceProcessMetric(const Process *process)
+{
+  int index = trackIndex(process);
+  if (index < 0)
+    return;
+
+  long long ts = traceTime(process->finishTime >= 0 ? process->finishTime : trace.counterCycle + 1);
+  beginEvent();
+  fprintf(trace.file, "\"name\":\"waitingTime\",\"ph\":\"C\",\"ts\":%lld,\"pid\":%d,\"args\":{", ts, TRACE_PID);
+  writeString(process->pid);
+  fprintf(trace.file, ":%d}}", process->waitingTime);
+
+  beginEvent();
+  fprintf(trace.file, "\"name\":\"completed\",\"ph\":\"C\",\"ts\":%lld,\"pid\":%d,\"args\":{\"value\":%d}}",
+          ts, TRACE_PID, ++trace.completed);
+}
+
+void traceInversionMetric(const Process *process, int inversionTime)
+{
+  int index = trackIndex(process);
+  if (index < 0)
+    return;
+
+  beginEvent();
+  fprintf(trace.file, "\"name\":\"inversionTime\",\"ph\":\"C\",\"ts\":%lld,\"pid\":%d,\"args\":{",
+          traceTime(trace.counterCycle + 1), TRACE_PID);
+  writeString(process->pid);
+  fprintf(trace.file, ":%d}}", inversionTime);
+}
+
+void closeTrace(void)
+{
+  if (!trace.file)
+    return;
+
+  for (int i = 0; i < trace.processCount; i++)
+    writeSlice(i);
+  flushCycleCounter();
+
+  fputs("\n]\n", trace.file);
+  fclose(trace.file);
+  trace.file = NULL;
+}
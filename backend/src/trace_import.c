@@ -0,0 +1,566 @@
+#include "trace_import.h"
+#include "simulator.h"
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+#define TASK_TABLE_SIZE (IMPORT_MAX_TASKS * 2) // Tabla hash con carga de a lo sumo la mitad
+#define MAX_TRACKED_CPUS 4096
+
+static ImportStats stats;
+
+/**
+ * Activación de una tarea: desde que despierta hasta que se bloquea o sale
+ */
+typedef struct
+{
+  int tid;
+  int prio;
+  double arrival; // Microsegundos
+  double cpu;     // Tiempo acumulado en CPU
+  double end;
+  int open;       // 1 mientras la tarea sigue lista o en ejecución
+} ImportJob;
+
+/**
+ * Tarea lista o en ejecución, con su trabajo abierto
+ */
+typedef struct
+{
+  int tid; // 0: lugar libre, -1: lugar borrado
+  int running;
+  double runStart;
+  long job; // Índice absoluto del trabajo en la cola
+} ImportTask;
+
+/**
+ * Estado de la importación: la tabla de tareas vivas y la cola circular de trabajos en orden de llegada
+ */
+typedef struct
+{
+  FILE *out;
+  int cycleUs;
+  double start; // Primer instante de la traza
+  double now;   // Último instante visto (la traza se trata como monótona)
+  int started;
+
+  ImportTask tasks[TASK_TABLE_SIZE];
+  int liveTasks;
+  int usedSlots; // Tareas vivas + lugares borrados
+
+  ImportJob jobs[IMPORT_MAX_PENDING];
+  long head; // Primer trabajo sin escribir
+  long tail; // Próximo trabajo
+
+  unsigned char cpuSeen[MAX_TRACKED_CPUS / 8];
+  unsigned int activations[IMPORT_MAX_TID]; // Trabajos escritos de cada tid
+} ImportState;
+
+/**
+ * Tarea leída de un evento
+ */
+typedef struct
+{
+  int tid;
+  int prio;
+  char state; // Estado al dejar la CPU (prev_state); 'R' si sigue lista
+} TraceTask;
+
+// ======================== TABLA DE TAREAS ========================
+
+static unsigned int hashTid(int tid)
+{
+  return ((unsigned int)tid * 2654435761u) % TASK_TABLE_SIZE;
+}
+
+static ImportTask *findTask(ImportState *state, int tid)
+{
+  for (unsigned int i = hashTid(tid), probes = 0; probes < TASK_TABLE_SIZE; i = (i + 1) % TASK_TABLE_SIZE, probes++)
+  {
+    if (state->tasks[i].tid == 0)
+      return NULL;
+    if (state->tasks[i].tid == tid)
+      return &state->tasks[i];
+  }
+  return NULL;
+}
+
+// Rehace la tabla sin los lugares borrados
+static void rebuildTasks(ImportState *state)
+{
+  static ImportTask live[IMPORT_MAX_TASKS];
+  int count = 0;
+  for (int i = 0; i < TASK_TABLE_SIZE; i++)
+  {
+    if (state->tasks[i].tid > 0)
+      live[count++] = state->tasks[i];
+  }
+  memset(state->tasks, 0, sizeof(state->tasks));
+  for (int t = 0; t < count; t++)
+  {
+    unsigned int i = hashTid(live[t].tid);
+    while (state->tasks[i].tid != 0)
+      i = (i + 1) % TASK_TABLE_SIZE;
+    state->tasks[i] = live[t];
+  }
+  state->usedSlots = count;
+}
+
+static ImportTask *insertTask(ImportState *state, int tid)
+{
+  if (state->liveTasks >= IMPORT_MAX_TASKS)
+    return NULL;
+  if (state->usedSlots >= TASK_TABLE_SIZE * 3 / 4)
+    rebuildTasks(state);
+
+  unsigned int i = hashTid(tid);
+  while (state->tasks[i].tid > 0)
+    i = (i + 1) % TASK_TABLE_SIZE;
+  if (state->tasks[i].tid == 0)
+    state->usedSlots++;
+
+  ImportTask *task = &state->tasks[i];
+  memset(task, 0, sizeof(*task));
+  task->tid = tid;
+  task->job = -1;
+  state->liveTasks++;
+  if (state->liveTasks > stats.maxTasks)
+    stats.maxTasks = state->liveTasks;
+  return task;
+}
+
+static void removeTask(ImportState *state, ImportTask *task)
+{
+  task->tid = -1;
+  state->liveTasks--;
+}
+
+// ======================== TRABAJOS ========================
+
+// Prioridad del simulador (0 la más alta) a partir de prio del kernel
+static int simulatorPriority(int prio)
+{
+  if (prio < 100)
+    return 0;
+  return prio - 99;
+}
+
+/**
+ * Pid único del trabajo: "tid.n" para la n-ésima activación escrita de la tarea. Si no entra (tid de 7
+ * dígitos con más de 9 activaciones), "x" y el número de trabajo en hexadecimal; nunca coincide con
+ * el otro formato porque empieza con una letra.
+ */
+static void jobPid(ImportState *state, const ImportJob *job, char pid[COMMON_MAX_LEN])
+{
+  if (job->tid > 0 && job->tid < IMPORT_MAX_TID)
+  {
+    unsigned int activation = ++state->activations[job->tid];
+    if (snprintf(pid, COMMON_MAX_LEN, "%d.%u", job->tid, activation) < COMMON_MAX_LEN)
+      return;
+  }
+  snprintf(pid, COMMON_MAX_LEN, "x%lx", (unsigned long)stats.jobs + 1);
+}
+
+// Escribe un trabajo terminado como línea de procesos.txt y lo suma al resumen del kernel
+static void writeJob(ImportState *state, const ImportJob *job)
+{
+  if (job->cpu <= 0)
+    return; // Sin tiempo en CPU no hay ráfaga que simular
+
+  char pid[COMMON_MAX_LEN];
+  long burst = (long)((job->cpu + state->cycleUs / 2.0) / state->cycleUs);
+  if (burst < 1)
+    burst = 1;
+  long arrival = (long)((job->arrival - state->start) / state->cycleUs);
+  jobPid(state, job, pid);
+  fprintf(state->out, "%s, %ld, %ld, %d\n", pid, burst, arrival, simulatorPriority(job->prio));
+
+  stats.jobs++;
+  stats.cpuCycles += burst;
+  stats.cpuUs += job->cpu;
+  stats.turnaroundUs += job->end - job->arrival;
+  stats.waitingUs += job->end - job->arrival - job->cpu;
+}
+
+// Escribe los trabajos terminados del frente de la cola: los posteriores no pueden llegar antes
+static void flushJobs(ImportState *state)
+{
+  while (state->head < state->tail && !state->jobs[state->head % IMPORT_MAX_PENDING].open)
+  {
+    writeJob(state, &state->jobs[state->head % IMPORT_MAX_PENDING]);
+    state->head++;
+  }
+}
+
+// Suma a su trabajo el tiempo en CPU de una tarea en ejecución hasta `now`
+static void chargeRunning(ImportState *state, ImportTask *task)
+{
+  if (!task->running)
+    return;
+  state->jobs[task->job % IMPORT_MAX_PENDING].cpu += state->now - task->runStart;
+  task->runStart = state->now;
+}
+
+static void closeJob(ImportState *state, ImportTask *task)
+{
+  ImportJob *job = &state->jobs[task->job % IMPORT_MAX_PENDING];
+  job->open = 0;
+  job->end = state->now;
+  task->job = -1;
+}
+
+static void openJob(ImportState *state, ImportTask *task, int prio);
+
+// Corta el trabajo más antiguo para liberar la cola: se escribe con lo que lleva y la tarea sigue en uno nuevo
+static void cutOldestJob(ImportState *state)
+{
+  ImportJob *oldest = &state->jobs[state->head % IMPORT_MAX_PENDING];
+  ImportTask *task = findTask(state, oldest->tid);
+  if (!task)
+  {
+    oldest->open = 0; // No debería pasar: todo trabajo abierto tiene su tarea
+    oldest->end = state->now;
+    return;
+  }
+  chargeRunning(state, task);
+  int prio = oldest->prio;
+  closeJob(state, task);
+  stats.cut++;
+  flushJobs(state);
+  openJob(state, task, prio);
+}
+
+static void openJob(ImportState *state, ImportTask *task, int prio)
+{
+  while (state->tail - state->head >= IMPORT_MAX_PENDING)
+  {
+    cutOldestJob(state);
+    flushJobs(state);
+  }
+
+  ImportJob *job = &state->jobs[state->tail % IMPORT_MAX_PENDING];
+  job->tid = task->tid;
+  job->prio = prio;
+  job->arrival = state->now;
+  job->cpu = 0;
+  job->end = 0;
+  job->open = 1;
+  task->job = state->tail++;
+}
+
+// Tarea lista desde `now`: si no tenía un trabajo abierto, empieza uno
+static ImportTask *activateTask(ImportState *state, const TraceTask *event)
+{
+  ImportTask *task = findTask(state, event->tid);
+  if (task)
+  {
+    state->jobs[task->job % IMPORT_MAX_PENDING].prio = event->prio;
+    return task;
+  }
+  task = insertTask(state, event->tid);
+  if (!task)
+  {
+    stats.skippedTasks++;
+    return NULL;
+  }
+  openJob(state, task, event->prio);
+  return task;
+}
+
+// Tarea que se bloquea o sale: su trabajo termina
+static void deactivateTask(ImportState *state, ImportTask *task)
+{
+  chargeRunning(state, task);
+  closeJob(state, task);
+  removeTask(state, task);
+  flushJobs(state);
+}
+
+// ======================== EVENTOS ========================
+
+static void handleSwitch(ImportState *state, const TraceTask *prev, const TraceTask *next)
+{
+  if (prev->tid > 0)
+  {
+    ImportTask *task = findTask(state, prev->tid);
+    if (prev->state == 'R')
+    {
+      // Expropiada: sigue lista (si no se la conocía, su trabajo empieza ahora)
+      if (!task)
+        task = activateTask(state, prev);
+      if (task)
+      {
+        chargeRunning(state, task);
+        task->running = 0;
+      }
+    }
+    else if (task)
+    {
+      deactivateTask(state, task);
+    }
+  }
+
+  if (next->tid > 0)
+  {
+    ImportTask *task = activateTask(state, next);
+    if (task)
+    {
+      task->running = 1;
+      task->runStart = state->now;
+    }
+  }
+}
+
+static void handleExit(ImportState *state, int tid)
+{
+  ImportTask *task = findTask(state, tid);
+  if (task)
+    deactivateTask(state, task);
+}
+
+// ======================== PARSEO ========================
+
+// Valor entero del campo `key=` (al inicio o después de un espacio); 0 si no está
+static int readField(const char *payload, const char *key, int *value)
+{
+  size_t length = strlen(key);
+  for (const char *p = strstr(payload, key); p; p = strstr(p + 1, key))
+  {
+    if ((p == payload || p[-1] == ' ') && p[length] == '=')
+    {
+      char *end;
+      long parsed = strtol(p + length + 1, &end, 10);
+      if (end == p + length + 1)
+        return 0;
+      *value = (int)parsed;
+      return 1;
+    }
+  }
+  return 0;
+}
+
+// Primer carácter del campo `key=`; '\0' si no está
+static char readStateField(const char *payload, const char *key)
+{
+  size_t length = strlen(key);
+  for (const char *p = strstr(payload, key); p; p = strstr(p + 1, key))
+  {
+    if ((p == payload || p[-1] == ' ') && p[length] == '=')
+      return p[length + 1];
+  }
+  return '\0';
+}
+
+/**
+ * Tarea en el formato compacto de perf: "comm:pid [prio]" seguido opcionalmente del estado. El
+ * nombre puede tener ':' y espacios, así que el pid es el número después del último ':' antes del
+ * primer " [prio]".
+ */
+static int parseCompactTask(const char *text, TraceTask *task)
+{
+  const char *bracket = text;
+  while ((bracket = strstr(bracket, " [")) != NULL)
+  {
+    if (isdigit((unsigned char)bracket[2]))
+      break;
+    bracket++;
+  }
+  if (!bracket)
+    return 0;
+
+  const char *colon = NULL;
+  for (const char *p = text; p < bracket; p++)
+  {
+    if (*p == ':')
+      colon = p;
+  }
+  if (!colon || sscanf(colon + 1, "%d", &task->tid) != 1 || sscanf(bracket + 2, "%d", &task->prio) != 1)
+    return 0;
+
+  const char *after = strchr(bracket + 2, ']');
+  task->state = 'R';
+  if (after)
+  {
+    after += strspn(after + 1, " ") + 1;
+    if (isalpha((unsigned char)*after) && (after[1] == '\0' || after[1] == ' ' || after[1] == '+' || after[1] == '|'))
+      task->state = *after;
+  }
+  return 1;
+}
+
+static int parseSwitch(char *payload, TraceTask *prev, TraceTask *next)
+{
+  if (readField(payload, "prev_pid", &prev->tid))
+  {
+    char state = readStateField(payload, "prev_state");
+    prev->state = state ? state : 'R';
+    return readField(payload, "prev_prio", &prev->prio) && readField(payload, "next_pid", &next->tid) &&
+           readField(payload, "next_prio", &next->prio);
+  }
+
+  // Formato compacto: "prev:pid [prio] S ==> next:pid [prio]"
+  char *arrow = strstr(payload, " ==> ");
+  if (!arrow)
+    return 0;
+  *arrow = '\0';
+  return parseCompactTask(payload, prev) && parseCompactTask(arrow + 5, next);
+}
+
+static int parseWakeup(const char *payload, TraceTask *task)
+{
+  task->state = 'R';
+  if (readField(payload, "pid", &task->tid))
+  {
+    if (!readField(payload, "prio", &task->prio))
+      task->prio = 120;
+    return 1;
+  }
+  return parseCompactTask(payload, task);
+}
+
+// Busca el nombre del evento ("sched_switch: " o "sched:sched_switch: "); NULL si la línea no lo tiene
+static char *findEvent(char *line, const char *name)
+{
+  size_t length = strlen(name);
+  for (char *p = strstr(line, name); p; p = strstr(p + 1, name))
+  {
+    if (p > line && (p[-1] == ' ' || p[-1] == ':') && p[length] == ':' && (p[length + 1] == ' ' || p[length + 1] == '\0'))
+      return p;
+  }
+  return NULL;
+}
+
+/**
+ * Lee el instante (en microsegundos) y la CPU que preceden al evento: "... [001] d..2  1234.567890: evento:"
+ * @return 1 si se encontró el instante.
+ */
+static int parseHeader(char *line, char *event, double *timestamp, int *cpu)
+{
+  char *p = event;
+  if (p - line >= 6 && strncmp(p - 6, "sched:", 6) == 0)
+    p -= 6;
+  while (p > line && p[-1] == ' ')
+    p--;
+  if (p == line || p[-1] != ':')
+    return 0;
+  char *end = --p;
+  while (p > line && (isdigit((unsigned char)p[-1]) || p[-1] == '.'))
+    p--;
+  if (p == end)
+    return 0;
+  *timestamp = strtod(p, NULL) * 1e6;
+
+  *cpu = -1;
+  for (char *c = p; c > line; c--)
+  {
+    if (c[-1] == '[' && isdigit((unsigned char)*c))
+    {
+      *cpu = atoi(c);
+      break;
+    }
+  }
+  return 1;
+}
+
+static void advanceClock(ImportState *state, double timestamp, int cpu)
+{
+  if (!state->started)
+  {
+    state->started = 1;
+    state->start = state->now = timestamp;
+  }
+  if (timestamp > state->now)
+    state->now = timestamp; // Un instante anterior (desfase entre CPUs) se toma como el último visto
+
+  if (cpu >= 0 && cpu < MAX_TRACKED_CPUS && !(state->cpuSeen[cpu / 8] & (1 << (cpu % 8))))
+  {
+    state->cpuSeen[cpu / 8] |= 1 << (cpu % 8);
+    stats.cpus++;
+  }
+}
+
+static void handleLine(ImportState *state, char *line)
+{
+  static const char *names[] = {"sched_switch", "sched_wakeup", "sched_wakeup_new", "sched_process_exit"};
+  char *event = NULL;
+  int kind = -1;
+  for (int k = 0; k < 4 && !event; k++)
+  {
+    event = findEvent(line, names[k]);
+    kind = k;
+  }
+  if (!event)
+    return;
+
+  double timestamp;
+  int cpu;
+  char *payload = event + strlen(names[kind]) + 1;
+  payload += strspn(payload, " ");
+  TraceTask first = {0}, second = {0};
+
+  int parsed = parseHeader(line, event, &timestamp, &cpu);
+  if (parsed)
+    parsed = kind == 0 ? parseSwitch(payload, &first, &second) : parseWakeup(payload, &first);
+  if (!parsed)
+  {
+    stats.ignored++;
+    return;
+  }
+
+  stats.events++;
+  advanceClock(state, timestamp, cpu);
+  if (kind == 0)
+    handleSwitch(state, &first, &second);
+  else if (kind == 3)
+    handleExit(state, first.tid);
+  else if (first.tid > 0)
+    activateTask(state, &first);
+}
+
+long importSchedTrace(FILE *in, FILE *out, int cycleUs)
+{
+  static ImportState state;
+  memset(&state, 0, sizeof(state));
+  memset(&stats, 0, sizeof(stats));
+  state.out = out;
+  state.cycleUs = cycleUs > 0 ? cycleUs : 1;
+
+  char line[1024];
+  while (fgets(line, sizeof(line), in))
+  {
+    size_t length = strcspn(line, "\r\n");
+    if (line[length] == '\0' && !feof(in))
+    {
+      // Línea más larga que el buffer: se descarta el resto
+      int c;
+      while ((c = fgetc(in)) != EOF && c != '\n')
+        ;
+    }
+    line[length] = '\0';
+    stats.lines++;
+    handleLine(&state, line);
+  }
+
+  // Lo que sigue abierto no terminó dentro de la traza: su ráfaga real se desconoce
+  for (long j = state.head; j < state.tail; j++)
+  {
+    ImportJob *job = &state.jobs[j % IMPORT_MAX_PENDING];
+    if (job->open)
+    {
+      job->open = 0;
+      job->cpu = 0;
+      stats.unfinished++;
+    }
+  }
+  flushJobs(&state);
+
+  stats.spanUs = state.now - state.start;
+  stats.cycles = (long)(stats.spanUs / state.cycleUs) + 1;
+  fflush(out);
+  return stats.jobs;
+}
+
+ImportStats getImportStats(void)
+{
+  return stats;
+}
@@ -0,0 +1,347 @@
+#include "tuner.h"
+#include "rr.h"
+#include "io.h"
+#include "switching.h"
+#include "run_pool.h"
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+static const char *objectiveNames[] = {"waiting", "turnaround", "response", "p99Response", "switchOverhead"};
+
+/**
+ * Resultado de simular un quantum
+ */
+typedef struct
+{
+  int quantum;
+  RunMetrics run;
+} TuneSample;
+
+/**
+ * Pasada que reparte simulateBatch: los quantums de `batch` en la etapa de `priority`
+ */
+typedef struct
+{
+  const TuneSample *batch;
+  const Process *workload;
+  int processCount;
+  const SimulationConfig *base;
+  int priority;
+} TuneBatch;
+
+/**
+ * Curva del objetivo de una etapa de la búsqueda (quantum global o el de una prioridad)
+ */
+typedef struct
+{
+  TuneSample *samples;
+  int count;
+  int capacity;
+} TuneCurve;
+
+int parseTuneObjective(const char *name)
+{
+  for (int i = 0; i < (int)(sizeof(objectiveNames) / sizeof(objectiveNames[0])); i++)
+  {
+    if (strcmp(name, objectiveNames[i]) == 0)
+      return i;
+  }
+  return -1;
+}
+
+static double objectiveValue(const TuneSample *sample, TuneObjective objective)
+{
+  switch (objective)
+  {
+  case TUNE_TURNAROUND:
+    return sample->run.turnaround;
+  case TUNE_RESPONSE:
+    return sample->run.response;
+  case TUNE_P99_RESPONSE:
+    return sample->run.p99Response;
+  case TUNE_SWITCH_OVERHEAD:
+    return sample->run.switchOverhead;
+  default:
+    return sample->run.waiting;
+  }
+}
+
+// Configuración que corresponde a `quantum` en la etapa de `priority` (-1: quantum global)
+static SimulationConfig sampleConfig(const SimulationConfig *base, int priority, int quantum)
+{
+  SimulationConfig config = *base;
+  if (priority < 0)
+    config.quantum = quantum;
+  else
+    config.priorityQuantum[priority] = quantum;
+  return config;
+}
+
+// Simula RR sobre una copia de la carga con el quantum `index` de la pasada (la salida ya está silenciada)
+static void simulateSample(int index, void *result, void *context)
+{
+  static Process processes[MAX_PROCESSES];
+  static TimelineEvent events[MAX_EVENTS];
+  int eventCount = 0;
+  const TuneBatch *pass = context;
+  TuneSample *sample = result;
+  int quantum = pass->batch[index].quantum;
+  SimulationControl control = {sampleConfig(pass->base, pass->priority, quantum)};
+
+  memcpy(processes, pass->workload, sizeof(Process) * pass->processCount);
+  if (ioModelActive())
+    simulateIO(processes, pass->processCount, events, &eventCount, &control);
+  else
+    simulateRR(processes, pass->processCount, events, &eventCount, &control);
+
+  sample->quantum = quantum;
+  measureRun(processes, pass->processCount, &control.config, &sample->run);
+}
+
+// Simula los `count` quantums de `batch` repartidos entre `workers` procesos hijos
+static void simulateBatch(TuneSample *batch, int count, int workers, const Process *workload,
+                          int processCount, const SimulationConfig *base, int priority)
+{
+  TuneBatch pass = {batch, workload, processCount, base, priority};
+  runWorkerPool(count, workers, sizeof(TuneSample), batch, simulateSample, &pass);
+}
+
+static const TuneSample *findSample(const TuneCurve *curve, int quantum)
+{
+  for (int i = 0; i < curve->count; i++)
+  {
+    if (curve->samples[i].quantum == quantum)
+      return &curve->samples[i];
+  }
+  return NULL;
+}
+
+static int compareSamples(const void *a, const void *b)
+{
+  return ((const TuneSample *)a)->quantum - ((const TuneSample *)b)->quantum;
+}
+
+/**
+ * Búsqueda de lo grueso a lo fino del quantum en [lo, hi]. En empate gana el quantum mayor (menos
+ * expropiaciones).
+ *
+ * @return Mejor quantum, o -1 si no hubo memoria para la curva.
+ */
+static int searchQuantum(const TuneSettings *settings, int workers, const Process *workload,
+                         int processCount, const SimulationConfig *base, int priority, TuneCurve *curve)
+{
+  int lo = settings->minQuantum, hi = settings->maxQuantum;
+  int points = settings->points;
+  int best = -1;
+  int step = 0, previousLo = -1, previousHi = -1;
+
+  while (1)
+  {
+    // Si el rango no se achicó (el redondeo del paso alcanza los extremos), se afina con la mitad
+    // del paso anterior para que la búsqueda siempre termine
+    if (lo == previousLo && hi == previousHi)
+      step = step / 2;
+    else
+      step = (hi - lo + points - 2) / (points - 1);
+    if (step < 1)
+      step = 1;
+    previousLo = lo;
+    previousHi = hi;
+
+    // Quantums de la pasada que todavía no se simularon
+    int first = curve->count;
+    for (int q = lo; q <= hi; q = (q < hi && q + step > hi) ? hi : q + step)
+    {
+      if (!findSample(curve, q))
+      {
+        if (curve->count == curve->capacity)
+        {
+          int capacity = curve->capacity ? curve->capacity * 2 : 64;
+          TuneSample *grown = realloc(curve->samples, sizeof(TuneSample) * capacity);
+          if (!grown)
+            return -1;
+          curve->samples = grown;
+          curve->capacity = capacity;
+        }
+        memset(&curve->samples[curve->count], 0, sizeof(TuneSample));
+        curve->samples[curve->count++].quantum = q;
+      }
+      if (q == hi)
+        break;
+    }
+    simulateBatch(curve->samples + first, curve->count - first, workers, workload, processCount, base, priority);
+
+    best = -1;
+    double bestValue = 0;
+    for (int i = 0; i < curve->count; i++)
+    {
+      const TuneSample *s = &curve->samples[i];
+      double value = objectiveValue(s, settings->objective);
+      if (s->quantum < lo || s->quantum > hi)
+        continue;
+      if (best < 0 || value < bestValue || (value == bestValue && s->quantum > best))
+      {
+        best = s->quantum;
+        bestValue = value;
+      }
+    }
+
+    if (step == 1)
+      return best;
+
+    // Refinar entre los vecinos del mejor
+    lo = best - step > settings->minQuantum ? best - step : settings->minQuantum;
+    hi = best + step < settings->maxQuantum ? best + step : settings->maxQuantum;
+  }
+}
+
+// Emite la curva de una etapa ordenada por quantum
+static void printCurve(TuneCurve *curve, const TuneSettings *settings, int priority, int switchCost)
+{
+  char line[512];
+  qsort(curve->samples, curve->count, sizeof(TuneSample), compareSamples);
+  for (int i = 0; i < curve->count; i++)
+  {
+    const TuneSample *s = &curve->samples[i];
+    int n = snprintf(line, sizeof(line), "{\"event\": \"TUNE_POINT\", ");
+    if (priority >= 0)
+      n += snprintf(line + n, sizeof(line) - n, "\"priority\": %d, ", priority);
+    n += snprintf(line + n, sizeof(line) - n,
+                  "\"quantum\": %d, \"objective\": %.4f, \"averageWaitingTime\": %.2f, \"averageTurnaround\": %.2f, "
+                  "\"averageResponse\": %.2f, \"p99Response\": %.2f, \"cycles\": %d",
+                  s->quantum, objectiveValue(s, settings->objective), s->run.waiting, s->run.turnaround,
+                  s->run.response, s->run.p99Response, s->run.cycles);
+    if (switchCost)
+      n += snprintf(line + n, sizeof(line) - n, ", \"contextSwitches\": %d, \"switchOverhead\": %.4f",
+                    s->run.switches, s->run.switchOverhead);
+    snprintf(line + n, sizeof(line) - n, "}");
+    printSummaryLine(line);
+  }
+}
+
+int runQuantumTuning(const TuneSettings *settings, const Process *processes, int processCount,
+                     const SimulationConfig *config)
+{
+  TuneSettings search = *settings;
+  int switchCost = switchCostEnabled(config);
+
+  if (search.objective == TUNE_SWITCH_OVERHEAD && !switchCost)
+  {
+    fprintf(stderr, "Tune: el objetivo switchOverhead requiere contextSwitchCost o warmupCost.\n");
+    return -1;
+  }
+
+  // Rango por defecto: hasta la ráfaga más larga (con un quantum mayor RR se comporta igual)
+  if (search.minQuantum < 1)
+    search.minQuantum = 1;
+  if (search.maxQuantum <= 0)
+  {
+    for (int i = 0; i < processCount; i++)
+    {
+      if (processes[i].burstTime > search.maxQuantum)
+        search.maxQuantum = processes[i].burstTime;
+    }
+  }
+  if (search.maxQuantum < search.minQuantum)
+    search.maxQuantum = search.minQuantum;
+  if (search.points <= 0)
+    search.points = TUNE_DEFAULT_POINTS;
+  else if (search.points < TUNE_MIN_POINTS)
+    search.points = TUNE_MIN_POINTS;
+
+  int workers = search.workers;
+  if (workers <= 0)
+    workers = (int)sysconf(_SC_NPROCESSORS_ONLN);
+  if (workers < 1)
+    workers = 1;
+  if (workers > TUNE_MAX_WORKERS)
+    workers = TUNE_MAX_WORKERS;
+
+  SimulationConfig base = *config;
+  TuneCurve curve = {NULL, 0, 0};
+  int evaluations = 0;
+  int status = 0;
+
+  setOutputMuted(1);
+  int quantum = searchQuantum(&search, workers, processes, processCount, &base, -1, &curve);
+  setOutputMuted(0);
+  if (quantum < 0)
+    status = -1;
+  else
+  {
+    base.quantum = quantum;
+    evaluations += curve.count;
+    printCurve(&curve, &search, -1, switchCost);
+  }
+
+  double bestValue = quantum >= 0 ? objectiveValue(findSample(&curve, quantum), search.objective) : 0;
+
+  // Prioridades presentes en la carga, una por una con el resto fijo
+  int levels[MAX_PRIORITY_LEVELS];
+  int levelCount = 0;
+  for (int i = 0; i < processCount && search.perPriority && status == 0; i++)
+  {
+    int priority = processes[i].priority;
+    if (priority < 0 || priority >= MAX_PRIORITY_LEVELS)
+      continue;
+    int seen = 0;
+    for (int l = 0; l < levelCount; l++)
+      seen |= levels[l] == priority;
+    if (!seen)
+      levels[levelCount++] = priority;
+  }
+  qsort(levels, levelCount, sizeof(int), compareInt);
+
+  for (int l = 0; l < levelCount && status == 0; l++)
+  {
+    curve.count = 0;
+    setOutputMuted(1);
+    int levelQuantum = searchQuantum(&search, workers, processes, processCount, &base, levels[l], &curve);
+    setOutputMuted(0);
+    if (levelQuantum < 0)
+    {
+      status = -1;
+      break;
+    }
+    evaluations += curve.count;
+    printCurve(&curve, &search, levels[l], switchCost);
+
+    double value = objectiveValue(findSample(&curve, levelQuantum), search.objective);
+    if (value < bestValue)
+    {
+      base.priorityQuantum[levels[l]] = levelQuantum;
+      bestValue = value;
+    }
+  }
+  free(curve.samples);
+
+  if (status != 0)
+  {
+    fprintf(stderr, "Tune: sin memoria para la curva del objetivo.\n");
+    return -1;
+  }
+
+  char line[256 + MAX_PRIORITY_LEVELS * 16];
+  int n = snprintf(line, sizeof(line),
+                   "{\"event\": \"TUNE_RESULT\", \"objective\": \"%s\", \"quantum\": %d, \"value\": %.4f, "
+                   "\"minQuantum\": %d, \"maxQuantum\": %d, \"evaluations\": %d, \"workers\": %d",
+                   objectiveNames[search.objective], quantum, bestValue,
+                   search.minQuantum, search.maxQuantum, evaluations, workers);
+  if (search.perPriority)
+  {
+    // Quantums por prioridad de la sesión más los que mejoraron el objetivo
+    n += snprintf(line + n, sizeof(line) - n, ", \"priorityQuantum\": {");
+    for (int p = 0, first = 1; p < MAX_PRIORITY_LEVELS; p++)
+    {
+      if (base.priorityQuantum[p] <= 0)
+        continue;
+      n += snprintf(line + n, sizeof(line) - n, "%s\"%d\": %d", first ? "" : ", ", p, base.priorityQuantum[p]);
+      first = 0;
+    }
+    n += snprintf(line + n, sizeof(line) - n, "}");
+  }
+  snprintf(line + n, sizeof(line) - n, "}");
+  printSummaryLine(line);
+  return 0;
+}
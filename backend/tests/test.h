@@ -0,0 +1,82 @@
+#ifndef TEST_H
+#define TEST_H
+
+#include "schedsim.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * Utilidades de las pruebas (make test): cada prueba es un ejecutable que corre escenarios con la API
+ * de libschedsim y devuelve 0 si todas sus comprobaciones pasan.
+ */
+
+static int testFailures = 0;
+
+#define CHECK(condition, message)                                         \
+  do                                                                      \
+  {                                                                       \
+    if (!(condition))                                                     \
+    {                                                                     \
+      fprintf(stderr, "%s:%d: %s\n", __FILE__, __LINE__, message);        \
+      testFailures++;                                                     \
+    }                                                                     \
+  } while (0)
+
+/**
+ * Eventos de una simulación: todas las líneas que entregó la biblioteca, separadas por '\n'
+ */
+typedef struct
+{
+  char *text;
+  size_t length;
+  size_t capacity;
+} EventLog;
+
+static inline void collectEvents(const char *line, size_t length, void *userData)
+{
+  EventLog *log = userData;
+  if (log->length + length + 2 > log->capacity)
+  {
+    size_t capacity = (log->length + length + 2) * 2;
+    char *grown = realloc(log->text, capacity);
+    if (!grown)
+      return;
+    log->text = grown;
+    log->capacity = capacity;
+  }
+  memcpy(log->text + log->length, line, length);
+  log->length += length;
+  log->text[log->length++] = '\n';
+  log->text[log->length] = '\0';
+}
+
+/**
+ * Corre la simulación completa y guarda sus eventos en `log` (liberar log->text con free).
+ *
+ * @return 0 si la simulación terminó, -1 si no se pudo crear o falló.
+ */
+static inline int runScenario(const SchedSimConfig *config, const SchedSimProcess *processes, int processCount,
+                       const SchedSimResource *resources, int resourceCount,
+                       const SchedSimAction *actions, int actionCount, EventLog *log)
+{
+  memset(log, 0, sizeof(*log));
+  SchedSim *sim = schedsimCreate(config, processes, processCount, resources, resourceCount, actions, actionCount);
+  if (!sim)
+    return -1;
+  schedsimSetEventCallback(sim, collectEvents, log);
+  int status = schedsimRun(sim);
+  schedsimDestroy(sim);
+  return status;
+}
+
+// Indica si el proceso `pid` tuvo el estado `state` en el ciclo `cycle`
+static inline int hasEvent(const EventLog *log, const char *pid, int cycle, const char *state)
+{
+  char pattern[128];
+  snprintf(pattern, sizeof(pattern), "{\"pid\": \"%s\", \"startCycle\": %d, \"endCycle\": %d, \"state\": \"%s\"",
+           pid, cycle, cycle + 1, state);
+  return log->text && strstr(log->text, pattern) != NULL;
+}
+
+#endif
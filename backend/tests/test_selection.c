@@ -0,0 +1,67 @@
+#include "test.h"
+#include "selection.h"
+
+#define SELECTION_ROUNDS 2000
+
+// Columnas pseudoaleatorias con valores repetidos (para forzar empates) y procesos terminados
+static int buildColumns(unsigned *seed, ProcessColumns *columns)
+{
+  int processCount = 1 + rand_r(seed) % MAX_PROCESSES;
+  for (int i = 0; i < processCount; i++)
+  {
+    columns->arrival[i] = rand_r(seed) % 20;
+    columns->burst[i] = 1 + rand_r(seed) % 8;
+    columns->priority[i] = rand_r(seed) % 4;
+    columns->remaining[i] = rand_r(seed) % 5 == 0 ? -1 : rand_r(seed) % (columns->burst[i] + 1);
+  }
+  return processCount;
+}
+
+/**
+ * Cada implementación forzada con setSelectionKernel debe elegir el mismo proceso que la escalar
+ * en las tres búsquedas. Las que la CPU no soporta se omiten.
+ */
+static void checkKernelMatchesScalar(SelectionKernel kernel)
+{
+  if (setSelectionKernel(kernel) != 0)
+  {
+    fprintf(stderr, "test_selection: la CPU no soporta el kernel %d; se omite.\n", kernel);
+    return;
+  }
+  const char *name = getSelectionKernelName();
+
+  unsigned seed = 42;
+  ProcessColumns columns;
+  for (int round = 0; round < SELECTION_ROUNDS; round++)
+  {
+    int processCount = buildColumns(&seed, &columns);
+    int currentTime = rand_r(&seed) % 24;
+    int lastIdx = rand_r(&seed) % (processCount + 1) - 1;
+
+    int srt = selectShortestRemaining(&columns, processCount, currentTime, lastIdx);
+    int sjf = selectShortestJob(&columns, processCount, currentTime);
+    int ps = selectHighestPriority(&columns, processCount, currentTime);
+
+    setSelectionKernel(KERNEL_SCALAR);
+    int expectedSrt = selectShortestRemaining(&columns, processCount, currentTime, lastIdx);
+    int expectedSjf = selectShortestJob(&columns, processCount, currentTime);
+    int expectedPs = selectHighestPriority(&columns, processCount, currentTime);
+    setSelectionKernel(kernel);
+
+    if (srt != expectedSrt || sjf != expectedSjf || ps != expectedPs)
+    {
+      fprintf(stderr, "kernel %s, ronda %d (%d procesos, ciclo %d): SRT %d/%d, SJF %d/%d, PS %d/%d\n", name,
+              round, processCount, currentTime, srt, expectedSrt, sjf, expectedSjf, ps, expectedPs);
+      CHECK(0, "el kernel difiere del escalar");
+      return;
+    }
+  }
+}
+
+int main(void)
+{
+  checkKernelMatchesScalar(KERNEL_SCALAR);
+  checkKernelMatchesScalar(KERNEL_SSE2);
+  checkKernelMatchesScalar(KERNEL_AVX2);
+  return testFailures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,86 @@
+#include "test.h"
+
+#define SHARD_PROCESSES 80
+#define SHARD_RESOURCES 16
+#define SHARD_ACTIONS 5 // Acciones por proceso
+
+/**
+ * Carga pseudoaleatoria con más procesos que SYNC_SHARD_MIN_PROCESSES: cada proceso lee o escribe
+ * recursos al azar en ciclos crecientes, con prioridades repetidas para que el orden de atención
+ * importe. La semilla fija hace la carga reproducible.
+ */
+static void buildWorkload(unsigned seed, SchedSimProcess *processes, SchedSimResource *resources,
+                          SchedSimAction *actions)
+{
+  for (int r = 0; r < SHARD_RESOURCES; r++)
+  {
+    snprintf(resources[r].name, SCHEDSIM_NAME_LEN, "R%d", r);
+    resources[r].counter = 1 + rand_r(&seed) % 3;
+  }
+
+  for (int i = 0; i < SHARD_PROCESSES; i++)
+  {
+    SchedSimProcess *p = &processes[i];
+    snprintf(p->pid, SCHEDSIM_NAME_LEN, "P%d", i);
+    p->burstTime = SHARD_ACTIONS;
+    p->arrivalTime = rand_r(&seed) % 10;
+    p->priority = 1 + rand_r(&seed) % 5;
+
+    int cycle = p->arrivalTime;
+    for (int k = 0; k < SHARD_ACTIONS; k++)
+    {
+      SchedSimAction *a = &actions[i * SHARD_ACTIONS + k];
+      snprintf(a->pid, SCHEDSIM_NAME_LEN, "%s", p->pid);
+      a->action = rand_r(&seed) % 2 ? SCHEDSIM_WRITE : SCHEDSIM_READ;
+      snprintf(a->resource, SCHEDSIM_NAME_LEN, "R%d", (int)(rand_r(&seed) % SHARD_RESOURCES));
+      a->cycle = cycle;
+      cycle += 1 + rand_r(&seed) % 4;
+    }
+  }
+}
+
+/**
+ * La concesión repartida entre hilos debe producir exactamente los mismos eventos y métricas que la
+ * secuencial sobre la misma carga.
+ */
+static void checkShardsMatchSerial(unsigned seed, int useMutex, int priorityQueue, const char *protocol)
+{
+  SchedSimProcess processes[SHARD_PROCESSES];
+  SchedSimResource resources[SHARD_RESOURCES];
+  SchedSimAction actions[SHARD_PROCESSES * SHARD_ACTIONS];
+  buildWorkload(seed, processes, resources, actions);
+
+  SchedSimConfig config;
+  schedsimDefaultConfig(&config);
+  config.mode = SCHEDSIM_SYNCHRONIZATION;
+  config.algorithm = NULL;
+  config.useMutex = useMutex;
+  config.priorityQueue = priorityQueue;
+  config.protocol = protocol;
+
+  EventLog serial, sharded;
+  config.shards = 1;
+  int serialStatus = runScenario(&config, processes, SHARD_PROCESSES, resources, SHARD_RESOURCES, actions,
+                                 SHARD_PROCESSES * SHARD_ACTIONS, &serial);
+  config.shards = 4;
+  int shardedStatus = runScenario(&config, processes, SHARD_PROCESSES, resources, SHARD_RESOURCES, actions,
+                                  SHARD_PROCESSES * SHARD_ACTIONS, &sharded);
+
+  CHECK(serialStatus == 0 && shardedStatus == 0, "la simulación no terminó");
+  CHECK(serial.text && sharded.text && strcmp(serial.text, sharded.text) == 0,
+        "la concesión repartida difiere de la secuencial");
+  free(serial.text);
+  free(sharded.text);
+}
+
+int main(void)
+{
+  for (unsigned seed = 1; seed <= 8; seed++)
+  {
+    checkShardsMatchSerial(seed, 1, 0, "none");
+    checkShardsMatchSerial(seed, 0, 0, "none");
+    checkShardsMatchSerial(seed, 1, 1, "inheritance");
+    checkShardsMatchSerial(seed, 0, 1, "none");
+  }
+  return testFailures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,66 @@
+#include "test.h"
+
+/**
+ * Semáforo con dos unidades: A y B leen R1 en los ciclos 0 y 1, C lo pide en el ciclo 1. Cada
+ * poseedor devuelve su unidad al final del ciclo 0, así que en el ciclo 1 A y B vuelven a entrar y
+ * solo C espera.
+ */
+static void testSemaphoreReleasesEveryHolder(void)
+{
+  SchedSimConfig config;
+  schedsimDefaultConfig(&config);
+  config.mode = SCHEDSIM_SYNCHRONIZATION;
+  config.algorithm = NULL;
+  config.useMutex = 0;
+
+  SchedSimProcess processes[] = {{"A", 2, 0, 1}, {"B", 2, 0, 1}, {"C", 1, 0, 1}};
+  SchedSimResource resources[] = {{"R1", 2}};
+  SchedSimAction actions[] = {
+      {"A", SCHEDSIM_READ, "R1", 0}, {"B", SCHEDSIM_READ, "R1", 0},
+      {"A", SCHEDSIM_READ, "R1", 1}, {"B", SCHEDSIM_READ, "R1", 1}, {"C", SCHEDSIM_READ, "R1", 1}};
+
+  EventLog log;
+  CHECK(runScenario(&config, processes, 3, resources, 1, actions, 5, &log) == 0, "la simulación no terminó");
+  CHECK(hasEvent(&log, "A", 0, "ACCESSED") && hasEvent(&log, "B", 0, "ACCESSED"), "A y B deben entrar en el ciclo 0");
+  CHECK(hasEvent(&log, "A", 1, "ACCESSED"), "A debe volver a entrar en el ciclo 1");
+  CHECK(hasEvent(&log, "B", 1, "ACCESSED"), "B debe volver a entrar en el ciclo 1 (se perdió una unidad)");
+  CHECK(hasEvent(&log, "C", 1, "WAITING"), "C debe esperar en el ciclo 1");
+  free(log.text);
+}
+
+/**
+ * Simulación combinada: L (prioridad 5) escribe R1 en los ciclos 0 a 3 y H (prioridad 1) llega en el
+ * ciclo 1 y expropia a L antes de pedir R1 en el ciclo `requestCycle`. L conserva R1 mientras está
+ * expropiado, así que H se bloquea al pedirlo y L vuelve a la CPU en ese mismo ciclo.
+ */
+static void checkPreemptedHolderKeepsLock(const char *algorithm, int isPreemptive, int quantum, int requestCycle)
+{
+  SchedSimConfig config;
+  schedsimDefaultConfig(&config);
+  config.mode = SCHEDSIM_SYNCHRONIZATION;
+  config.algorithm = algorithm;
+  config.isPreemptive = isPreemptive;
+  config.quantum = quantum;
+
+  SchedSimProcess processes[] = {{"L", 4, 0, 5}, {"H", 3, 1, 1}};
+  SchedSimResource resources[] = {{"R1", 1}};
+  SchedSimAction actions[] = {
+      {"L", SCHEDSIM_WRITE, "R1", 0}, {"L", SCHEDSIM_WRITE, "R1", 1}, {"L", SCHEDSIM_WRITE, "R1", 2},
+      {"L", SCHEDSIM_WRITE, "R1", 3}, {"H", SCHEDSIM_WRITE, "R1", requestCycle}};
+
+  EventLog log;
+  CHECK(runScenario(&config, processes, 2, resources, 1, actions, 5, &log) == 0, "la simulación no terminó");
+  CHECK(hasEvent(&log, "L", requestCycle - 1, "WAITING") && hasEvent(&log, "H", requestCycle - 1, "ACCESSED"),
+        "H debe expropiar a L antes de pedir R1");
+  CHECK(hasEvent(&log, "H", requestCycle, "WAITING"), "H debe esperar R1, que retiene L expropiado");
+  CHECK(hasEvent(&log, "L", requestCycle, "ACCESSED"), "L debe volver a la CPU cuando H se bloquea");
+  free(log.text);
+}
+
+int main(void)
+{
+  testSemaphoreReleasesEveryHolder();
+  checkPreemptedHolderKeepsLock("PS", 1, 1, 2);
+  checkPreemptedHolderKeepsLock("RR", 0, 2, 3);
+  return testFailures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
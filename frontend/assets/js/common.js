@@ -74,3 +74,36 @@ async function checkRouteAccess(targetRoute) {
   console.log("[DEBUG] Acceso permitido.");
   return true;
 }
+
+/**
+ * Convierte el contenido de un archivo de entrada en la lista equivalente de la carga en línea
+ * (`workload` de la configuración), con los mismos campos que usa el simulador.
+ *
+ * @param {string} type - Tipo del archivo: "procesos", "recursos" o "acciones".
+ * @param {string} content - Contenido del archivo ya validado.
+ * @returns {Array<Object>} Procesos, recursos o acciones del archivo.
+ */
+function parseWorkloadFile(type, content) {
+  const rows = content
+    .trim()
+    .split("\n")
+    .map((line) => line.split(",").map((field) => field.trim()));
+
+  if (type === "procesos") {
+    return rows.map(([pid, burstTime, arrivalTime, priority]) => ({
+      pid,
+      burstTime: Number(burstTime),
+      arrivalTime: Number(arrivalTime),
+      priority: Number(priority),
+    }));
+  }
+  if (type === "recursos") {
+    return rows.map(([name, counter]) => ({ name, counter: Number(counter) }));
+  }
+  return rows.map(([pid, action, resource, cycle]) => ({
+    pid,
+    action,
+    resource,
+    cycle: Number(cycle),
+  }));
+}
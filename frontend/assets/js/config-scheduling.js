@@ -9,16 +9,19 @@ async function initializeConfig() {
   if (!hasRouteAccess) return;
 }
 
+// Algoritmos que reparten la CPU por turnos de un quantum
+const QUANTUM_ALGORITHMS = ["RR", "LOTTERY", "STRIDE"];
+
 /**
  * Maneja el cambio en el selector de algoritmo.
  * Muestra u oculta configuraciones específicas según el algoritmo seleccionado:
- * - Muestra configuración de quantum si es "RR" (Round Robin).
+ * - Muestra configuración de quantum si es "RR" (Round Robin), "LOTTERY" o "STRIDE".
  * - Muestra configuración preemptiva si es "PS" (Priority Scheduling).
  */
 function onAlgorithmChange() {
   const algorithm = document.getElementById("algorithm").value;
   document.getElementById("quantum-config").style.display =
-    algorithm === "RR" ? "flex" : "none";
+    QUANTUM_ALGORITHMS.includes(algorithm) ? "flex" : "none";
   document.getElementById("preemptive-config").style.display =
     algorithm === "PS" ? "flex" : "none";
 }
@@ -34,11 +37,11 @@ function onAlgorithmChange() {
  * @returns {boolean} true si la configuración es válida, false si no.
  */
 function validateSimulationConfig(config) {
-  if (config.algorithm === "RR") {
+  if (QUANTUM_ALGORITHMS.includes(config.algorithm)) {
     if (!config.quantum || parseInt(config.quantum) <= 0) {
       showAlert(
         "Error de Quantum",
-        "El quantum debe ser un número positivo para Round Robin.",
+        `El quantum debe ser un número positivo para ${config.algorithm}.`,
         "warning"
       );
       return false;
@@ -5,7 +5,20 @@ async function initializeSyncConfig() {
 
 async function startSyncSimulation() {
   const mechanism = document.getElementById("mechanism").value;
-  const config = { mechanism };
+  const selectedProtocol = document.getElementById("protocol").value;
+  const priorityQueue = selectedProtocol === "none" ? 0 : 1;
+  const protocol = selectedProtocol === "priority" ? "none" : selectedProtocol;
+  const algorithm = document.getElementById("cpu-algorithm").value;
+  const quantum = parseInt(document.getElementById("cpu-quantum").value) || 1;
+  const isPreemptive = parseInt(document.getElementById("cpu-preemptive").value);
+  const config = {
+    mechanism,
+    protocol,
+    priorityQueue,
+    algorithm,
+    quantum,
+    isPreemptive,
+  };
   localStorage.setItem("lastSyncConfig", JSON.stringify(config));
   window.location.href = "/simulation-synchronization";
 }
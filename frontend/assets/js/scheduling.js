@@ -38,7 +38,8 @@ function validateTxtContent(content) {
 
 /**
  * Realiza la carga del archivo `procesos.txt` para la planificación.
- * Verifica existencia, nombre y formato del archivo, valida su contenido y lo sube vía `fetch`.
+ * Verifica existencia, nombre y formato del archivo, valida su contenido y lo guarda en localStorage
+ * como carga en línea; la simulación la envía en su configuración, sin archivos compartidos.
  * Muestra alertas en caso de error y redirecciona si la carga es exitosa.
  *
  * @return {Promise<void>} - No retorna un valor, pero ejecuta acciones asíncronas.
@@ -70,19 +71,10 @@ async function uploadScheduling() {
   const content = await file.text();
   if (!validateTxtContent(content)) return;
 
-  const formData = new FormData();
-  formData.append("files", file);
+  const workload = { processes: parseWorkloadFile("procesos", content) };
+  localStorage.setItem("lastShWorkload", JSON.stringify(workload));
 
-  const response = await fetch("/uploadFiles/", {
-    method: "POST",
-    body: formData,
-  });
-
-  if (response.ok) {
-    showAlert("Éxito", "Archivo subido correctamente.", "success");
-    allowAccess();
-    setTimeout(() => (window.location.href = "/config-scheduling"), 1500);
-  } else {
-    showAlert("Error", "Error al subir el archivo.", "error");
-  }
+  showAlert("Éxito", "Archivo cargado correctamente.", "success");
+  allowAccess();
+  setTimeout(() => (window.location.href = "/config-scheduling"), 1500);
 }
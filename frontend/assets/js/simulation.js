@@ -10,7 +10,6 @@ let mechanismUsed = "";
 const processColors = {};
 let colorIndex = 0;
 let currentCycle = 0;
-const events = [];
 const processMetrics = [];
 
 /**
@@ -43,6 +42,12 @@ function getColorForProcess(pid, state) {
       return `${base} 1)`; // tono medio
     case "WAITING":
       return `${base} 0.3)`; // tono opaco
+    case "SWITCHING":
+      return `${base} 0.6)`; // cambio de contexto
+    case "IO":
+      return `${base} 0.45)`; // ráfaga de I/O en un dispositivo
+    case "IO_WAITING":
+      return `${base} 0.15)`; // cola de un dispositivo
     default:
       return `${base} 1)`; // fallback
   }
@@ -101,96 +106,499 @@ function renderActionsTable() {
 }
 
 /**
- * Renderiza la tabla Gantt con eventos de procesos.
- * Cada fila representa un proceso y cada columna un ciclo de tiempo.
- * Las celdas se colorean según el proceso que está activo en ese ciclo.
- * Además, se genera una leyenda con los colores asignados a cada proceso.
+ * Diagrama de Gantt en canvas.
  *
- * @param {Array} events - Array de eventos con objetos que contienen:
- *   pid: identificador del proceso,
- *   startCycle: ciclo donde inicia el evento,
- *   endCycle: ciclo donde termina el evento.
+ * Cada proceso es una fila con sus intervalos [startCycle, endCycle) guardados en arreglos
+ * paralelos y ordenados por inicio; los intervalos consecutivos con el mismo estado y sin acción
+ * se fusionan al llegar. El canvas solo cubre el área visible: en cada dibujo se ubican por
+ * búsqueda binaria los intervalos de las filas visibles, así que el costo depende del viewport
+ * y no del largo de la traza. El desplazamiento usa el scroll nativo de #gantt-scroll sobre un
+ * espaciador con el tamaño total del diagrama; Ctrl + rueda (o los botones) cambia el zoom.
  */
-function renderGanttTable(events) {
-  const table = document.getElementById("gantt-table");
-  const legend = document.getElementById("gantt-legend");
+const STATE_NEW = 1;
+const STATE_ACCESSED = 2;
+const STATE_WAITING = 3;
+const STATE_TERMINATED = 4;
+const STATE_SWITCHING = 5;
+const STATE_IO = 6;
+const STATE_IO_WAITING = 7;
+const stateCodes = {
+  NEW: STATE_NEW,
+  ACCESSED: STATE_ACCESSED,
+  WAITING: STATE_WAITING,
+  TERMINATED: STATE_TERMINATED,
+  SWITCHING: STATE_SWITCHING,
+  IO: STATE_IO,
+  IO_WAITING: STATE_IO_WAITING,
+};
+
+// Orden de dibujo de los estados con intervalo: los tonos más opacos primero
+const GANTT_PASSES = ["IO_WAITING", "WAITING", "IO", "SWITCHING", "ACCESSED"];
+const ganttPass = {
+  [STATE_IO_WAITING]: 0,
+  [STATE_WAITING]: 1,
+  [STATE_IO]: 2,
+  [STATE_SWITCHING]: 3,
+};
+
+const GANTT_ROW_HEIGHT = 28;
+const GANTT_HEADER_HEIGHT = 28;
+const GANTT_LABEL_WIDTH = 90;
+const GANTT_DEFAULT_CELL_WIDTH = 56;
+const GANTT_MIN_CELL_WIDTH = 0.02;
+const GANTT_MAX_CELL_WIDTH = 160;
+const GANTT_LABEL_MIN_CELL_WIDTH = 44; // Ancho mínimo de celda para escribir etiquetas
+const GANTT_MAX_SCROLL_SIZE = 30000000; // Límite de tamaño de elemento en los navegadores
+const GANTT_LEGEND_LIMIT = 200;
+
+const gantt = {
+  rows: [], // { pid, starts, ends, states, actions, maxSpan }
+  rowByPid: new Map(),
+  order: [], // Índices de `rows` en el orden de dibujo
+  orderDirty: false,
+  maxCycle: -1,
+  cellWidth: GANTT_DEFAULT_CELL_WIDTH,
+  followTail: true, // Mantener visible el último ciclo mientras llegan eventos
+  renderPending: false,
+  spacerDirty: false,
+  initialized: false,
+};
 
-  table.innerHTML = "";
-  legend.innerHTML = "";
+/**
+ * Compara PIDs por su parte numérica (P2 antes que P10).
+ */
+function comparePids(a, b) {
+  const numA = a.match(/\d+/);
+  const numB = b.match(/\d+/);
+  if (numA && numB) return parseInt(numA[0]) - parseInt(numB[0]);
+  return a.localeCompare(b);
+}
 
-  let pids = [...new Set(events.map((e) => e.pid))];
-  if (sortGanttByPID) {
-    pids.sort((a, b) => {
-      const numA = a.match(/\d+/);
-      const numB = b.match(/\d+/);
-      if (numA && numB) return parseInt(numA[0]) - parseInt(numB[0]);
-      return a.localeCompare(b);
+function getGanttRow(pid) {
+  let index = gantt.rowByPid.get(pid);
+  if (index === undefined) {
+    index = gantt.rows.length;
+    gantt.rows.push({
+      pid,
+      starts: [],
+      ends: [],
+      states: [],
+      actions: [],
+      maxSpan: 0,
     });
+    gantt.rowByPid.set(pid, index);
+    gantt.order.push(index);
+    gantt.orderDirty = sortGanttByPID;
+    addLegendItem(pid);
+  }
+  return gantt.rows[index];
+}
+
+/**
+ * Agrega un evento de intervalo (pid, startCycle, endCycle, state, action) al diagrama.
+ */
+function addGanttEvent(event) {
+  const row = getGanttRow(event.pid);
+  const state = stateCodes[event.state] || 0; // Otros estados (p. ej. OMITED) no se dibujan
+  const action = event.action && event.action !== "NONE" ? event.action : null;
+  const last = row.starts.length - 1;
+
+  // Fusionar con el intervalo anterior si continúa el mismo estado sin acción
+  if (
+    last >= 0 &&
+    !action &&
+    !row.actions[last] &&
+    row.states[last] === state &&
+    row.ends[last] === event.startCycle &&
+    (state === STATE_WAITING ||
+      state === STATE_ACCESSED ||
+      state === STATE_SWITCHING ||
+      state === STATE_IO ||
+      state === STATE_IO_WAITING)
+  ) {
+    row.ends[last] = event.endCycle;
+    row.maxSpan = Math.max(row.maxSpan, row.ends[last] - row.starts[last]);
+  } else {
+    // Los eventos llegan casi siempre en orden; si no, se inserta en su posición
+    let k = row.starts.length;
+    while (k > 0 && row.starts[k - 1] > event.startCycle) k--;
+    row.starts.splice(k, 0, event.startCycle);
+    row.ends.splice(k, 0, event.endCycle);
+    row.states.splice(k, 0, state);
+    row.actions.splice(k, 0, action);
+    row.maxSpan = Math.max(row.maxSpan, event.endCycle - event.startCycle);
+  }
+
+  if (event.endCycle > gantt.maxCycle) gantt.maxCycle = event.endCycle;
+}
+
+// Primer índice con starts[k] >= value
+function lowerBound(values, value) {
+  let lo = 0;
+  let hi = values.length;
+  while (lo < hi) {
+    const mid = (lo + hi) >> 1;
+    if (values[mid] < value) lo = mid + 1;
+    else hi = mid;
+  }
+  return lo;
+}
+
+function addLegendItem(pid) {
+  const legend = document.getElementById("gantt-legend");
+  const count = gantt.rows.length;
+  if (count <= GANTT_LEGEND_LIMIT) {
+    const item = document.createElement("div");
+    item.className = "legend-item";
+    item.innerHTML = `<div class="color-box" style="background:${getColorForProcess(
+      pid,
+      "NEW"
+    )}"></div>${pid}`;
+    legend.appendChild(item);
+    return;
+  }
+
+  let more = document.getElementById("gantt-legend-more");
+  if (!more) {
+    more = document.createElement("div");
+    more.id = "gantt-legend-more";
+    more.className = "legend-item";
+    legend.appendChild(more);
   }
+  more.textContent = `... y ${count - GANTT_LEGEND_LIMIT} procesos más`;
+}
+
+function initializeGantt() {
+  if (gantt.initialized) return;
+  gantt.initialized = true;
 
-  const maxCycle = Math.max(...events.map((e) => e.endCycle));
+  const scroll = document.getElementById("gantt-scroll");
 
-  // Leyenda
-  pids.forEach((pid) => {
-    const legendColor = getColorForProcess(pid, "NEW");
-    legend.innerHTML += `<div class="legend-item"><div class="color-box" style="background:${legendColor}"></div>${pid}</div>`;
+  scroll.addEventListener("scroll", () => {
+    gantt.followTail =
+      scroll.scrollLeft + scroll.clientWidth >= scroll.scrollWidth - 2;
+    scheduleGanttRender();
   });
 
-  // Encabezado
-  let headerRow = "<tr><th>Proceso/Ciclo</th>";
-  for (let c = 0; c <= maxCycle; c++) headerRow += `<th>${c}</th>`;
-  headerRow += "</tr>";
-  table.innerHTML += headerRow;
-
-  // Filas de procesos
-  pids.forEach((pid) => {
-    let row = `<tr><td>${pid}</td>`;
-    for (let c = 0; c <= maxCycle; c++) {
-      const matching = events.filter(
-        (e) => e.pid === pid && c >= e.startCycle && c < e.endCycle
-      );
-
-      const hasNew = matching.some((e) => e.state === "NEW");
-      const hasAccessed = matching.some((e) => e.state === "ACCESSED");
-      const hasTerminated = matching.some((e) => e.state === "TERMINATED");
-      const hasWaiting = matching.some((e) => e.state === "WAITING");
-
-      let label = "";
-      let color = "";
-
-      if (hasTerminated) {
-        label = `TD - ${pid}`;
-        color = getColorForProcess(pid, "ACCESSED");
-      } else if (hasAccessed && hasNew) {
-        label = `NW - ${pid}`;
-        color = getColorForProcess(pid, "ACCESSED");
-      } else if (hasWaiting && hasNew) {
-        label = `NW - ${pid}`;
-        color = getColorForProcess(pid, "WAITING");
-      } else if (hasAccessed) {
-        label = pid;
-        color = getColorForProcess(pid, "ACCESSED");
-      } else if (hasWaiting) {
-        label = "";
-        color = getColorForProcess(pid, "WAITING");
-      } else if (hasNew) {
-        label = `NW - ${pid}`;
-        color = "transparent";
+  // Ctrl + rueda: zoom horizontal anclado en el ciclo bajo el cursor
+  scroll.addEventListener(
+    "wheel",
+    (e) => {
+      if (!e.ctrlKey && !e.metaKey) return;
+      e.preventDefault();
+      const rect = scroll.getBoundingClientRect();
+      zoomGantt(Math.exp(-e.deltaY * 0.002), e.clientX - rect.left);
+    },
+    { passive: false }
+  );
+
+  // Arrastrar para desplazarse
+  let drag = null;
+  scroll.addEventListener("pointerdown", (e) => {
+    // El arrastre táctil ya desplaza de forma nativa; se ignoran también las barras de scroll
+    const rect = scroll.getBoundingClientRect();
+    if (e.pointerType !== "mouse" || e.button !== 0) return;
+    if (e.clientX - rect.left >= scroll.clientWidth || e.clientY - rect.top >= scroll.clientHeight) return;
+    drag = { x: e.clientX, y: e.clientY, left: scroll.scrollLeft, top: scroll.scrollTop };
+    scroll.setPointerCapture(e.pointerId);
+    scroll.classList.add("dragging");
+  });
+  scroll.addEventListener("pointermove", (e) => {
+    if (!drag) return;
+    scroll.scrollLeft = drag.left - (e.clientX - drag.x);
+    scroll.scrollTop = drag.top - (e.clientY - drag.y);
+  });
+  const endDrag = () => {
+    drag = null;
+    scroll.classList.remove("dragging");
+  };
+  scroll.addEventListener("pointerup", endDrag);
+  scroll.addEventListener("pointercancel", endDrag);
+
+  if (window.ResizeObserver) {
+    new ResizeObserver(scheduleGanttRender).observe(scroll);
+  } else {
+    window.addEventListener("resize", scheduleGanttRender);
+  }
+}
+
+/**
+ * Cambia el ancho de celda manteniendo fijo el ciclo que está en `anchorX` (px del viewport).
+ */
+function zoomGantt(factor, anchorX) {
+  const scroll = document.getElementById("gantt-scroll");
+  if (anchorX === undefined) anchorX = scroll.clientWidth / 2;
+  const plotX = Math.max(0, anchorX - GANTT_LABEL_WIDTH);
+  const anchorCycle = (scroll.scrollLeft + plotX) / gantt.cellWidth;
+
+  const maxByScroll = GANTT_MAX_SCROLL_SIZE / Math.max(1, gantt.maxCycle + 1);
+  gantt.cellWidth = Math.min(
+    GANTT_MAX_CELL_WIDTH,
+    maxByScroll,
+    Math.max(GANTT_MIN_CELL_WIDTH, gantt.cellWidth * factor)
+  );
+
+  updateGanttSpacer();
+  scroll.scrollLeft = anchorCycle * gantt.cellWidth - plotX;
+  scheduleGanttRender();
+}
+
+// Ajusta el espaciador al tamaño total del diagrama para que el scroll nativo sirva de paneo
+function updateGanttSpacer() {
+  const viewport = document.getElementById("gantt-viewport");
+  const scroll = document.getElementById("gantt-scroll");
+  const spacer = document.getElementById("gantt-spacer");
+  const columns = gantt.maxCycle + 1;
+
+  const maxByScroll = GANTT_MAX_SCROLL_SIZE / Math.max(1, columns);
+  if (gantt.cellWidth > maxByScroll) gantt.cellWidth = maxByScroll;
+
+  const width = GANTT_LABEL_WIDTH + Math.max(0, columns) * gantt.cellWidth;
+  const height = GANTT_HEADER_HEIGHT + gantt.rows.length * GANTT_ROW_HEIGHT;
+  spacer.style.width = `${Math.ceil(width)}px`;
+  spacer.style.height = `${height}px`;
+  // Con pocos procesos el área se ajusta a las filas (más el espacio de la barra de scroll)
+  viewport.style.height = `min(25rem, ${height + 18}px)`;
+
+  if (gantt.followTail) {
+    scroll.scrollLeft = scroll.scrollWidth;
+  }
+}
+
+function scheduleGanttRender() {
+  if (gantt.renderPending) return;
+  gantt.renderPending = true;
+  requestAnimationFrame(() => {
+    gantt.renderPending = false;
+    if (gantt.spacerDirty) {
+      gantt.spacerDirty = false;
+      updateGanttSpacer();
+    }
+    drawGantt();
+  });
+}
+
+/**
+ * Actualiza el espaciador y dibuja el viewport en el próximo frame de animación.
+ * Se llama tras recibir eventos; varias llamadas por frame se agrupan en un solo dibujo.
+ */
+function renderGantt() {
+  initializeGantt();
+  gantt.spacerDirty = true;
+  scheduleGanttRender();
+}
+
+// Etiqueta y estado dominante de una celda, con las mismas reglas de prioridad de la tabla
+function describeGanttCell(pid, flags) {
+  const hasNew = flags & (1 << STATE_NEW);
+  const hasAccessed = flags & (1 << STATE_ACCESSED);
+  const hasTerminated = flags & (1 << STATE_TERMINATED);
+
+  if (hasTerminated) return `TD - ${pid}`;
+  if (hasNew) return `NW - ${pid}`;
+  if (hasAccessed) return pid;
+  return "";
+}
+
+// Paso entre etiquetas del encabezado: 1, 2, 5, 10, 20, 50...
+function headerStep(cellWidth) {
+  const minSpacing = 48;
+  let step = 1;
+  while (step * cellWidth < minSpacing) {
+    const digit = String(step)[0];
+    step *= digit === "2" ? 2.5 : 2;
+  }
+  return step;
+}
+
+function drawGantt() {
+  const scroll = document.getElementById("gantt-scroll");
+  const canvas = document.getElementById("gantt-canvas");
+  if (!scroll || !canvas) return;
+
+  if (gantt.orderDirty) {
+    gantt.order.sort((a, b) => comparePids(gantt.rows[a].pid, gantt.rows[b].pid));
+    gantt.orderDirty = false;
+  }
+
+  const viewWidth = scroll.clientWidth;
+  const viewHeight = scroll.clientHeight;
+  const dpr = window.devicePixelRatio || 1;
+  if (canvas.width !== Math.round(viewWidth * dpr) || canvas.height !== Math.round(viewHeight * dpr)) {
+    canvas.width = Math.round(viewWidth * dpr);
+    canvas.height = Math.round(viewHeight * dpr);
+    canvas.style.width = `${viewWidth}px`;
+    canvas.style.height = `${viewHeight}px`;
+  }
+
+  const ctx = canvas.getContext("2d");
+  ctx.setTransform(dpr, 0, 0, dpr, 0, 0);
+  ctx.clearRect(0, 0, viewWidth, viewHeight);
+  ctx.font = "bold 12px 'Segoe UI', Tahoma, sans-serif";
+  ctx.textAlign = "center";
+  ctx.textBaseline = "middle";
+  if (gantt.rows.length === 0) return;
+
+  const cellWidth = gantt.cellWidth;
+  const scrollLeft = scroll.scrollLeft;
+  const scrollTop = scroll.scrollTop;
+  const plotWidth = viewWidth - GANTT_LABEL_WIDTH;
+  const plotHeight = viewHeight - GANTT_HEADER_HEIGHT;
+
+  // Rango visible de ciclos y filas
+  const firstCycle = Math.max(0, Math.floor(scrollLeft / cellWidth));
+  const lastCycle = Math.min(gantt.maxCycle + 1, Math.ceil((scrollLeft + plotWidth) / cellWidth));
+  const firstRow = Math.max(0, Math.floor(scrollTop / GANTT_ROW_HEIGHT));
+  const lastRow = Math.min(gantt.order.length, Math.ceil((scrollTop + plotHeight) / GANTT_ROW_HEIGHT));
+  const showLabels = cellWidth >= GANTT_LABEL_MIN_CELL_WIDTH;
+  const cycleX = (c) => GANTT_LABEL_WIDTH + c * cellWidth - scrollLeft;
+
+  ctx.save();
+  ctx.beginPath();
+  ctx.rect(GANTT_LABEL_WIDTH, GANTT_HEADER_HEIGHT, plotWidth, plotHeight);
+  ctx.clip();
+
+  const visibleCycles = Math.max(0, lastCycle - firstCycle);
+  const flags = showLabels ? new Uint8Array(visibleCycles) : null;
+  const actionsByCycle = showLabels ? new Array(visibleCycles) : null;
+
+  for (let r = firstRow; r < lastRow; r++) {
+    const row = gantt.rows[gantt.order[r]];
+    const y = GANTT_HEADER_HEIGHT + r * GANTT_ROW_HEIGHT - scrollTop;
+    const from = lowerBound(row.starts, firstCycle - row.maxSpan);
+    const to = lowerBound(row.starts, lastCycle);
+
+    // Primero las esperas (tono opaco), luego I/O y cambios de contexto y encima accesos/terminación
+    for (let pass = 0; pass < GANTT_PASSES.length; pass++) {
+      ctx.fillStyle = getColorForProcess(row.pid, GANTT_PASSES[pass]);
+      let lastPixel = -Infinity;
+      for (let k = from; k < to; k++) {
+        const state = row.states[k];
+        if (state === STATE_NEW || !state) continue;
+        if ((state in ganttPass ? ganttPass[state] : GANTT_PASSES.length - 1) !== pass) continue;
+        if (row.ends[k] <= firstCycle) continue;
+
+        const x0 = cycleX(row.starts[k]);
+        const x1 = cycleX(row.ends[k]);
+        // Con zoom alejado varios intervalos caen en el mismo píxel: se dibuja uno
+        if (x1 <= lastPixel) continue;
+        const start = Math.max(x0, lastPixel);
+        ctx.fillRect(start, y + 1, Math.max(1, x1 - start), GANTT_ROW_HEIGHT - 2);
+        lastPixel = Math.ceil(x1);
       }
+    }
 
-      let actionText = "";
-      const actionEvent = matching.find(
-        (e) => e.action && e.action !== "NONE" && e.state !== "WAITING"
-      );
-      if (actionEvent) {
-        actionText = ` (${actionEvent.action})`;
+    if (showLabels) {
+      flags.fill(0);
+      actionsByCycle.fill(undefined);
+      for (let k = from; k < to; k++) {
+        const c0 = Math.max(row.starts[k], firstCycle);
+        const c1 = Math.min(row.ends[k], lastCycle);
+        for (let c = c0; c < c1; c++) {
+          flags[c - firstCycle] |= 1 << row.states[k];
+          if (row.actions[k] && row.states[k] !== STATE_WAITING) {
+            actionsByCycle[c - firstCycle] = row.actions[k];
+          }
+        }
       }
 
-      row += `<td style="background:${color}; color:#000;">${label}${actionText}</td>`;
+      ctx.fillStyle = "#000";
+      for (let i = 0; i < visibleCycles; i++) {
+        let label = describeGanttCell(row.pid, flags[i]);
+        if (actionsByCycle[i]) label += ` (${actionsByCycle[i]})`;
+        if (!label) continue;
+        ctx.fillText(
+          fitText(ctx, label, cellWidth - 4),
+          cycleX(firstCycle + i) + cellWidth / 2,
+          y + GANTT_ROW_HEIGHT / 2
+        );
+      }
     }
-    row += "</tr>";
-    table.innerHTML += row;
-  });
+
+    ctx.strokeStyle = "#ddd";
+    ctx.beginPath();
+    ctx.moveTo(GANTT_LABEL_WIDTH, y + GANTT_ROW_HEIGHT - 0.5);
+    ctx.lineTo(viewWidth, y + GANTT_ROW_HEIGHT - 0.5);
+    ctx.stroke();
+  }
+
+  // Bordes de celda cuando el zoom deja espacio para verlos
+  if (cellWidth >= 8) {
+    ctx.strokeStyle = "#ddd";
+    ctx.beginPath();
+    for (let c = firstCycle; c <= lastCycle; c++) {
+      const x = Math.round(cycleX(c)) + 0.5;
+      ctx.moveTo(x, GANTT_HEADER_HEIGHT);
+      ctx.lineTo(x, viewHeight);
+    }
+    ctx.stroke();
+  }
+  ctx.restore();
+
+  // Encabezado de ciclos
+  ctx.fillStyle = "#2c3e50";
+  ctx.fillRect(0, 0, viewWidth, GANTT_HEADER_HEIGHT);
+  ctx.save();
+  ctx.beginPath();
+  ctx.rect(GANTT_LABEL_WIDTH, 0, plotWidth, GANTT_HEADER_HEIGHT);
+  ctx.clip();
+  ctx.fillStyle = "#fff";
+  const step = headerStep(cellWidth);
+  for (let c = Math.floor(firstCycle / step) * step; c < lastCycle; c += step) {
+    ctx.fillText(String(c), cycleX(c) + Math.max(cellWidth, 1) / 2, GANTT_HEADER_HEIGHT / 2);
+  }
+  ctx.restore();
+
+  // Columna de PIDs
+  ctx.fillStyle = "#fff";
+  ctx.fillRect(0, GANTT_HEADER_HEIGHT, GANTT_LABEL_WIDTH, plotHeight);
+  ctx.fillStyle = "#fff";
+  ctx.fillText("Proceso/Ciclo", GANTT_LABEL_WIDTH / 2, GANTT_HEADER_HEIGHT / 2);
+
+  ctx.save();
+  ctx.beginPath();
+  ctx.rect(0, GANTT_HEADER_HEIGHT, GANTT_LABEL_WIDTH, plotHeight);
+  ctx.clip();
+  ctx.fillStyle = "#333";
+  for (let r = firstRow; r < lastRow; r++) {
+    const row = gantt.rows[gantt.order[r]];
+    const y = GANTT_HEADER_HEIGHT + r * GANTT_ROW_HEIGHT - scrollTop;
+    ctx.fillText(fitText(ctx, row.pid, GANTT_LABEL_WIDTH - 8), GANTT_LABEL_WIDTH / 2, y + GANTT_ROW_HEIGHT / 2);
+  }
+  ctx.restore();
+
+  ctx.strokeStyle = "#ddd";
+  ctx.beginPath();
+  ctx.moveTo(GANTT_LABEL_WIDTH - 0.5, 0);
+  ctx.lineTo(GANTT_LABEL_WIDTH - 0.5, viewHeight);
+  ctx.stroke();
+}
+
+// Recorta el texto con "…" si no cabe en `maxWidth`
+function fitText(ctx, text, maxWidth) {
+  if (ctx.measureText(text).width <= maxWidth) return text;
+  let end = text.length;
+  while (end > 0 && ctx.measureText(text.slice(0, end) + "…").width > maxWidth) end--;
+  return end > 0 ? text.slice(0, end) + "…" : "";
+}
+
+/**
+ * Limpia el diagrama (datos, leyenda y canvas).
+ */
+function resetGantt() {
+  gantt.rows.length = 0;
+  gantt.rowByPid.clear();
+  gantt.order.length = 0;
+  gantt.orderDirty = false;
+  gantt.maxCycle = -1;
+  gantt.followTail = true;
+  document.getElementById("gantt-legend").innerHTML = "";
+  const scroll = document.getElementById("gantt-scroll");
+  if (scroll) {
+    scroll.scrollLeft = 0;
+    scroll.scrollTop = 0;
+  }
+  renderGantt();
 }
 
 function renderMetricsTable() {
@@ -255,25 +663,28 @@ function initializeSimulationSheduling() {
   simulationStatus.textContent = "Estado: Esperando configuración";
   document.getElementById("algorithm-used").textContent = "Algoritmo: --";
   processMetrics.length = 0;
-  events.length = 0;
+  resetGantt();
 
   const config = JSON.parse(localStorage.getItem("lastShConfig")) || {
     algorithm: "FIFO",
   };
+  const workload = JSON.parse(localStorage.getItem("lastShWorkload"));
 
   ws = new WebSocket("ws://127.0.0.1:8000/ws/simulation-scheduling");
 
   ws.onopen = () => {
     console.log("Conexión WebSocket establecida.");
     console.log("Configuración de simulación:", config);
-    ws.send(JSON.stringify(config));
+    // Pedir un frame por ciclo (el servidor los reenvía sin volver a parsearlos) y enviar la carga
+    // subida en línea, sin pasar por los archivos compartidos de data/input
+    ws.send(JSON.stringify({ ...config, ...(workload && { workload }), frames: 1 }));
     document.getElementById(
       "algorithm-used"
     ).textContent = `Algoritmo: ${config.algorithm}`;
 
     // mostrar quantum si aplica
     const quantumContainer = document.getElementById("quantum-info");
-    if (config.algorithm === "RR" && config.quantum) {
+    if (["RR", "LOTTERY", "STRIDE"].includes(config.algorithm) && config.quantum) {
       quantumContainer.textContent = `Quantum: ${config.quantum}`;
       quantumContainer.style.display = "block";
     } else {
@@ -295,36 +706,46 @@ function initializeSimulationSheduling() {
   ws.onmessage = (event) => {
     const data = JSON.parse(event.data);
 
-    if (data.event === "SIMULATION_END") {
-      ws.close();
-      cycleCounter.textContent = `Ciclo Actual: ${currentCycle}`;
-      simulationStatus.textContent = "Estado: Finalizado";
-      renderMetricsTable();
-      return;
+    // Un frame por ciclo trae todos los eventos del ciclo; el Gantt se dibuja una vez por mensaje
+    const batch = data.type === "CYCLE" ? data.events : [data];
+    let timelineChanged = false;
+
+    for (const item of batch) {
+      if (item.event === "SIMULATION_END") {
+        ws.close();
+        cycleCounter.textContent = `Ciclo Actual: ${currentCycle}`;
+        simulationStatus.textContent = "Estado: Finalizado";
+        renderMetricsTable();
+        return;
+      }
+
+      if (item.event === "PROCESS_METRIC") {
+        processMetrics.push(item);
+      } else if (item.pid) {
+        currentCycle = item.endCycle;
+        addGanttEvent(item);
+        timelineChanged = true;
+      }
+
+      if (item.event === "CONFIG") {
+        mechanismUsed = item.mechanism;
+        document.getElementById(
+          "mechanism-used"
+        ).textContent = `Mecanismo: ${mechanismUsed}`;
+      } else if (item.event === "RESOURCE_LOADED") {
+        resourcesLoaded.push(item);
+        renderResourcesTable();
+      } else if (item.event === "ACTION_LOADED") {
+        actionsLoaded.push(item);
+        renderActionsTable();
+      }
     }
 
-    if (data.event === "PROCESS_METRIC") {
-      processMetrics.push(data);
-    } else if (data.pid) {
-      currentCycle = data.endCycle;
-      events.push(data);
-      renderGanttTable(events);
+    if (timelineChanged) {
+      renderGantt();
       cycleCounter.textContent = `Ciclo Actual: ${currentCycle}`;
       simulationStatus.textContent = "Estado: En proceso";
     }
-
-    if (data.event === "CONFIG") {
-      mechanismUsed = data.mechanism;
-      document.getElementById(
-        "mechanism-used"
-      ).textContent = `Mecanismo: ${mechanismUsed}`;
-    } else if (data.event === "RESOURCE_LOADED") {
-      resourcesLoaded.push(data);
-      renderResourcesTable();
-    } else if (data.event === "ACTION_LOADED") {
-      actionsLoaded.push(data);
-      renderActionsTable();
-    }
   };
 
   ws.onerror = (err) => {
@@ -342,50 +763,60 @@ function initializeSimulationSync() {
   simulationStatus.textContent = "Estado: Esperando configuración";
   document.getElementById("mechanism-used").textContent = "Mecanismo: --";
   processMetrics.length = 0;
-  events.length = 0;
+  resetGantt();
   actionsLoaded.length = 0;
   resourcesLoaded.length = 0;
 
   const config = JSON.parse(localStorage.getItem("lastSyncConfig")) || {
     useMutex: 1,
   };
+  const workload = JSON.parse(localStorage.getItem("lastSyncWorkload"));
 
   ws = new WebSocket("ws://127.0.0.1:8000/ws/simulation-synchronization");
 
   ws.onopen = () => {
     console.log("Conexión WebSocket establecida.");
     console.log("Configuración de simulación:", config);
-    ws.send(JSON.stringify(config));
+    // Pedir un frame por ciclo y enviar la carga subida en línea
+    ws.send(JSON.stringify({ ...config, ...(workload && { workload }), frames: 1 }));
   };
 
   ws.onmessage = (event) => {
     const data = JSON.parse(event.data);
+    const batch = data.type === "CYCLE" ? data.events : [data];
+    let timelineChanged = false;
+
+    for (const item of batch) {
+      if (item.event === "SIMULATION_END") {
+        ws.close();
+        cycleCounter.textContent = `Ciclo Actual: ${currentCycle}`;
+        simulationStatus.textContent = "Estado: Finalizado";
+        renderMetricsTable();
+        return;
+      }
 
-    if (data.event === "SIMULATION_END") {
-      ws.close();
-      cycleCounter.textContent = `Ciclo Actual: ${currentCycle}`;
-      simulationStatus.textContent = "Estado: Finalizado";
-      renderMetricsTable();
-      return;
+      if (item.event === "CONFIG") {
+        mechanismUsed = item.mechanism;
+        document.getElementById(
+          "mechanism-used"
+        ).textContent = `Mecanismo: ${mechanismUsed}`;
+      } else if (item.event === "RESOURCE_LOADED") {
+        resourcesLoaded.push(item);
+        renderResourcesTable();
+      } else if (item.event === "ACTION_LOADED") {
+        actionsLoaded.push(item);
+        renderActionsTable();
+      } else if (item.event === "PROCESS_METRIC") {
+        processMetrics.push(item);
+      } else if (item.pid && "startCycle" in item && "endCycle" in item) {
+        currentCycle = item.endCycle;
+        addGanttEvent(item);
+        timelineChanged = true;
+      }
     }
 
-    if (data.event === "CONFIG") {
-      mechanismUsed = data.mechanism;
-      document.getElementById(
-        "mechanism-used"
-      ).textContent = `Mecanismo: ${mechanismUsed}`;
-    } else if (data.event === "RESOURCE_LOADED") {
-      resourcesLoaded.push(data);
-      renderResourcesTable();
-    } else if (data.event === "ACTION_LOADED") {
-      actionsLoaded.push(data);
-      renderActionsTable();
-    } else if (data.event === "PROCESS_METRIC") {
-      processMetrics.push(data);
-    } else if (data.pid && "startCycle" in data && "endCycle" in data) {
-      currentCycle = data.endCycle;
-      events.push(data);
-      renderGanttTable(events);
+    if (timelineChanged) {
+      renderGantt();
       cycleCounter.textContent = `Ciclo Actual: ${currentCycle}`;
       simulationStatus.textContent = "Estado: En proceso";
     }
@@ -414,13 +845,10 @@ function resetScheduling() {
   // Limpiar estado visual
   cycleCounter.textContent = "Ciclo Actual: --";
   simulationStatus.textContent = "Estado: Reiniciado";
-  document.getElementById("gantt-table").innerHTML = "";
-  document.getElementById("gantt-legend").innerHTML = "";
   document.getElementById("metrics-table").innerHTML = "";
   document.getElementById("metrics-average").textContent = "";
 
   // Limpiar datos
-  events.length = 0;
   processMetrics.length = 0;
   currentCycle = 0;
   colorIndex = 0;
@@ -437,15 +865,12 @@ function resetSync() {
 
   cycleCounter.textContent = "Ciclo Actual: --";
   simulationStatus.textContent = "Estado: Reiniciado";
-  document.getElementById("gantt-table").innerHTML = "";
-  document.getElementById("gantt-legend").innerHTML = "";
   document.getElementById("metrics-table").innerHTML = "";
   document.getElementById("metrics-average").textContent = "";
   document.getElementById("resources-table").innerHTML = "";
   document.getElementById("actions-table").innerHTML = "";
   document.getElementById("mechanism-used").textContent = "Mecanismo: --";
 
-  events.length = 0;
   processMetrics.length = 0;
   actionsLoaded.length = 0;
   resourcesLoaded.length = 0;
@@ -475,19 +900,16 @@ function returnHome() {
 }
 
 function downloadScreenshot() {
+  // El Gantt es un canvas virtualizado: se captura la vista actual (zoom y desplazamiento)
   const element = document.getElementById("simulation-report");
-  const ganttScroll = document.getElementById("gantt-scroll");
   const metricsScroll = document.getElementById("metrics-scroll");
 
   // Guardar estilos originales
   const originalReportStyle = element.style.cssText;
-  const originalGanttStyle = ganttScroll.style.cssText;
   const originalMetricsStyle = metricsScroll.style.cssText;
 
   // Aplicar estilos temporales para expandir completamente
   element.style.width = "max-content";
-  ganttScroll.style.maxHeight = "none";
-  ganttScroll.style.overflow = "visible";
   metricsScroll.style.maxHeight = "none";
   metricsScroll.style.overflow = "visible";
 
@@ -508,7 +930,6 @@ function downloadScreenshot() {
 
       // Restaurar estilos originales
       element.style.cssText = originalReportStyle;
-      ganttScroll.style.cssText = originalGanttStyle;
       metricsScroll.style.cssText = originalMetricsStyle;
     });
   }, 100);
@@ -516,7 +937,12 @@ function downloadScreenshot() {
 
 function toggleGanttOrder() {
   sortGanttByPID = !sortGanttByPID;
-  renderGanttTable(events);
+  gantt.orderDirty = sortGanttByPID;
+  if (!sortGanttByPID) {
+    // Volver al orden de llegada
+    gantt.order = gantt.rows.map((_, i) => i);
+  }
+  scheduleGanttRender();
 
   const ganttBtn = document.querySelector(
     "button[onclick='toggleGanttOrder()']"
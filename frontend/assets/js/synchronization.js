@@ -52,7 +52,7 @@ function validateSyncTxtContent(type, content) {
  *
  * @param {File} file - Objeto `File` del input HTML.
  * @param {string} type - Tipo del archivo: "procesos", "recursos" o "acciones".
- * @return {Promise<boolean>} Promesa que resuelve en `true` si el contenido es válido; de lo contrario, `false`.
+ * @return {Promise<Array<Object>|null>} Promesa que resuelve en las entradas del archivo si el contenido es válido; de lo contrario, `null`.
  */
 async function validateAndReadSyncFile(file, type) {
   return new Promise((resolve) => {
@@ -60,7 +60,7 @@ async function validateAndReadSyncFile(file, type) {
     reader.onload = (e) => {
       const content = e.target.result;
       const isValid = validateSyncTxtContent(type, content);
-      resolve(isValid);
+      resolve(isValid ? parseWorkloadFile(type, content) : null);
     };
     reader.readAsText(file);
   });
@@ -69,9 +69,10 @@ async function validateAndReadSyncFile(file, type) {
 /**
  * Valida la selección, nombre y formato de los archivos requeridos (procesos.txt, recursos.txt, acciones.txt).
  * Verifica que el contenido de cada archivo sea válido.
- * Si todo es correcto, sube los archivos al backend y muestra alertas según el resultado.
+ * Si todo es correcto, guarda la carga en localStorage para enviarla en línea con la configuración
+ * de la simulación (sin escribir archivos compartidos en el servidor).
  *
- * @return {Promise<void>} No retorna valor, pero gestiona todo el proceso de validación y subida.
+ * @return {Promise<void>} No retorna valor, pero gestiona todo el proceso de validación y carga.
  */
 async function uploadAllSyncFiles() {
   const files = {
@@ -115,29 +116,20 @@ async function uploadAllSyncFiles() {
     return;
   }
 
-  const validations = await Promise.all([
+  const [processes, resources, actions] = await Promise.all([
     validateAndReadSyncFile(files.procesos, "procesos"),
     validateAndReadSyncFile(files.recursos, "recursos"),
     validateAndReadSyncFile(files.acciones, "acciones"),
   ]);
 
-  if (validations.includes(false)) return;
+  if (!processes || !resources || !actions) return;
 
-  const formData = new FormData();
-  formData.append("files", files.procesos);
-  formData.append("files", files.recursos);
-  formData.append("files", files.acciones);
-
-  const response = await fetch("/uploadFiles/", {
-    method: "POST",
-    body: formData,
-  });
+  localStorage.setItem(
+    "lastSyncWorkload",
+    JSON.stringify({ processes, resources, actions })
+  );
 
-  if (response.ok) {
-    showAlert("Éxito", "Archivos subidos correctamente.", "success");
-    allowAccess();
-    setTimeout(() => (window.location.href = "/config-synchronization"), 1500);
-  } else {
-    showAlert("Error", "Error al subir los archivos.", "error");
-  }
+  showAlert("Éxito", "Archivos cargados correctamente.", "success");
+  allowAccess();
+  setTimeout(() => (window.location.href = "/config-synchronization"), 1500);
 }
@@ -1,10 +1,11 @@
-from fastapi import FastAPI, Request, UploadFile, File, Cookie, WebSocket, WebSocketDisconnect
+from fastapi import FastAPI, Request, Cookie, WebSocket, WebSocketDisconnect
 from fastapi.responses import HTMLResponse, RedirectResponse
 from fastapi.staticfiles import StaticFiles
 from fastapi.templating import Jinja2Templates
 import asyncio
+import collections
+import itertools
 import os
-import shutil
 import json
 from dotenv import load_dotenv
 
@@ -21,13 +22,281 @@ app.mount("/static", StaticFiles(directory="assets"), name="static")
 templates = Jinja2Templates(directory="templates")
 
 # Directorios para archivos de entrada/salida
-DATA_INPUT_DIR = "../data/input/"
 DATA_OUTPUT_DIR = "../data/output/"
 ENVIRONMENT = os.getenv("ENVIRONMENT", "prod")
 LOG_SH = "scheduling_simulator.log"
 LOG_SYNC = "synchronization_simulator.log"
 BIN_SH = "../backend/bin/scheduling-simulator"
 BIN_SYNC = "../backend/bin/synchronization-simulator"
+# Socket del daemon de simulación (vacío: se lanza un proceso por conexión)
+DAEMON_SOCKET = os.getenv("SIMULATOR_DAEMON_SOCKET", "")
+# Límites de la cola de cada cliente WebSocket (mensajes pendientes y bytes)
+RELAY_QUEUE_SIZE = int(os.getenv("RELAY_QUEUE_SIZE", "256"))
+RELAY_QUEUE_BYTES = int(os.getenv("RELAY_QUEUE_BYTES", str(8 * 1024 * 1024)))
+# Largo máximo de una línea de la simulación (un frame trae todos los eventos de un ciclo)
+STREAM_LINE_LIMIT = 16 * 1024 * 1024
+
+FRAME_PREFIX = '{"type": "CYCLE", "cycle": '
+FRAME_EVENTS = ', "events": ['
+
+# Tipos de mensaje en la cola: frames y eventos de la línea de tiempo se pueden fusionar o
+# descartar; el resto (configuración, métricas, fin) siempre se entrega
+KIND_FRAME = "frame"
+KIND_EVENT = "event"
+KIND_KEEP = "keep"
+
+# Claves de la configuración de calendarización que se reenvían al simulador (el resto se descarta)
+SCHEDULING_KEYS = (
+    "algorithm", "quantum", "isPreemptive", "priorityQuantum", "frames",
+    "contextSwitchCost", "warmupCost", "warmupWindow", "seed", "shareWindow", "tickets",
+    "checkpointInterval", "seek", "checkpointDir", "telemetryWindow", "whatIf", "tune", "workload",
+)
+
+# Contadores de las retransmisiones activas, por cliente
+activeRelays = {}
+relayIds = itertools.count(1)
+
+
+def traceOption(value):
+    """Valor de "trace" que se reenvía: true o un nombre de archivo sin "/" ni ".." (None: se descarta).
+
+    El simulador escribe la traza en ../data/output, así que el cliente no elige dónde se escribe.
+    """
+    if value is True:
+        return True
+    if isinstance(value, str) and value and "/" not in value and "\\" not in value and ".." not in value:
+        return value
+    return None
+
+
+def filterSchedulingConfig(config: dict) -> dict:
+    """Configuración de calendarización con solo las claves permitidas"""
+    forwarded = {key: config[key] for key in SCHEDULING_KEYS if key in config}
+    trace = traceOption(config.get("trace"))
+    if trace is not None:
+        forwarded["trace"] = trace
+    return forwarded
+
+
+async def openSimulation(binary: str, mode: str, configLine: str):
+    """Inicia una sesión de simulación y devuelve (stdout, proceso, conexión).
+
+    Si el daemon está disponible la sesión se atiende por su socket: el proceso es None y la
+    conexión debe mantenerse abierta hasta leer toda la salida. Si no, se lanza el binario,
+    se le envía la configuración por stdin y la conexión es None.
+    """
+    if DAEMON_SOCKET and os.path.exists(DAEMON_SOCKET):
+        try:
+            reader, writer = await asyncio.open_unix_connection(DAEMON_SOCKET, limit=STREAM_LINE_LIMIT)
+            request = json.loads(configLine)
+            request["mode"] = mode
+            writer.write((json.dumps(request) + "\n").encode())
+            await writer.drain()
+            return reader, None, writer
+        except OSError as e:
+            print(f"Daemon no disponible ({e}), se usará un proceso nuevo.")
+
+    process = await asyncio.create_subprocess_exec(
+        binary,
+        stdin=asyncio.subprocess.PIPE,
+        stdout=asyncio.subprocess.PIPE,
+        stderr=asyncio.subprocess.PIPE,
+        limit=STREAM_LINE_LIMIT,
+    )
+    if process.stdin:
+        process.stdin.write((configLine + "\n").encode())
+        await process.stdin.drain()
+        process.stdin.close()
+    else:
+        print("Error: process.stdin es None")
+    return process.stdout, process, None
+
+
+def splitFrame(text: str):
+    """Separa un frame en (ciclo, contenido del arreglo de eventos) sin parsear el JSON."""
+    eventsStart = text.index(FRAME_EVENTS)
+    cycle = int(text[len(FRAME_PREFIX):eventsStart])
+    return cycle, text[eventsStart + len(FRAME_EVENTS):-2]
+
+
+def buildFrame(cycle: int, events: str) -> str:
+    return f"{FRAME_PREFIX}{cycle}{FRAME_EVENTS}{events}]}}"
+
+
+class ClientQueue:
+    """Cola acotada entre el lector de la simulación y un cliente WebSocket.
+
+    El lector nunca espera al cliente. Si el cliente se atrasa, los frames por ciclo pendientes
+    se fusionan en uno solo (sin perder eventos) y, al superar el límite de mensajes o de bytes,
+    se descartan los eventos de la línea de tiempo más antiguos. Las métricas, la configuración
+    y el fin de la simulación nunca se descartan.
+    """
+
+    def __init__(self, maxItems: int, maxBytes: int):
+        self.items = collections.deque()  # [texto, tipo, ciclo]
+        self.bytes = 0
+        self.maxItems = maxItems
+        self.maxBytes = maxBytes
+        self.ready = asyncio.Event()
+        self.closed = False
+        self.stats = {
+            "queued": 0,
+            "maxQueued": 0,
+            "sent": 0,
+            "coalesced": 0,
+            "droppedEvents": 0,
+            "producedCycle": -1,
+            "sentCycle": -1,
+            "lagCycles": 0,
+        }
+
+    def put(self, text: str, kind: str, cycle: int = -1):
+        if self.closed:
+            return
+        if cycle > self.stats["producedCycle"]:
+            self.stats["producedCycle"] = cycle
+
+        tail = self.items[-1] if self.items else None
+        if kind == KIND_FRAME and tail and tail[1] == KIND_FRAME:
+            # Cliente atrasado: fusionar con el frame que aún no se envía
+            _, oldEvents = splitFrame(tail[0])
+            _, newEvents = splitFrame(text)
+            merged = buildFrame(cycle, ", ".join(e for e in (oldEvents, newEvents) if e))
+            self.bytes += len(merged) - len(tail[0])
+            tail[0], tail[2] = merged, cycle
+            self.stats["coalesced"] += 1
+        else:
+            if kind == KIND_EVENT and len(self.items) >= self.maxItems:
+                self.dropOldest()
+            self.items.append([text, kind, cycle])
+            self.bytes += len(text)
+
+        while self.bytes > self.maxBytes and self.dropOldest():
+            pass
+        self.updateStats()
+        self.ready.set()
+
+    def dropOldest(self) -> bool:
+        """Descarta los eventos de la línea de tiempo más antiguos; devuelve False si no hay."""
+        for index, item in enumerate(self.items):
+            if item[1] == KIND_EVENT:
+                del self.items[index]
+                self.bytes -= len(item[0])
+                self.stats["droppedEvents"] += 1
+                return True
+            if item[1] == KIND_FRAME:
+                # Conservar solo las métricas del frame; el resto de sus eventos se descarta
+                frame = json.loads(item[0])
+                kept = [e for e in frame["events"] if "event" in e]
+                self.stats["droppedEvents"] += len(frame["events"]) - len(kept)
+                self.bytes -= len(item[0])
+                if kept:
+                    item[0] = json.dumps({"type": "CYCLE", "cycle": frame["cycle"], "events": kept})
+                    item[1] = KIND_KEEP
+                    self.bytes += len(item[0])
+                else:
+                    del self.items[index]
+                return True
+        return False
+
+    async def get(self):
+        """Devuelve el siguiente mensaje, o None al cerrarse la cola sin pendientes."""
+        while not self.items:
+            if self.closed:
+                return None
+            self.ready.clear()
+            await self.ready.wait()
+        text, _, cycle = self.items.popleft()
+        self.bytes -= len(text)
+        self.stats["sent"] += 1
+        if cycle > self.stats["sentCycle"]:
+            self.stats["sentCycle"] = cycle
+        self.updateStats()
+        return text
+
+    def close(self):
+        self.closed = True
+        self.ready.set()
+
+    def updateStats(self):
+        self.stats["queued"] = len(self.items)
+        self.stats["maxQueued"] = max(self.stats["maxQueued"], len(self.items))
+        self.stats["lagCycles"] = max(0, self.stats["producedCycle"] - self.stats["sentCycle"])
+
+
+def classifyLine(decodedLine: str, passthrough: bool):
+    """Devuelve (texto a enviar, tipo, ciclo) para una línea de la simulación, o None si no es JSON."""
+    if passthrough:
+        if decodedLine.startswith(FRAME_PREFIX):
+            return decodedLine, KIND_FRAME, splitFrame(decodedLine)[0]
+        if decodedLine.startswith("{"):
+            return decodedLine, KIND_KEEP, -1
+        return None
+
+    try:
+        eventData = json.loads(decodedLine)
+    except json.JSONDecodeError:
+        return None
+    if not isinstance(eventData, dict):
+        return json.dumps(eventData), KIND_KEEP, -1
+    if eventData.get("type") == "CYCLE":
+        return json.dumps(eventData), KIND_FRAME, eventData.get("cycle", -1)
+    if "startCycle" in eventData and "event" not in eventData:
+        return json.dumps(eventData), KIND_EVENT, eventData.get("endCycle", -1)
+    return json.dumps(eventData), KIND_KEEP, -1
+
+
+async def relaySimulation(websocket: WebSocket, stdout, log_file, passthrough: bool):
+    """Reenvía la salida de la simulación al cliente a través de una ClientQueue.
+
+    La lectura de stdout (y el log) avanza a su propio ritmo; el envío corre en otra tarea,
+    así que un navegador lento no frena la simulación. Al terminar se envían los contadores
+    de atraso del cliente (RELAY_STATS).
+    """
+    relayId = next(relayIds)
+    queue = ClientQueue(RELAY_QUEUE_SIZE, RELAY_QUEUE_BYTES)
+    activeRelays[relayId] = queue.stats
+
+    async def sendLoop():
+        while True:
+            text = await queue.get()
+            if text is None:
+                return
+            if websocket.client_state.value != 1:
+                continue
+            try:
+                await websocket.send_text(text)
+            except (WebSocketDisconnect, RuntimeError):
+                # Cliente desconectado: la simulación se sigue leyendo hasta el final
+                queue.close()
+                queue.items.clear()
+                return
+
+    sender = asyncio.create_task(sendLoop())
+    try:
+        while True:
+            line = await stdout.readline()
+            if not line:
+                break
+
+            decodedLine = line.decode().strip()
+
+            # [LOGS]
+            log_file.write("[STDOUT] " + decodedLine + "\n")
+
+            message = classifyLine(decodedLine, passthrough)
+            if message:
+                queue.put(*message)
+
+        queue.put(json.dumps({"event": "RELAY_STATS", **queue.stats}), KIND_KEEP)
+        queue.put(json.dumps({"event": "SIMULATION_END"}), KIND_KEEP)
+        queue.close()
+        await sender
+    finally:
+        if not sender.done():
+            sender.cancel()
+        log_file.write("[RELAY] " + json.dumps(queue.stats) + "\n")
+        activeRelays.pop(relayId, None)
 
 
 # ======================== RUTAS DE PÁGINAS ========================
@@ -84,15 +353,10 @@ async def getEnvironment():
     return {"environment": ENVIRONMENT}
 
 
-@app.post("/uploadFiles/")
-async def uploadFiles(files: list[UploadFile] = File(...)):
-    """Guarda archivos .txt en el directorio de entrada"""
-    os.makedirs(DATA_INPUT_DIR, exist_ok=True)
-    for file in files:
-        filePath = os.path.join(DATA_INPUT_DIR, file.filename)
-        with open(filePath, "wb") as buffer:
-            shutil.copyfileobj(file.file, buffer)
-    return {"status": "Archivos subidos exitosamente", "archivos": [file.filename for file in files]}
+@app.get("/relay-stats/")
+async def getRelayStats():
+    """Contadores de atraso de cada cliente WebSocket con una simulación en curso"""
+    return {"clients": [{"id": relayId, **stats} for relayId, stats in activeRelays.items()]}
 
 
 # ======================== WEBSOCKET PARA SIMULACIÓN ========================
@@ -105,6 +369,9 @@ async def websocketSimulationScheduling(websocket: WebSocket):
         configData = await websocket.receive_text()
         config = json.loads(configData)
 
+        # Con frames por ciclo la salida se reenvía tal cual (pass-through) salvo que se indique lo contrario
+        passthrough = bool(config.get("passthrough", config.get("frames", 0)))
+
         # Crear directorio output si no existe
         os.makedirs(DATA_OUTPUT_DIR, exist_ok=True)
 
@@ -112,44 +379,18 @@ async def websocketSimulationScheduling(websocket: WebSocket):
         log_path = os.path.join(DATA_OUTPUT_DIR, LOG_SH)
         log_file = open(log_path, "w", encoding="utf-8")
 
-        process = await asyncio.create_subprocess_exec(
-            BIN_SH,
-            stdin=asyncio.subprocess.PIPE,
-            stdout=asyncio.subprocess.PIPE,
-            stderr=asyncio.subprocess.PIPE,
-        )
-
-        # Enviar configuración JSON por stdin
-        if process.stdin:
-            process.stdin.write((configData + "\n").encode())
-            await process.stdin.drain()
-            process.stdin.close()
-        else:
-            print("Error: process.stdin es None")
+        # Enviar al daemon o al proceso del simulador solo las claves permitidas de la configuración
+        stdout, process, connection = await openSimulation(BIN_SH, "scheduling", json.dumps(filterSchedulingConfig(config)))
 
-        while True:
-            line = await process.stdout.readline()
-            if not line:
-                break
+        # Modo pass-through: las líneas JSON se reenvían sin volver a parsearlas
+        await relaySimulation(websocket, stdout, log_file, passthrough)
 
-            decodedLine = line.decode().strip()
-            
-            # [LOGS]
-            log_file.write("[STDOUT] " + decodedLine + "\n")
-            try:
-                eventData = json.loads(decodedLine)
-                if websocket.client_state.value == 1:
-                    await websocket.send_text(json.dumps(eventData))
-            except json.JSONDecodeError:
-                continue
-            
         # [LOGS]
-        stderr_output = await process.stderr.read()
+        stderr_output = await process.stderr.read() if process else b""
+        if connection:
+            connection.close()
         if stderr_output:
             log_file.write("[STDERR] " + stderr_output.decode() + "\n")
-            
-        if websocket.client_state.value == 1:
-            await websocket.send_text(json.dumps({"event": "SIMULATION_END"}))
 
     except WebSocketDisconnect:
         print("Cliente WebSocket desconectado.")
@@ -170,43 +411,76 @@ async def websocketSimulationSynchronization(websocket: WebSocket):
     try:
         configData = await websocket.receive_text()
         config = json.loads(configData)
+        passthrough = bool(config.get("passthrough", config.get("frames", 0)))
 
         os.makedirs(DATA_OUTPUT_DIR, exist_ok=True)
         log_path = os.path.join(DATA_OUTPUT_DIR, LOG_SYNC)
         log_file = open(log_path, "w", encoding="utf-8")
 
-        process = await asyncio.create_subprocess_exec(
-            BIN_SYNC,
-            stdin=asyncio.subprocess.PIPE,
-            stdout=asyncio.subprocess.PIPE,
-            stderr=asyncio.subprocess.PIPE,
-        )
-
-        if process.stdin:
-            process.stdin.write((json.dumps({"useMutex": 1 if config["mechanism"] == "mutex" else 0}) + "\n").encode())
-            await process.stdin.drain()
-            process.stdin.close()
-
-        while True:
-            line = await process.stdout.readline()
-            if not line:
-                break
-            decodedLine = line.decode().strip()
-            log_file.write("[STDOUT] " + decodedLine + "\n")
-            try:
-                eventData = json.loads(decodedLine)
-                if websocket.client_state.value == 1:
-                    await websocket.send_text(json.dumps(eventData))
-            except json.JSONDecodeError:
-                continue
-
-        stderr_output = await process.stderr.read()
+        syncConfig = {
+            "useMutex": 1 if config["mechanism"] == "mutex" else 0,
+            "protocol": config.get("protocol", "none"),
+            "priorityQueue": int(config.get("priorityQueue", 0)),
+        }
+
+        # Simulación combinada: planificación de CPU + sincronización
+        if config.get("algorithm", "NONE") != "NONE":
+            syncConfig["algorithm"] = config["algorithm"]
+            syncConfig["quantum"] = int(config.get("quantum", 1))
+            syncConfig["isPreemptive"] = int(config.get("isPreemptive", 0))
+
+        # Hilos reales, shards y frames por ciclo (opcionales)
+        for key in ("realThreads", "cycleUs", "timeoutMs", "shards", "frames"):
+            if key in config:
+                syncConfig[key] = int(config[key])
+
+        # Snapshots y seek (opcionales)
+        for key in ("checkpointInterval", "seek"):
+            if key in config:
+                syncConfig[key] = int(config[key])
+        if "checkpointDir" in config:
+            syncConfig["checkpointDir"] = str(config["checkpointDir"])
+
+        # Consulta what-if sobre la carga (diferencia de métricas)
+        if "whatIf" in config:
+            syncConfig["whatIf"] = config["whatIf"]
+
+        # Traza Chrome/Perfetto de la corrida (nombre de archivo en data/output o true)
+        trace = traceOption(config.get("trace"))
+        if trace is not None:
+            syncConfig["trace"] = trace
+
+        # Quantum de RR por prioridad (opcional)
+        if "priorityQuantum" in config:
+            syncConfig["priorityQuantum"] = {str(k): int(v) for k, v in config["priorityQuantum"].items()}
+
+        # Telemetría por ventana de ciclos (opcional)
+        if "telemetryWindow" in config:
+            syncConfig["telemetryWindow"] = int(config["telemetryWindow"])
+
+        # Carga de trabajo en línea (evita los archivos compartidos de data/input)
+        if "workload" in config:
+            syncConfig["workload"] = config["workload"]
+
+        # Comparación de modelos de lock (opcional)
+        if "lockModel" in config:
+            syncConfig["lockModel"] = config["lockModel"]
+        for key in ("cores", "ticksPerCycle"):
+            if key in config:
+                syncConfig[key] = int(config[key])
+        for key in ("cacheLineTransfer", "spinCost", "handoffLatency", "wakeupLatency", "preemptionPenalty"):
+            if key in config:
+                syncConfig[key] = float(config[key])
+
+        stdout, process, connection = await openSimulation(BIN_SYNC, "synchronization", json.dumps(syncConfig))
+        await relaySimulation(websocket, stdout, log_file, passthrough)
+
+        stderr_output = await process.stderr.read() if process else b""
+        if connection:
+            connection.close()
         if stderr_output:
             log_file.write("[STDERR] " + stderr_output.decode() + "\n")
 
-        if websocket.client_state.value == 1:
-            await websocket.send_text(json.dumps({"event": "SIMULATION_END"}))
-
     except WebSocketDisconnect:
         print("Cliente WebSocket desconectado.")
     except Exception as e: